@@ -37,6 +37,26 @@ UFlareResourceCatalog::UFlareResourceCatalog(const class FObjectInitializer& PCI
 	Resources.Sort(SortByResourceType);
 	ConsumerResources.Sort(SortByResourceType);
 	MaintenanceResources.Sort(SortByResourceType);
+
+	// Index resources, the first one wins on duplicate identifiers
+	for (int32 Index = 0; Index < Resources.Num(); Index++)
+	{
+		if (!ResourcesByIdentifier.Contains(Resources[Index]->Data.Identifier))
+		{
+			ResourcesByIdentifier.Add(Resources[Index]->Data.Identifier, Resources[Index]);
+		}
+	}
+
+	for (int32 Index = 0; Index < Resources.Num(); Index++)
+	{
+		ResourceIndices.Add(&Resources[Index]->Data, Index);
+	}
+
+	Food = Get("food");
+	Fuel = Get("fuel");
+	Tools = Get("tools");
+	Tech = Get("tech");
+	FleetSupply = Get("fleet-supply");
 }
 
 
@@ -46,12 +66,7 @@ UFlareResourceCatalog::UFlareResourceCatalog(const class FObjectInitializer& PCI
 
 FFlareResourceDescription* UFlareResourceCatalog::Get(FName Identifier) const
 {
-	auto FindByName = [=](const UFlareResourceCatalogEntry* Candidate)
-	{
-		return Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareResourceCatalogEntry* const* Entry = Resources.FindByPredicate(FindByName);
+	UFlareResourceCatalogEntry* const* Entry = ResourcesByIdentifier.Find(Identifier);
 	if (Entry && *Entry)
 	{
 		return &((*Entry)->Data);
@@ -71,3 +86,9 @@ UFlareResourceCatalogEntry* UFlareResourceCatalog::GetEntry(FFlareResourceDescri
 	}
 	return NULL;
 }
+
+int32 UFlareResourceCatalog::GetResourceIndex(const FFlareResourceDescription* Resource) const
+{
+	const int32* Index = ResourceIndices.Find(Resource);
+	return (Index ? *Index : INDEX_NONE);
+}
@@ -27,6 +27,21 @@ public:
 	UPROPERTY(EditAnywhere, Category = Content)
 	TArray<UFlareResourceCatalogEntry*> MaintenanceResources;
 
+	/** Resources used by the simulation every day */
+	FFlareResourceDescription* Food;
+	FFlareResourceDescription* Fuel;
+	FFlareResourceDescription* Tools;
+	FFlareResourceDescription* Tech;
+	FFlareResourceDescription* FleetSupply;
+
+protected:
+
+	/** Resources by identifier */
+	TMap<FName, UFlareResourceCatalogEntry*> ResourcesByIdentifier;
+
+	/** Index of each resource in the resource list */
+	TMap<const FFlareResourceDescription*, int32> ResourceIndices;
+
 public:
 
 	/*----------------------------------------------------
@@ -39,6 +54,9 @@ public:
 	/** Get a resource from identifier */
 	UFlareResourceCatalogEntry* GetEntry(FFlareResourceDescription*) const;
 
+	/** Get the index of a resource in the resource list, or INDEX_NONE */
+	int32 GetResourceIndex(const FFlareResourceDescription* Resource) const;
+
 	/** Get all resources */
 	TArray<UFlareResourceCatalogEntry*>& GetResourceList()
 	{
@@ -30,6 +30,22 @@ UFlareSpacecraftCatalog::UFlareSpacecraftCatalog(const class FObjectInitializer&
 			ShipCatalog.Add(Spacecraft);
 		}
 	}
+
+	// Index spacecrafts, ships first to match the search order
+	for (int32 Index = 0; Index < ShipCatalog.Num(); Index++)
+	{
+		if (!SpacecraftsByIdentifier.Contains(ShipCatalog[Index]->Data.Identifier))
+		{
+			SpacecraftsByIdentifier.Add(ShipCatalog[Index]->Data.Identifier, ShipCatalog[Index]);
+		}
+	}
+	for (int32 Index = 0; Index < StationCatalog.Num(); Index++)
+	{
+		if (!SpacecraftsByIdentifier.Contains(StationCatalog[Index]->Data.Identifier))
+		{
+			SpacecraftsByIdentifier.Add(StationCatalog[Index]->Data.Identifier, StationCatalog[Index]);
+		}
+	}
 }
 
 
@@ -39,18 +55,7 @@ UFlareSpacecraftCatalog::UFlareSpacecraftCatalog(const class FObjectInitializer&
 
 FFlareSpacecraftDescription* UFlareSpacecraftCatalog::Get(FName Identifier) const
 {
-	auto FindByName = [=](const UFlareSpacecraftCatalogEntry* Candidate)
-	{
-		return Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareSpacecraftCatalogEntry* const* Entry = ShipCatalog.FindByPredicate(FindByName);
-	if (Entry && *Entry)
-	{
-		return &((*Entry)->Data);
-	}
-
-	Entry = StationCatalog.FindByPredicate(FindByName);
+	UFlareSpacecraftCatalogEntry* const* Entry = SpacecraftsByIdentifier.Find(Identifier);
 	if (Entry && *Entry)
 	{
 		return &((*Entry)->Data);
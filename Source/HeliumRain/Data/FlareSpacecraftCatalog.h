@@ -24,6 +24,11 @@ public:
 	UPROPERTY(EditAnywhere, Category = Content)
 	TArray<UFlareSpacecraftCatalogEntry*> StationCatalog;
 
+protected:
+
+	/** Ships and stations by identifier */
+	TMap<FName, UFlareSpacecraftCatalogEntry*> SpacecraftsByIdentifier;
+
 public:
 
 	/*----------------------------------------------------
@@ -72,65 +72,40 @@ UFlareSpacecraftComponentsCatalog::UFlareSpacecraftComponentsCatalog(const class
 	EngineCatalog.Sort(SortByCost);
 	RCSCatalog.Sort(SortByCost);
 	WeaponCatalog.Sort(SortByWeaponType);
-}
-
 
-/*----------------------------------------------------
-	Data getters
-----------------------------------------------------*/
+	// Index parts in the search order
+	IndexComponents(EngineCatalog);
+	IndexComponents(RCSCatalog);
+	IndexComponents(WeaponCatalog);
+	IndexComponents(InternalComponentsCatalog);
+	IndexComponents(MetaCatalog);
+}
 
-FFlareSpacecraftComponentDescription* UFlareSpacecraftComponentsCatalog::Get(FName Identifier) const
+void UFlareSpacecraftComponentsCatalog::IndexComponents(const TArray<UFlareSpacecraftComponentsCatalogEntry*>& Catalog)
 {
-	FFlareSpacecraftComponentDescription* Part = NULL;
-
-	auto FindByName = [=](const UFlareSpacecraftComponentsCatalogEntry* Candidate)
+	for (int32 Index = 0; Index < Catalog.Num(); Index++)
 	{
-		return Candidate && Candidate->Data.Identifier == Identifier;
-	};
-
-	UFlareSpacecraftComponentsCatalogEntry* const* Temp = EngineCatalog.FindByPredicate(FindByName);
-	if (Temp)
-	{
-		Part = &(*Temp)->Data;
-	}
-
-	if (!Part)
-	{
-		Temp = RCSCatalog.FindByPredicate(FindByName);
-		if (Temp)
+		if (Catalog[Index] && !ComponentsByIdentifier.Contains(Catalog[Index]->Data.Identifier))
 		{
-			Part = &(*Temp)->Data;
+			ComponentsByIdentifier.Add(Catalog[Index]->Data.Identifier, Catalog[Index]);
 		}
 	}
+}
 
-	if (!Part)
-	{
-		Temp = WeaponCatalog.FindByPredicate(FindByName);
-		if (Temp)
-		{
-			Part = &(*Temp)->Data;
-		}
-	}
 
-	if (!Part)
-	{
-		Temp = InternalComponentsCatalog.FindByPredicate(FindByName);
-		if (Temp)
-		{
-			Part = &(*Temp)->Data;
-		}
-	}
-	
-	if (!Part)
+/*----------------------------------------------------
+	Data getters
+----------------------------------------------------*/
+
+FFlareSpacecraftComponentDescription* UFlareSpacecraftComponentsCatalog::Get(FName Identifier) const
+{
+	UFlareSpacecraftComponentsCatalogEntry* const* Entry = ComponentsByIdentifier.Find(Identifier);
+	if (Entry && *Entry)
 	{
-		Temp = MetaCatalog.FindByPredicate(FindByName);
-		if (Temp)
-		{
-			Part = &(*Temp)->Data;
-		}
+		return &(*Entry)->Data;
 	}
 
-	return Part;
+	return NULL;
 }
 
 const void UFlareSpacecraftComponentsCatalog::GetEngineList(TArray<FFlareSpacecraftComponentDescription*>& OutData, TEnumAsByte<EFlarePartSize::Type> Size)
@@ -35,6 +35,14 @@ public:
 	UPROPERTY(EditAnywhere, Category = Content)
 	TArray<UFlareSpacecraftComponentsCatalogEntry*> MetaCatalog;
 
+protected:
+
+	/** Parts by identifier */
+	TMap<FName, UFlareSpacecraftComponentsCatalogEntry*> ComponentsByIdentifier;
+
+	/** Add parts to the index, keeping existing ones on duplicate identifiers */
+	void IndexComponents(const TArray<UFlareSpacecraftComponentsCatalogEntry*>& Catalog);
+
 public:
 
 	/*----------------------------------------------------
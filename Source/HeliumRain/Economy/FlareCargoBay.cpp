@@ -10,6 +10,9 @@
 
 UFlareCargoBay::UFlareCargoBay(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, UsedCargoSpace(0)
+	, FreeSlotCount(0)
+	, RestrictedSlotCount(0)
 {
 }
 
@@ -72,6 +75,8 @@ void UFlareCargoBay::Load(UFlareSimulatedSpacecraft* ParentSpacecraft, TArray<FF
 
 		CargoBay.Add(Cargo);
 	}
+
+	UpdateSlotStats();
 }
 
 
@@ -180,6 +185,7 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 		int32 TakenQuantity = FMath::Min(MinQuantityCargo->Quantity, QuantityToTake);
 		if (TakenQuantity > 0)
 		{
+			AddSlotStats(*MinQuantityCargo, -1);
 			MinQuantityCargo->Quantity -= TakenQuantity;
 			QuantityToTake -= TakenQuantity;
 
@@ -187,6 +193,7 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 			{
 				MinQuantityCargo->Resource = NULL;
 			}
+			AddSlotStats(*MinQuantityCargo, 1);
 
 			if (QuantityToTake == 0)
 			{
@@ -209,6 +216,7 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 			int32 TakenQuantity = FMath::Min(Cargo.Quantity, QuantityToTake);
 			if (TakenQuantity > 0)
 			{
+				AddSlotStats(Cargo, -1);
 				Cargo.Quantity -= TakenQuantity;
 				QuantityToTake -= TakenQuantity;
 
@@ -216,6 +224,7 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 				{
 					Cargo.Resource = NULL;
 				}
+				AddSlotStats(Cargo, 1);
 
 				if (QuantityToTake == 0)
 				{
@@ -229,11 +238,13 @@ int32 UFlareCargoBay::TakeResources(FFlareResourceDescription* Resource, int32 Q
 
 void UFlareCargoBay::DumpCargo(FFlareCargo* Cargo)
 {
+	AddSlotStats(*Cargo, -1);
 	Cargo->Quantity = 0;
 	if (Cargo->Lock == EFlareResourceLock::NoLock)
 	{
 		Cargo->Resource = NULL;
 	}
+	AddSlotStats(*Cargo, 1);
 }
 
 int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Quantity, UFlareCompany* Client)
@@ -261,7 +272,9 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 			int32 GivenQuantity = FMath::Min(AvailableCapacity, QuantityToGive);
 			if (GivenQuantity > 0)
 			{
+				AddSlotStats(Cargo, -1);
 				Cargo.Quantity += GivenQuantity;
+				AddSlotStats(Cargo, 1);
 				QuantityToGive -= GivenQuantity;
 
 				if (QuantityToGive == 0)
@@ -287,8 +300,10 @@ int32 UFlareCargoBay::GiveResources(FFlareResourceDescription* Resource, int32 Q
 			int32 GivenQuantity = FMath::Min(GetSlotCapacity(), QuantityToGive);
 			if (GivenQuantity > 0)
 			{
+				AddSlotStats(Cargo, -1);
 				Cargo.Quantity += GivenQuantity;
 				Cargo.Resource = Resource;
+				AddSlotStats(Cargo, 1);
 
 				QuantityToGive -= GivenQuantity;
 
@@ -325,28 +340,12 @@ int32 UFlareCargoBay::GetCapacity() const
 
 int32 UFlareCargoBay::GetFreeSlotCount() const
 {
-	int32 FreeSlotCount = 0;
-
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num(); CargoIndex++)
-	{
-		if(CargoBay[CargoIndex].Quantity == 0)
-		{
-			FreeSlotCount++;
-		}
-	}
 	return FreeSlotCount;
 }
 
 int32 UFlareCargoBay::GetUsedCargoSpace() const
 {
-	int32 Used = 0;
-
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num(); CargoIndex++)
-	{
-		Used += CargoBay[CargoIndex].Quantity;
-	}
-
-	return Used;
+	return UsedCargoSpace;
 }
 
 int32 UFlareCargoBay::GetFreeCargoSpace() const
@@ -356,19 +355,17 @@ int32 UFlareCargoBay::GetFreeCargoSpace() const
 
 int32 UFlareCargoBay::GetResourceQuantity(FFlareResourceDescription* Resource, UFlareCompany* Client) const
 {
+	const FFlareCargoBayResourceStats* Stats = ResourceStats.Find(Resource);
 	int32 Quantity = 0;
 
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
+	if (Stats)
 	{
-		const FFlareCargo& Cargo = CargoBay[CargoIndex];
-		if (Cargo.Resource == Resource)
+		for (int32 RestrictionIndex = 0; RestrictionIndex <= EFlareResourceRestriction::Nobody; RestrictionIndex++)
 		{
-			if(!CheckRestriction(&Cargo, Client))
+			if (IsRestrictionAllowed(RestrictionIndex, Client))
 			{
-				continue;
+				Quantity += Stats->Quantities[RestrictionIndex];
 			}
-
-			Quantity += Cargo.Quantity;
 		}
 	}
 
@@ -377,41 +374,44 @@ int32 UFlareCargoBay::GetResourceQuantity(FFlareResourceDescription* Resource, U
 
 int32 UFlareCargoBay::GetFreeSpaceForResource(FFlareResourceDescription* Resource, UFlareCompany* Client) const
 {
+	const FFlareCargoBayResourceStats* EmptyStats = ResourceStats.Find(NULL);
+	const FFlareCargoBayResourceStats* Stats = (Resource ? ResourceStats.Find(Resource) : NULL);
+	int32 SlotCount = 0;
 	int32 Quantity = 0;
 
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
+	for (int32 RestrictionIndex = 0; RestrictionIndex <= EFlareResourceRestriction::Nobody; RestrictionIndex++)
 	{
-		const FFlareCargo& Cargo = CargoBay[CargoIndex];
-
-		if(!CheckRestriction(&Cargo, Client))
+		if (!IsRestrictionAllowed(RestrictionIndex, Client))
 		{
 			continue;
 		}
 
-		if (Cargo.Resource == NULL)
+		for (int32 LockIndex = 0; LockIndex <= EFlareResourceLock::Trade + 1; LockIndex++)
 		{
-			Quantity += GetSlotCapacity();
+			// Empty slots are free whatever their quantity
+			if (EmptyStats)
+			{
+				SlotCount += EmptyStats->SlotCounts[RestrictionIndex][LockIndex];
+			}
+
+			if (Stats)
+			{
+				SlotCount += Stats->SlotCounts[RestrictionIndex][LockIndex];
+			}
 		}
-		else if (Cargo.Resource == Resource)
+
+		if (Stats)
 		{
-			Quantity += GetSlotCapacity() - Cargo.Quantity;
+			Quantity += Stats->Quantities[RestrictionIndex];
 		}
 	}
 
-	return Quantity;
+	return SlotCount * GetSlotCapacity() - Quantity;
 }
 
 bool UFlareCargoBay::HasRestrictions() const
 {
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
-	{
-		const FFlareCargo& Cargo = CargoBay[CargoIndex];
-		if(Cargo.Restriction != EFlareResourceRestriction::Everybody)
-		{
-			return true;
-		}
-	}
-	return false;
+	return (RestrictedSlotCount > 0);
 }
 
 int32 UFlareCargoBay::GetSlotCount() const
@@ -441,6 +441,7 @@ bool UFlareCargoBay::LockSlot(FFlareResourceDescription* Resource, EFlareResourc
 
 		if (Cargo.Lock == EFlareResourceLock::NoLock && (Cargo.Resource == NULL || Cargo.Resource == Resource))
 		{
+			AddSlotStats(Cargo, -1);
 			Cargo.Lock = LockType;
 			Cargo.ManualLock = ManualLock;
 
@@ -449,6 +450,7 @@ bool UFlareCargoBay::LockSlot(FFlareResourceDescription* Resource, EFlareResourc
 				Cargo.Resource = Resource;
 				Cargo.Quantity = 0;
 			}
+			AddSlotStats(Cargo, 1);
 			return true;
 		}
 	}
@@ -469,6 +471,7 @@ void UFlareCargoBay::UnlockAll(bool IgnoreManualLock)
 				continue;
 			}
 
+			AddSlotStats(Cargo, -1);
 			Cargo.Lock = EFlareResourceLock::NoLock;
 			Cargo.ManualLock = false;
 
@@ -476,6 +479,7 @@ void UFlareCargoBay::UnlockAll(bool IgnoreManualLock)
 			{
 				Cargo.Resource = NULL;
 			}
+			AddSlotStats(Cargo, 1);
 		}
 	}
 }
@@ -486,29 +490,36 @@ void UFlareCargoBay::SetSlotRestriction(int32 SlotIndex, EFlareResourceRestricti
 	{
 		FLOGV("Invalid index %d for set slot restriction (cargo bay size: %d)", SlotIndex, CargoBay.Num());
 	}
+	AddSlotStats(CargoBay[SlotIndex], -1);
 	CargoBay[SlotIndex].Restriction = RestrictionType;
+	AddSlotStats(CargoBay[SlotIndex], 1);
 }
 
 bool UFlareCargoBay::WantSell(FFlareResourceDescription* Resource, UFlareCompany* Client) const
 {
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
+	// Empty slots and slots of this resource
+	const FFlareCargoBayResourceStats* CandidateStats[] = { ResourceStats.Find(NULL), (Resource ? ResourceStats.Find(Resource) : NULL) };
+
+	for (const FFlareCargoBayResourceStats* Stats : CandidateStats)
 	{
-		const FFlareCargo& Cargo = CargoBay[CargoIndex];
-		if(Cargo.Resource != NULL && Cargo.Resource != Resource)
+		if (!Stats)
 		{
 			continue;
 		}
 
-		if(!CheckRestriction(&Cargo, Client))
+		for (int32 RestrictionIndex = 0; RestrictionIndex <= EFlareResourceRestriction::Nobody; RestrictionIndex++)
 		{
-			continue;
-		}
+			if (!IsRestrictionAllowed(RestrictionIndex, Client))
+			{
+				continue;
+			}
 
-		if(Cargo.Lock == EFlareResourceLock::NoLock ||
-				Cargo.Lock == EFlareResourceLock::Output ||
-				Cargo.Lock == EFlareResourceLock::Trade)
-		{
-			return true;
+			if (Stats->SlotCounts[RestrictionIndex][EFlareResourceLock::NoLock] > 0 ||
+					Stats->SlotCounts[RestrictionIndex][EFlareResourceLock::Output] > 0 ||
+					Stats->SlotCounts[RestrictionIndex][EFlareResourceLock::Trade] > 0)
+			{
+				return true;
+			}
 		}
 	}
 
@@ -517,26 +528,32 @@ bool UFlareCargoBay::WantSell(FFlareResourceDescription* Resource, UFlareCompany
 
 bool UFlareCargoBay::WantBuy(FFlareResourceDescription* Resource, UFlareCompany* Client) const
 {
-	for (int CargoIndex = 0; CargoIndex < CargoBay.Num() ; CargoIndex++)
+	// Empty slots and slots of this resource
+	const FFlareCargoBayResourceStats* CandidateStats[] = { ResourceStats.Find(NULL), (Resource ? ResourceStats.Find(Resource) : NULL) };
+
+	for (const FFlareCargoBayResourceStats* Stats : CandidateStats)
 	{
-		const FFlareCargo& Cargo = CargoBay[CargoIndex];
-		if(Cargo.Resource != NULL && Cargo.Resource != Resource)
+		if (!Stats)
 		{
 			continue;
 		}
 
-		if(!CheckRestriction(&Cargo, Client))
+		for (int32 RestrictionIndex = 0; RestrictionIndex <= EFlareResourceRestriction::Nobody; RestrictionIndex++)
 		{
-			continue;
-		}
+			if (!IsRestrictionAllowed(RestrictionIndex, Client))
+			{
+				continue;
+			}
 
-		if(Cargo.Lock == EFlareResourceLock::NoLock ||
-				Cargo.Lock == EFlareResourceLock::Input||
-				Cargo.Lock == EFlareResourceLock::Trade)
-		{
-			return true;
+			if (Stats->SlotCounts[RestrictionIndex][EFlareResourceLock::NoLock] > 0 ||
+					Stats->SlotCounts[RestrictionIndex][EFlareResourceLock::Input] > 0 ||
+					Stats->SlotCounts[RestrictionIndex][EFlareResourceLock::Trade] > 0)
+			{
+				return true;
+			}
 		}
 	}
+
 	return false;
 }
 
@@ -559,3 +576,67 @@ bool UFlareCargoBay::CheckRestriction(const FFlareCargo* Cargo, UFlareCompany* C
 	}
 	return true;
 }
+
+bool UFlareCargoBay::IsRestrictionAllowed(int32 RestrictionIndex, UFlareCompany* Client) const
+{
+	// Same rules as CheckRestriction
+	if (Client)
+	{
+		if (RestrictionIndex == EFlareResourceRestriction::Nobody)
+		{
+			return false;
+		}
+
+		if (RestrictionIndex == EFlareResourceRestriction::OwnerOnly && Client != Parent->GetCompany())
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+/*----------------------------------------------------
+	Aggregates
+----------------------------------------------------*/
+
+void UFlareCargoBay::AddSlotStats(const FFlareCargo& Cargo, int32 Sign)
+{
+	// Unknown restrictions behave like Everybody in CheckRestriction
+	int32 RestrictionIndex = EFlareResourceRestriction::Everybody;
+	if (Cargo.Restriction == EFlareResourceRestriction::OwnerOnly || Cargo.Restriction == EFlareResourceRestriction::Nobody)
+	{
+		RestrictionIndex = Cargo.Restriction;
+	}
+
+	int32 LockIndex = (Cargo.Lock <= EFlareResourceLock::Trade ? Cargo.Lock : EFlareResourceLock::Trade + 1);
+
+	FFlareCargoBayResourceStats& Stats = ResourceStats.FindOrAdd(Cargo.Resource);
+	Stats.SlotCounts[RestrictionIndex][LockIndex] += Sign;
+	Stats.Quantities[RestrictionIndex] += Sign * Cargo.Quantity;
+
+	UsedCargoSpace += Sign * Cargo.Quantity;
+
+	if (Cargo.Quantity == 0)
+	{
+		FreeSlotCount += Sign;
+	}
+
+	if (Cargo.Restriction != EFlareResourceRestriction::Everybody)
+	{
+		RestrictedSlotCount += Sign;
+	}
+}
+
+void UFlareCargoBay::UpdateSlotStats()
+{
+	ResourceStats.Empty();
+	UsedCargoSpace = 0;
+	FreeSlotCount = 0;
+	RestrictedSlotCount = 0;
+
+	for (const FFlareCargo& Cargo : CargoBay)
+	{
+		AddSlotStats(Cargo, 1);
+	}
+}
@@ -7,6 +7,20 @@ struct FFlareCargo;
 struct FFlareResourceDescription;
 
 
+/** Slot counts and quantities of one resource in a cargo bay, by slot restriction and lock */
+struct FFlareCargoBayResourceStats
+{
+	FFlareCargoBayResourceStats()
+	{
+		FMemory::Memzero(this, sizeof(*this));
+	}
+
+	// The last lock index counts slots with an unknown lock
+	int32                                      SlotCounts[EFlareResourceRestriction::Nobody + 1][EFlareResourceLock::Trade + 2];
+	int32                                      Quantities[EFlareResourceRestriction::Nobody + 1];
+};
+
+
 UCLASS()
 class HELIUMRAIN_API UFlareCargoBay : public UObject
 {
@@ -48,6 +62,16 @@ public:
 
 protected:
 
+	/** Add (Sign = 1) or remove (Sign = -1) a slot from the aggregates */
+	void AddSlotStats(const FFlareCargo& Cargo, int32 Sign);
+
+	/** Rebuild the aggregates from the slots */
+	void UpdateSlotStats();
+
+	/** Check if the slots with this restriction can be used by Client */
+	bool IsRestrictionAllowed(int32 RestrictionIndex, UFlareCompany* Client) const;
+
+
 	/*----------------------------------------------------
 	   Protected data
 	----------------------------------------------------*/
@@ -63,6 +87,12 @@ protected:
 	int32								       CargoBayBaseCapacity;
 	AFlareGame*                                Game;
 
+	// Aggregates, updated with every slot change. Empty slots use the NULL resource.
+	TMap<FFlareResourceDescription*, FFlareCargoBayResourceStats> ResourceStats;
+	int32                                      UsedCargoSpace;
+	int32                                      FreeSlotCount;
+	int32                                      RestrictedSlotCount;
+
 
 public:
 
@@ -88,6 +118,7 @@ public:
 
 	bool HasRestrictions() const;
 
+	/** Slots must only be changed by the cargo bay, to keep the aggregates valid */
 	FFlareCargo* GetSlot(int32 Index);
 
 	TArray<FFlareCargo>& GetSlots()
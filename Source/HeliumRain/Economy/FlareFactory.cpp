@@ -31,11 +31,14 @@ void UFlareFactory::Load(UFlareSimulatedSpacecraft* ParentSpacecraft, const FFla
 	FactoryDescription = Description;
 	Parent = ParentSpacecraft;
 	CycleCostCacheLevel = -1;
+	CoastStartDate = 0;
+	CoastEndDate = -1;
 }
 
 
 FFlareFactorySave* UFlareFactory::Save()
 {
+	SettleCoast();
 	return &FactoryData;
 }
 
@@ -45,6 +48,17 @@ void UFlareFactory::Simulate()
 	FCHECK(Parent->GetCurrentSector());
 	FCHECK(Parent->GetCurrentSector()->GetPeople());
 
+	if (IsCoasting())
+	{
+		if (GetGame()->GetGameWorld()->GetDate() <= CoastEndDate)
+		{
+			// Mid-cycle, the producted duration is settled when read
+			goto post_prod;
+		}
+
+		StopCoast();
+	}
+
 	if (!FactoryData.Active)
 	{
 		goto post_prod;
@@ -93,6 +107,8 @@ void UFlareFactory::Simulate()
 
 post_prod:
 
+	TryBeginCoast();
+
 	if (FactoryDescription->VisibleStates)
 	{
 		UpdateDynamicState();
@@ -113,6 +129,48 @@ void UFlareFactory::TryBeginProduction()
 
 }
 
+void UFlareFactory::TryBeginCoast()
+{
+	if (IsCoasting() || !FactoryData.Active || !IsNeedProduction() || !HasCostReserved())
+	{
+		return;
+	}
+
+	// Damage only makes cycles longer, so the undamaged production time bounds the days left in this cycle
+	int64 CoastDays = GetCycleData().ProductionTime - 1 - FactoryData.ProductedDuration;
+	if (CoastDays > 0)
+	{
+		CoastStartDate = GetGame()->GetGameWorld()->GetDate();
+		CoastEndDate = CoastStartDate + CoastDays;
+	}
+}
+
+void UFlareFactory::SettleCoast()
+{
+	if (IsCoasting())
+	{
+		int64 CoastedDays = GetCoastedDays();
+		FactoryData.ProductedDuration += CoastedDays;
+		CoastStartDate += CoastedDays;
+	}
+}
+
+void UFlareFactory::StopCoast()
+{
+	SettleCoast();
+	CoastEndDate = -1;
+}
+
+int64 UFlareFactory::GetCoastedDays()
+{
+	if (!IsCoasting())
+	{
+		return 0;
+	}
+
+	return FMath::Min(GetGame()->GetGameWorld()->GetDate(), CoastEndDate) - CoastStartDate;
+}
+
 void UFlareFactory::UpdateDynamicState()
 {
 	if(FactoryData.TargetShipClass == NAME_None)
@@ -128,6 +186,7 @@ void UFlareFactory::UpdateDynamicState()
 
 void UFlareFactory::Start()
 {
+	StopCoast();
 	FactoryData.Active = true;
 
 	// Stop other factories
@@ -159,11 +218,14 @@ void UFlareFactory::Start()
 		FactoryData.OrderShipCompany = NAME_None;
 		FactoryData.OrderShipClass = NAME_None;
 		FactoryData.OrderShipAdvancePayment = 0;
+
+		InvalidateSectorMarket();
 	}
 }
 
 void UFlareFactory::Pause()
 {
+	StopCoast();
 	FactoryData.Active = false;
 }
 
@@ -173,13 +235,24 @@ void UFlareFactory::Stop()
 	CancelProduction();
 }
 
+void UFlareFactory::InvalidateSectorMarket()
+{
+	// Shipyard resources depend on the ship being built
+	if (IsShipyard() && Parent->GetCurrentSector())
+	{
+		Parent->GetCurrentSector()->InvalidateMarketIndex();
+	}
+}
+
 void UFlareFactory::SetInfiniteCycle(bool Mode)
 {
+	StopCoast();
 	FactoryData.InfiniteCycle = Mode;
 }
 
 void UFlareFactory::SetCycleCount(uint32 Count)
 {
+	StopCoast();
 	FactoryData.CycleCount = Count;
 }
 
@@ -451,6 +524,7 @@ void UFlareFactory::BeginProduction()
 
 void UFlareFactory::CancelProduction()
 {
+	StopCoast();
 	Parent->GetCompany()->GiveMoney(FactoryData.CostReserved);
 	FactoryData.CostReserved = 0;
 
@@ -474,6 +548,7 @@ void UFlareFactory::CancelProduction()
 	FactoryData.ProductedDuration = 0;
 	FactoryData.TargetShipClass = NAME_None;
 	FactoryData.TargetShipCompany = NAME_None;
+	InvalidateSectorMarket();
 }
 
 void UFlareFactory::DoProduction()
@@ -565,7 +640,7 @@ FFlareWorldEvent *UFlareFactory::GenerateEvent()
 			return NULL;
 		}
 
-		NextEvent.Date= GetGame()->GetGameWorld()->GetDate() + GetProductionTime(GetCycleData()) - FactoryData.ProductedDuration;
+		NextEvent.Date= GetGame()->GetGameWorld()->GetDate() + GetProductionTime(GetCycleData()) - GetProductedDuration();
 		NextEvent.Visibility = EFlareEventVisibility::Silent;
 		return &NextEvent;
 	}
@@ -610,6 +685,7 @@ void UFlareFactory::PerformCreateShipAction(const FFlareFactoryAction* Action)
 
 	FactoryData.TargetShipClass = NAME_None;
 	FactoryData.TargetShipCompany = NAME_None;
+	InvalidateSectorMarket();
 
 	if (FactoryData.OrderShipCompany == NAME_None)
 	{
@@ -738,14 +814,16 @@ const FFlareProductionData& UFlareFactory::GetCycleData()
 	{
 		return GetCycleDataForShipClass(FactoryData.TargetShipClass);
 	}
-	else if (Parent->GetLevel() == CycleCostCacheLevel)
+
+	// Stations being built or upgraded produce at level 1
+	int32 CycleLevel = Parent->IsUnderConstruction() ? 1 : Parent->GetLevel();
+	if (CycleLevel == CycleCostCacheLevel)
 	{
 		return CycleCostCache;
 	}
 	else
 	{
-
-		CycleCostCacheLevel = Parent->IsUnderConstruction() ? 1 : Parent->GetLevel();
+		CycleCostCacheLevel = CycleLevel;
 		CycleCostCache.ProductionTime = FactoryDescription->CycleCost.ProductionTime;
 		CycleCostCache.ProductionCost = FactoryDescription->CycleCost.ProductionCost * CycleCostCacheLevel;
 		CycleCostCache.InputResources = FactoryDescription->CycleCost.InputResources;
@@ -797,7 +875,7 @@ uint32 UFlareFactory::GetProductionCost(const FFlareProductionData* Data)
 
 int64 UFlareFactory::GetRemainingProductionDuration()
 {
-	return GetProductionTime(GetCycleData()) - FactoryData.ProductedDuration;
+	return GetProductionTime(GetCycleData()) - GetProductedDuration();
 }
 
 TArray<FFlareFactoryResource> UFlareFactory::GetLimitedOutputResources()
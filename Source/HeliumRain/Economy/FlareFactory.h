@@ -82,6 +82,25 @@ public:
 
 protected:
 
+	/** Forget the market index of the sector, after a shipyard changed the ship it builds */
+	void InvalidateSectorMarket();
+
+	/*----------------------------------------------------
+	   Coasting
+	----------------------------------------------------*/
+
+	/** Skip the next days of the current cycle if nothing but the producted duration can change during them */
+	void TryBeginCoast();
+
+	/** Add the skipped days to the producted duration */
+	void SettleCoast();
+
+	/** Settle the skipped days and simulate the next days again, before a change of production state */
+	void StopCoast();
+
+	/** Get the number of skipped days not yet added to the producted duration */
+	int64 GetCoastedDays();
+
 	/*----------------------------------------------------
 	   Protected data
 	----------------------------------------------------*/
@@ -99,6 +118,10 @@ protected:
 	FFlareProductionData CycleCostCache;
 	int32 CycleCostCacheLevel;
 
+	// Coasting, from the date of the last settled day to the last skipped day
+	int64                                    CoastStartDate;
+	int64                                    CoastEndDate;
+
 public:
 
 	FFlareFactoryDescription           ConstructionFactoryDescription;
@@ -169,7 +192,12 @@ public:
 
 	inline int64 GetProductedDuration()
 	{
-		return FactoryData.ProductedDuration;
+		return FactoryData.ProductedDuration + GetCoastedDays();
+	}
+
+	inline bool IsCoasting() const
+	{
+		return CoastEndDate >= 0;
 	}
 
 	inline int64 GetProductionDuration()
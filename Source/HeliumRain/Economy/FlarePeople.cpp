@@ -166,10 +166,10 @@ void UFlarePeople::Simulate()
 
 void UFlarePeople::SimulateResourcePurchase()
 {
-	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Get("food");
-	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Get("fuel");
-	FFlareResourceDescription* Tool = Game->GetResourceCatalog()->Get("tools");
-	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Get("tech");
+	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Food;
+	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Fuel;
+	FFlareResourceDescription* Tool = Game->GetResourceCatalog()->Tools;
+	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Tech;
 
 	uint32 FoodConsumption = GetRessourceConsumption(Food, true);
 	uint32 BoughtFood = BuyResourcesInSector(Food, FoodConsumption); // In Tons
@@ -276,14 +276,8 @@ uint32 UFlarePeople::BuyResourcesInSector(FFlareResourceDescription* Resource, u
 	TArray<UFlareSimulatedSpacecraft*> SellingStations;
 	TArray<UFlareCompany*> SellingCompanies;
 
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Parent->GetSectorStations().Num(); SpacecraftIndex++)
+	for (UFlareSimulatedSpacecraft* Station : Parent->GetConsumerStations())
 	{
-		UFlareSimulatedSpacecraft* Station = Parent->GetSectorStations()[SpacecraftIndex];
-
-		if(!Station->HasCapability(EFlareSpacecraftCapability::Consumer))
-		{
-			continue;
-		}
 		SellingStations.Add(Station);
 		SellingCompanies.AddUnique(Station->GetCompany());
 	}
@@ -378,10 +372,10 @@ uint32 UFlarePeople::BuyInStationForCompany(FFlareResourceDescription* Resource,
 
 float UFlarePeople::GetRessourceConsumption(FFlareResourceDescription* Resource, bool WithStock)
 {
-	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Get("food");
-	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Get("fuel");
-	FFlareResourceDescription* Tools = Game->GetResourceCatalog()->Get("tools");
-	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Get("tech");
+	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Food;
+	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Fuel;
+	FFlareResourceDescription* Tools = Game->GetResourceCatalog()->Tools;
+	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Tech;
 
 	if (PeopleData.Population == 0)
 	{
@@ -640,10 +634,10 @@ void UFlarePeople::ResetPeople()
 
 void UFlarePeople::PrintInfo()
 {
-	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Get("food");
-	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Get("fuel");
-	FFlareResourceDescription* Tools = Game->GetResourceCatalog()->Get("tools");
-	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Get("tech");
+	FFlareResourceDescription* Food = Game->GetResourceCatalog()->Food;
+	FFlareResourceDescription* Fuel = Game->GetResourceCatalog()->Fuel;
+	FFlareResourceDescription* Tools = Game->GetResourceCatalog()->Tools;
+	FFlareResourceDescription* Tech = Game->GetResourceCatalog()->Tech;
 
 
 
@@ -68,7 +68,7 @@ void UFlareCompanyAI::Tick()
 	}
 }
 
-void UFlareCompanyAI::Simulate()
+void UFlareCompanyAI::SimulateDiplomacy()
 {
 	if (Game && Company != Game->GetPC()->GetCompany())
 	{
@@ -76,22 +76,13 @@ void UFlareCompanyAI::Simulate()
 
 		CheckBattleResolution();
 		UpdateDiplomacy();
-	
-		ResourceFlow = ComputeWorldResourceFlow();
-		WorldStats = WorldHelper::ComputeWorldResourceStats(Game);
-		Shipyards = FindShipyards();
-
-		// Compute input and output ressource equation (ex: 100 + 10/ day)
-		WorldResourceVariation.Empty();
-		for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
-		{
-			UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
-			SectorVariation Variation = ComputeSectorResourceVariation(Sector);
-
-			WorldResourceVariation.Add(Sector, Variation);
-			//DumpSectorResourceVariation(Sector, &Variation);
-		}
+	}
+}
 
+void UFlareCompanyAI::Simulate()
+{
+	if (Game && Company != Game->GetPC()->GetCompany())
+	{
 		Behavior->Simulate();
 
 		PurchaseResearch();
@@ -121,6 +112,25 @@ void UFlareCompanyAI::Simulate()
 	}
 }
 
+void UFlareCompanyAI::Plan(const WorldHelper::FlareWorldEconomySnapshot& Snapshot)
+{
+	// World-wide data comes from the daily snapshot, only company-specific filtering is done here
+	ResourceFlow = ComputeWorldResourceFlow(Snapshot);
+	WorldStats = Snapshot.WorldStats;
+	Shipyards = FindShipyards(Snapshot);
+
+	// Compute input and output ressource equation (ex: 100 + 10/ day)
+	WorldResourceVariation.Empty();
+	for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
+	{
+		UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
+		SectorVariation Variation = ComputeSectorResourceVariation(Sector, Snapshot.Sectors[Sector]);
+
+		WorldResourceVariation.Add(Sector, Variation);
+		//DumpSectorResourceVariation(Sector, &Variation);
+	}
+}
+
 void UFlareCompanyAI::PurchaseResearch()
 {
 	FText Reason;
@@ -2710,7 +2720,7 @@ bool UFlareCompanyAI::IsBuildingShip(bool Military)
 }
 
 
-TArray<UFlareSimulatedSpacecraft*> UFlareCompanyAI::FindShipyards()
+TArray<UFlareSimulatedSpacecraft*> UFlareCompanyAI::FindShipyards(const WorldHelper::FlareWorldEconomySnapshot& Snapshot)
 {
 	TArray<UFlareSimulatedSpacecraft*> ShipyardList;
 
@@ -2718,27 +2728,18 @@ TArray<UFlareSimulatedSpacecraft*> UFlareCompanyAI::FindShipyards()
 	for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
 	{
 		UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
+		const TArray<UFlareSimulatedSpacecraft*>& SectorShipyards = Snapshot.Sectors[Sector].Shipyards;
 
-		for (int32 StationIndex = 0; StationIndex < Sector->GetSectorStations().Num(); StationIndex++)
+		for (int32 StationIndex = 0; StationIndex < SectorShipyards.Num(); StationIndex++)
 		{
-			UFlareSimulatedSpacecraft* Station = Sector->GetSectorStations()[StationIndex];
+			UFlareSimulatedSpacecraft* Station = SectorShipyards[StationIndex];
 
 			if (Company->GetWarState(Station->GetCompany()) == EFlareHostility::Hostile)
 			{
 				continue;
 			}
 
-			TArray<UFlareFactory*>& Factories = Station->GetFactories();
-
-			for (int32 Index = 0; Index < Factories.Num(); Index++)
-			{
-				UFlareFactory* Factory = Factories[Index];
-				if (Factory->IsShipyard())
-				{
-					ShipyardList.Add(Station);
-					break;
-				}
-			}
+			ShipyardList.Add(Station);
 		}
 	}
 
@@ -3289,7 +3290,7 @@ float UFlareCompanyAI::ComputeStationPrice(UFlareSimulatedSector* Sector, FFlare
 }
 
 
-SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedSector* Sector) const
+SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedSector* Sector, const WorldHelper::FlareSectorEconomySnapshot& SectorSnapshot) const
 {
 	SectorVariation SectorVariation;
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
@@ -3580,52 +3581,18 @@ SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedS
 			struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
 
 
-			int32 Consumption = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
+			int32 Consumption = SectorSnapshot.PeopleConsumption[Resource];
 
 			Variation->OwnedFlow = OwnedCustomerRatio * Consumption;
 			Variation->FactoryFlow = NotOwnedCustomerRatio * Consumption * Behavior->TradingSell;
 		}
 	}
 
-	// Compute incoming capacity and resources
-	SectorVariation.IncomingCapacity = 0;
-	for (int32 TravelIndex = 0; TravelIndex < Game->GetGameWorld()->GetTravels().Num(); TravelIndex++)
+	// Incoming capacity and resources
+	SectorVariation.IncomingCapacity = SectorSnapshot.IncomingCapacity;
+	for (auto& IncomingResource : SectorSnapshot.IncomingResources)
 	{
-		UFlareTravel* Travel = Game->GetGameWorld()->GetTravels()[TravelIndex];
-		if (Travel->GetDestinationSector() != Sector)
-		{
-			continue;
-		}
-
-		int64 RemainingTravelDuration = FMath::Max((int64) 1, Travel->GetRemainingTravelDuration());
-
-		UFlareFleet* IncomingFleet = Travel->GetFleet();
-
-
-		for (int32 ShipIndex = 0; ShipIndex < IncomingFleet->GetShips().Num(); ShipIndex++)
-		{
-			UFlareSimulatedSpacecraft* Ship = IncomingFleet->GetShips()[ShipIndex];
-
-			if (Ship->GetCargoBay()->GetSlotCapacity() == 0 && Ship->GetDamageSystem()->IsStranded())
-			{
-				continue;
-			}
-			SectorVariation.IncomingCapacity += Ship->GetCargoBay()->GetCapacity() / RemainingTravelDuration;
-
-			TArray<FFlareCargo>& CargoBaySlots = Ship->GetCargoBay()->GetSlots();
-			for (int32 CargoIndex = 0; CargoIndex < CargoBaySlots.Num(); CargoIndex++)
-			{
-				FFlareCargo& Cargo = CargoBaySlots[CargoIndex];
-
-				if (!Cargo.Resource)
-				{
-					continue;
-				}
-				struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Cargo.Resource];
-
-				Variation->IncomingResources += Cargo.Quantity / (RemainingTravelDuration * 0.5);
-			}
-		}
+		SectorVariation.ResourceVariations[IncomingResource.Key].IncomingResources += IncomingResource.Value;
 	}
 
 	// Add damage fleet and repair to maintenance capacity
@@ -3634,24 +3601,14 @@ SectorVariation UFlareCompanyAI::ComputeSectorResourceVariation(UFlareSimulatedS
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->MaintenanceResources[ResourceIndex]->Data;
 		struct ResourceVariation* Variation = &SectorVariation.ResourceVariations[Resource];
 
-		for (int CompanyIndex = 0; CompanyIndex < Game->GetGameWorld()->GetCompanies().Num(); CompanyIndex++)
+		for (auto& FleetSupplyNeeds : SectorSnapshot.FleetSupplyNeeds)
 		{
-			UFlareCompany* OtherCompany = Game->GetGameWorld()->GetCompanies()[CompanyIndex];
-
-			if (OtherCompany->GetWarState(Company) == EFlareHostility::Hostile)
+			if (FleetSupplyNeeds.Key->GetWarState(Company) == EFlareHostility::Hostile)
 			{
 				continue;
 			}
 
-			int32 NeededFS;
-			int32 TotalNeededFS;
-			int64 MaxDuration;
-
-			SectorHelper::GetRefillFleetSupplyNeeds(Sector, OtherCompany, NeededFS, TotalNeededFS, MaxDuration);
-			Variation->MaintenanceCapacity += TotalNeededFS;
-
-			SectorHelper::GetRepairFleetSupplyNeeds(Sector, OtherCompany, NeededFS, TotalNeededFS, MaxDuration);
-			Variation->MaintenanceCapacity += TotalNeededFS;
+			Variation->MaintenanceCapacity += FleetSupplyNeeds.Value;
 		}
 	}
 
@@ -4046,7 +4003,7 @@ SectorDeal UFlareCompanyAI::FindBestDealForShipFromSector(UFlareSimulatedSpacecr
 	return BestDeal;
 }
 
-TMap<FFlareResourceDescription*, int32> UFlareCompanyAI::ComputeWorldResourceFlow() const
+TMap<FFlareResourceDescription*, int32> UFlareCompanyAI::ComputeWorldResourceFlow(const WorldHelper::FlareWorldEconomySnapshot& Snapshot) const
 {
 	TMap<FFlareResourceDescription*, int32> WorldResourceFlow;
 	for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
@@ -4059,62 +4016,26 @@ TMap<FFlareResourceDescription*, int32> UFlareCompanyAI::ComputeWorldResourceFlo
 	for (int32 SectorIndex = 0; SectorIndex < Company->GetKnownSectors().Num(); SectorIndex++)
 	{
 		UFlareSimulatedSector* Sector = Company->GetKnownSectors()[SectorIndex];
+		const TArray<WorldHelper::FlareStationFlow>& StationFlows = Snapshot.Sectors[Sector].StationFlows;
 		int32 CustomerStation = 0;
 
-
-		for (int32 StationIndex = 0; StationIndex < Sector->GetSectorStations().Num(); StationIndex++)
+		for (int32 StationIndex = 0; StationIndex < StationFlows.Num(); StationIndex++)
 		{
-			UFlareSimulatedSpacecraft* Station = Sector->GetSectorStations()[StationIndex];
-
+			const WorldHelper::FlareStationFlow& StationFlow = StationFlows[StationIndex];
 
-			if (Station->GetCompany()->GetWarState(Company) == EFlareHostility::Hostile)
+			if (StationFlow.Station->GetCompany()->GetWarState(Company) == EFlareHostility::Hostile)
 			{
 				continue;
 			}
 
-			if (Station->HasCapability(EFlareSpacecraftCapability::Consumer))
+			if (StationFlow.Station->HasCapability(EFlareSpacecraftCapability::Consumer))
 			{
 				CustomerStation++;
 			}
 
-			for (int32 FactoryIndex = 0; FactoryIndex < Station->GetFactories().Num(); FactoryIndex++)
+			for (auto& Flow : StationFlow.Flow)
 			{
-				UFlareFactory* Factory = Station->GetFactories()[FactoryIndex];
-				if ((!Factory->IsActive() || !Factory->IsNeedProduction()))
-				{
-					// No resources needed
-					break;
-				}
-
-				// Input flow
-				for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetInputResourcesCount(); ResourceIndex++)
-				{
-					FFlareResourceDescription* Resource = Factory->GetInputResource(ResourceIndex);
-
-					int64 ProductionDuration = Factory->GetProductionDuration();
-					if (ProductionDuration == 0)
-					{
-						ProductionDuration = 10;
-					}
-
-					int32 Flow = Factory->GetInputResourceQuantity(ResourceIndex) / ProductionDuration;
-					WorldResourceFlow[Resource] -= Flow;
-				}
-
-				// Ouput flow
-				for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetOutputResourcesCount(); ResourceIndex++)
-				{
-					FFlareResourceDescription* Resource = Factory->GetOutputResource(ResourceIndex);
-
-					int64 ProductionDuration = Factory->GetProductionDuration();
-					if (ProductionDuration == 0)
-					{
-						ProductionDuration = 10;
-					}
-
-					int32 Flow = Factory->GetOutputResourceQuantity(ResourceIndex) / ProductionDuration;
-					WorldResourceFlow[Resource] += Flow;
-				}
+				WorldResourceFlow[Flow.Key] += Flow.Value;
 			}
 		}
 
@@ -4124,7 +4045,7 @@ TMap<FFlareResourceDescription*, int32> UFlareCompanyAI::ComputeWorldResourceFlo
 			{
 				FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
 
-				int32 Consumption = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
+				int32 Consumption = Snapshot.Sectors[Sector].PeopleConsumption[Resource];
 				WorldResourceFlow[Resource] -= Consumption;
 			}
 		}
@@ -95,7 +95,13 @@ public:
 	/** Real-time tick */
 	virtual void Tick();
 
-	/** Simulate a day */
+	/** Resolve battles and update diplomacy, before planning */
+	virtual void SimulateDiplomacy();
+
+	/** Analyse the world economy for this AI company. Only reads the world and caches warmed by the world, may run in parallel with other companies */
+	virtual void Plan(const WorldHelper::FlareWorldEconomySnapshot& Snapshot);
+
+	/** Simulate a day, using the last plan */
 	virtual void Simulate();
 
 	/** Try to purchase research */
@@ -218,7 +224,7 @@ protected:
 	bool IsBuildingShip(bool Military);
 
 	/** Get a list of shipyard */
-	TArray<UFlareSimulatedSpacecraft*> FindShipyards();
+	TArray<UFlareSimulatedSpacecraft*> FindShipyards(const WorldHelper::FlareWorldEconomySnapshot& Snapshot);
 
 	/** Get a list of wrecked cargos */
 	TArray<UFlareSimulatedSpacecraft*> FindIncapacitatedCargos() const;
@@ -239,14 +245,14 @@ protected:
 	float ComputeStationPrice(UFlareSimulatedSector* Sector, FFlareSpacecraftDescription* StationDescription, UFlareSimulatedSpacecraft* Station) const;
 
 	/** Get the resource flow in this sector */
-	SectorVariation ComputeSectorResourceVariation(UFlareSimulatedSector* Sector) const;
+	SectorVariation ComputeSectorResourceVariation(UFlareSimulatedSector* Sector, const WorldHelper::FlareSectorEconomySnapshot& SectorSnapshot) const;
 
 	/** Print the resource flow */
 	void DumpSectorResourceVariation(UFlareSimulatedSector* Sector, TMap<FFlareResourceDescription*, struct ResourceVariation>* Variation) const;
 
 	SectorDeal FindBestDealForShipFromSector(UFlareSimulatedSpacecraft* Ship, UFlareSimulatedSector* SectorA, SectorDeal* DealToBeat);
 	
-	TMap<FFlareResourceDescription*, int32> ComputeWorldResourceFlow() const;
+	TMap<FFlareResourceDescription*, int32> ComputeWorldResourceFlow(const WorldHelper::FlareWorldEconomySnapshot& Snapshot) const;
 
 
 protected:
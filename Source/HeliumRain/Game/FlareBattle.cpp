@@ -31,6 +31,10 @@ struct BattleTargetPreferences
 
 UFlareBattle::UFlareBattle(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, TurnCount(0)
+	, UseTargetPools(true)
+	, Silent(false)
+	, FightersValid(false)
 {
 }
 
@@ -41,6 +45,11 @@ void UFlareBattle::Load(UFlareSimulatedSector* BattleSector)
     PlayerCompany = Game->GetPC()->GetCompany();
 	Catalog = Game->GetShipPartsCatalog();
 
+	TurnCount = 0;
+	TargetPools.Empty();
+	TargetStates.Empty();
+	Fighters.Empty();
+	FightersValid = false;
 }
 
 /*----------------------------------------------------
@@ -71,6 +80,7 @@ void UFlareBattle::Simulate()
         }
     }
 
+	TurnCount = BattleTurn;
 	CombatLog::AutomaticBattleEnded(Sector);
     FLOGV("Battle in %s finish after %d turns", *Sector->GetSectorName().ToString(), BattleTurn);
 }
@@ -125,30 +135,61 @@ bool UFlareBattle::SimulateTurn()
 
     // List all fighting ships
     TArray<UFlareSimulatedSpacecraft*> ShipToSimulate;
-    for (int32 ShipIndex = 0 ; ShipIndex < Sector->GetSectorShips().Num(); ShipIndex++)
-    {
-        UFlareSimulatedSpacecraft* Ship = Sector->GetSectorShips()[ShipIndex];
+	if (UseTargetPools)
+	{
+		// Ships can't be rearmed during a battle, so the fighters are listed once
+		if (!FightersValid)
+		{
+			for (UFlareSimulatedSpacecraft* Ship : Sector->GetSectorShips())
+			{
+				if (!Ship->IsReserve() && Ship->IsMilitary())
+				{
+					Fighters.Add(Ship);
+				}
+			}
+			FightersValid = true;
+		}
 
-		if(Ship->IsReserve())
+		Fighters.RemoveAll([](UFlareSimulatedSpacecraft* Ship)
 		{
-			// No in fight
-			continue;
+			return Ship->GetDamageSystem()->IsDisarmed();
+		});
+
+		for (UFlareSimulatedSpacecraft* Ship : Fighters)
+		{
+			if (FightingCompanies.Contains(Ship->GetCompany()))
+			{
+				ShipToSimulate.Add(Ship);
+			}
 		}
+	}
+	else
+	{
+		for (int32 ShipIndex = 0 ; ShipIndex < Sector->GetSectorShips().Num(); ShipIndex++)
+		{
+			UFlareSimulatedSpacecraft* Ship = Sector->GetSectorShips()[ShipIndex];
 
-		if(!Ship->IsMilitary()  || Ship->GetDamageSystem()->IsDisarmed())
-        {
-            // No weapon
-            continue;
-        }
+			if(Ship->IsReserve())
+			{
+				// No in fight
+				continue;
+			}
 
-        if(!FightingCompanies.Contains(Ship->GetCompany()))
-        {
-            // Not in war
-            continue;
-        }
+			if(!Ship->IsMilitary()  || Ship->GetDamageSystem()->IsDisarmed())
+			{
+				// No weapon
+				continue;
+			}
 
-        ShipToSimulate.Add(Ship);
-    }
+			if(!FightingCompanies.Contains(Ship->GetCompany()))
+			{
+				// Not in war
+				continue;
+			}
+
+			ShipToSimulate.Add(Ship);
+		}
+	}
 
     // Play fighting ship inthem in random order
 
@@ -162,9 +203,12 @@ bool UFlareBattle::SimulateTurn()
         ShipToSimulate.RemoveAt(Index);
     }
 
-	for (UFlareSimulatedSpacecraft* Ship : Sector->GetSectorSpacecrafts())
+	if (!Silent)
 	{
-		Ship->GetDamageSystem()->NotifyDamage();
+		for (UFlareSimulatedSpacecraft* Ship : Sector->GetSectorSpacecrafts())
+		{
+			Ship->GetDamageSystem()->NotifyDamage();
+		}
 	}
 
     return HasFight;
@@ -306,8 +350,13 @@ bool UFlareBattle::SimulateLargeShipTurn(UFlareSimulatedSpacecraft* Ship)
 	return HasAttacked;
 }
 
-UFlareSimulatedSpacecraft* UFlareBattle::GetBestTarget(UFlareSimulatedSpacecraft* Ship, struct BattleTargetPreferences Preferences)
+UFlareSimulatedSpacecraft* UFlareBattle::GetBestTarget(UFlareSimulatedSpacecraft* Ship, const struct BattleTargetPreferences& Preferences)
 {
+	if (UseTargetPools)
+	{
+		return GetBestPoolTarget(Ship, Preferences);
+	}
+
 	UFlareSimulatedSpacecraft* BestTarget = NULL;
 	float BestScore = 0;
 
@@ -317,21 +366,16 @@ UFlareSimulatedSpacecraft* UFlareBattle::GetBestTarget(UFlareSimulatedSpacecraft
 	{
 		UFlareSimulatedSpacecraft* ShipCandidate = Sector->GetSectorSpacecrafts()[SpacecraftIndex];
 
-		if(ShipCandidate->IsReserve())
-		{
-			// No in fight
-			continue;
-		}
-
 		if (Ship->GetCompany()->GetWarState(ShipCandidate->GetCompany()) != EFlareHostility::Hostile)
 		{
 			// Ignore not hostile ships
 			continue;
 		}
 
-		if (!ShipCandidate->GetDamageSystem()->IsAlive())
+		int32 State = GetTargetState(ShipCandidate);
+		if (State & EFlareBattleTargetState::Ignored)
 		{
-			// Ignore destroyed ships
+			// Reserve, destroyed, or harpooned and uncontrollable
 			continue;
 		}
 
@@ -339,78 +383,7 @@ UFlareSimulatedSpacecraft* UFlareBattle::GetBestTarget(UFlareSimulatedSpacecraft
 		float StateScore;
 		float DistanceScore;
 
-		StateScore = Preferences.TargetStateWeight;
-
-		if (ShipCandidate->GetSize() == EFlarePartSize::L)
-		{
-			StateScore *= Preferences.IsLarge;
-		}
-
-		if (ShipCandidate->GetSize() == EFlarePartSize::S)
-		{
-			StateScore *= Preferences.IsSmall;
-		}
-
-		if (ShipCandidate->IsStation())
-		{
-			StateScore *= Preferences.IsStation;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotStation;
-		}
-
-		if (ShipCandidate->IsMilitary())
-		{
-			StateScore *= Preferences.IsMilitary;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotMilitary;
-		}
-
-		if(ShipCandidate->IsMilitary()  && !ShipCandidate->GetDamageSystem()->IsDisarmed())
-		{
-			StateScore *= Preferences.IsDangerous;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotDangerous;
-		}
-
-		if (ShipCandidate->GetDamageSystem()->IsStranded())
-		{
-			StateScore *= Preferences.IsStranded;
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotStranded;
-		}
-
-		if (ShipCandidate->GetDamageSystem()->IsUncontrollable() && ShipCandidate->GetDamageSystem()->IsDisarmed())
-		{
-			if(ShipCandidate->IsMilitary())
-			{
-				StateScore *= Preferences.IsUncontrollableMilitary;
-			}
-			else
-			{
-				StateScore *= Preferences.IsUncontrollableCivil;
-			}
-		}
-		else
-		{
-			StateScore *= Preferences.IsNotUncontrollable;
-		}
-
-		if(ShipCandidate->IsHarpooned()) {
-			if(ShipCandidate->GetDamageSystem()->IsUncontrollable())
-			{
-				// Never target harponned uncontrollable ships
-				continue;
-			}
-			StateScore *=  Preferences.IsHarpooned;
-		}
+		StateScore = GetTargetStateScore(State, Preferences);
 
 		DistanceScore = FMath::FRand();
 
@@ -519,6 +492,11 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 
 		Weapon->Weapon.FiredAmmo += AmmoToFire;
 		Target->GetDamageSystem()->SetAmmoDirty();
+
+		if (UseTargetPools)
+		{
+			UpdateTargetState(Target);
+		}
 	}
 	else if(WeaponDescription->WeaponCharacteristics.BombCharacteristics.IsBomb && CurrentAmmo > 0)
 	{
@@ -532,6 +510,11 @@ bool UFlareBattle::SimulateShipWeaponAttack(UFlareSimulatedSpacecraft* Ship, FFl
 
 		Weapon->Weapon.FiredAmmo++;
 		Target->GetDamageSystem()->SetAmmoDirty();
+
+		if (UseTargetPools)
+		{
+			UpdateTargetState(Target);
+		}
 	}
 	else
 	{
@@ -701,4 +684,226 @@ int32 UFlareBattle::GetBestTargetComponent(UFlareSimulatedSpacecraft* TargetSpac
 }
 
 
+/*----------------------------------------------------
+	Target pools
+----------------------------------------------------*/
+
+static void AddPoolTarget(FFlareBattleTargetPool& Pool, int32 State, UFlareSimulatedSpacecraft* Target)
+{
+	for (FFlareBattleTargetClass& Class : Pool.Classes)
+	{
+		if (Class.State == State)
+		{
+			Class.Targets.Add(Target);
+			return;
+		}
+	}
+
+	FFlareBattleTargetClass NewClass;
+	NewClass.State = State;
+	NewClass.Targets.Add(Target);
+	Pool.Classes.Add(NewClass);
+}
+
+int32 UFlareBattle::GetTargetState(UFlareSimulatedSpacecraft* Target) const
+{
+	UFlareSimulatedSpacecraftDamageSystem* DamageSystem = Target->GetDamageSystem();
+
+	// Never target reserve ships, destroyed ships, or harpooned uncontrollable ships
+	if (Target->IsReserve() || !DamageSystem->IsAlive() || (Target->IsHarpooned() && DamageSystem->IsUncontrollable()))
+	{
+		return EFlareBattleTargetState::Ignored;
+	}
+
+	int32 State = 0;
+
+	if (Target->GetSize() == EFlarePartSize::L)
+	{
+		State |= EFlareBattleTargetState::Large;
+	}
+	else if (Target->GetSize() == EFlarePartSize::S)
+	{
+		State |= EFlareBattleTargetState::Small;
+	}
+
+	if (Target->IsStation())
+	{
+		State |= EFlareBattleTargetState::Station;
+	}
+
+	if (Target->IsMilitary())
+	{
+		State |= EFlareBattleTargetState::Military;
+
+		if (!DamageSystem->IsDisarmed())
+		{
+			State |= EFlareBattleTargetState::Dangerous;
+		}
+	}
+
+	if (DamageSystem->IsStranded())
+	{
+		State |= EFlareBattleTargetState::Stranded;
+	}
+
+	if (DamageSystem->IsUncontrollable() && DamageSystem->IsDisarmed())
+	{
+		State |= EFlareBattleTargetState::UncontrollableDisarmed;
+	}
+
+	if (Target->IsHarpooned())
+	{
+		State |= EFlareBattleTargetState::Harpooned;
+	}
+
+	return State;
+}
+
+float UFlareBattle::GetTargetStateScore(int32 State, const struct BattleTargetPreferences& Preferences) const
+{
+	float StateScore = Preferences.TargetStateWeight;
+
+	if (State & EFlareBattleTargetState::Large)
+	{
+		StateScore *= Preferences.IsLarge;
+	}
+
+	if (State & EFlareBattleTargetState::Small)
+	{
+		StateScore *= Preferences.IsSmall;
+	}
+
+	StateScore *= (State & EFlareBattleTargetState::Station) ? Preferences.IsStation : Preferences.IsNotStation;
+	StateScore *= (State & EFlareBattleTargetState::Military) ? Preferences.IsMilitary : Preferences.IsNotMilitary;
+	StateScore *= (State & EFlareBattleTargetState::Dangerous) ? Preferences.IsDangerous : Preferences.IsNotDangerous;
+	StateScore *= (State & EFlareBattleTargetState::Stranded) ? Preferences.IsStranded : Preferences.IsNotStranded;
+
+	if (State & EFlareBattleTargetState::UncontrollableDisarmed)
+	{
+		StateScore *= (State & EFlareBattleTargetState::Military) ? Preferences.IsUncontrollableMilitary : Preferences.IsUncontrollableCivil;
+	}
+	else
+	{
+		StateScore *= Preferences.IsNotUncontrollable;
+	}
+
+	if (State & EFlareBattleTargetState::Harpooned)
+	{
+		StateScore *= Preferences.IsHarpooned;
+	}
+
+	return StateScore;
+}
+
+FFlareBattleTargetPool& UFlareBattle::GetTargetPool(UFlareCompany* Company)
+{
+	FFlareBattleTargetPool* ExistingPool = TargetPools.Find(Company);
+	if (ExistingPool)
+	{
+		return *ExistingPool;
+	}
+
+	// Wars don't change during a battle, so the hostile targets are listed once
+	FFlareBattleTargetPool& Pool = TargetPools.Add(Company);
+	for (UFlareSimulatedSpacecraft* Candidate : Sector->GetSectorSpacecrafts())
+	{
+		if (Company->GetWarState(Candidate->GetCompany()) != EFlareHostility::Hostile)
+		{
+			continue;
+		}
+
+		int32* CachedState = TargetStates.Find(Candidate);
+		int32 State = (CachedState ? *CachedState : TargetStates.Add(Candidate, GetTargetState(Candidate)));
+
+		if (!(State & EFlareBattleTargetState::Ignored))
+		{
+			AddPoolTarget(Pool, State, Candidate);
+		}
+	}
+
+	return Pool;
+}
+
+UFlareSimulatedSpacecraft* UFlareBattle::GetBestPoolTarget(UFlareSimulatedSpacecraft* Ship, const struct BattleTargetPreferences& Preferences)
+{
+	FFlareBattleTargetPool& Pool = GetTargetPool(Ship->GetCompany());
+	FFlareBattleTargetClass* BestClass = NULL;
+	float BestScore = 0;
+
+	// All targets of a class share their state score, so only the best random draw of each class matters.
+	// The best of N uniform draws is distributed like one uniform draw to the power of 1/N.
+	for (FFlareBattleTargetClass& Class : Pool.Classes)
+	{
+		if (Class.Targets.Num() == 0)
+		{
+			continue;
+		}
+
+		float StateScore = GetTargetStateScore(Class.State, Preferences);
+		if (StateScore <= 0)
+		{
+			continue;
+		}
+
+		float Score = StateScore * FMath::Pow(FMath::FRand(), 1.f / Class.Targets.Num());
+
+		if (Score > 0)
+		{
+			if (BestClass == NULL || Score > BestScore)
+			{
+				BestClass = &Class;
+				BestScore = Score;
+			}
+		}
+	}
+
+	if (!BestClass)
+	{
+		return NULL;
+	}
+
+	// The best draw is equally likely to be any target of the class
+	return BestClass->Targets[FMath::RandRange(0, BestClass->Targets.Num() - 1)];
+}
+
+void UFlareBattle::UpdateTargetState(UFlareSimulatedSpacecraft* Target)
+{
+	int32* CachedState = TargetStates.Find(Target);
+	if (!CachedState || (*CachedState & EFlareBattleTargetState::Ignored))
+	{
+		// Not in any pool yet, or never again
+		return;
+	}
+
+	int32 OldState = *CachedState;
+	int32 NewState = GetTargetState(Target);
+	if (NewState == OldState)
+	{
+		return;
+	}
+
+	*CachedState = NewState;
+
+	for (auto& PoolEntry : TargetPools)
+	{
+		FFlareBattleTargetPool& Pool = PoolEntry.Value;
+		bool Removed = false;
+
+		for (FFlareBattleTargetClass& Class : Pool.Classes)
+		{
+			if (Class.State == OldState)
+			{
+				Removed = (Class.Targets.RemoveSwap(Target) > 0);
+				break;
+			}
+		}
+
+		if (Removed && !(NewState & EFlareBattleTargetState::Ignored))
+		{
+			AddPoolTarget(Pool, NewState, Target);
+		}
+	}
+}
+
+
 #undef LOCTEXT_NAMESPACE
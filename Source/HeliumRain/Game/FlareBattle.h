@@ -7,6 +7,39 @@
 class UFlareSpacecraftComponentsCatalog;
 
 
+/** Target state bits, as used by the battle target scores */
+namespace EFlareBattleTargetState
+{
+	enum Type
+	{
+		Large =                    1 << 0,
+		Small =                    1 << 1,
+		Station =                  1 << 2,
+		Military =                 1 << 3,
+		Dangerous =                1 << 4,
+		Stranded =                 1 << 5,
+		UncontrollableDisarmed =   1 << 6,
+		Harpooned =                1 << 7,
+
+		// Never targeted again in this battle
+		Ignored =                  1 << 8
+	};
+}
+
+/** Targets sharing the same state, which all have the same target score */
+struct FFlareBattleTargetClass
+{
+	int32                                   State;
+	TArray<UFlareSimulatedSpacecraft*>      Targets;
+};
+
+/** Targets of a company in a battle, grouped by state */
+struct FFlareBattleTargetPool
+{
+	TArray<FFlareBattleTargetClass>         Classes;
+};
+
+
 UCLASS()
 class HELIUMRAIN_API UFlareBattle : public UObject
 {
@@ -21,6 +54,19 @@ public:
 	/** Load the battle state */
 	virtual void Load(UFlareSimulatedSector* BattleSector);
 
+	/** Use per-company target pools instead of scoring every spacecraft for each shot */
+	void SetUseTargetPools(bool NewUseTargetPools)
+	{
+		UseTargetPools = NewUseTargetPools;
+	}
+
+	/** Don't notify quests of damages, for battles that will be rolled back */
+	void SetSilent(bool NewSilent)
+	{
+		Silent = NewSilent;
+	}
+
+
 	/*----------------------------------------------------
 		Gameplay
 	----------------------------------------------------*/
@@ -35,7 +81,7 @@ public:
 
 	bool SimulateLargeShipTurn(UFlareSimulatedSpacecraft* Ship);
 
-	UFlareSimulatedSpacecraft* GetBestTarget(UFlareSimulatedSpacecraft* Ship, struct BattleTargetPreferences Preferences);
+	UFlareSimulatedSpacecraft* GetBestTarget(UFlareSimulatedSpacecraft* Ship, const struct BattleTargetPreferences& Preferences);
 
 	bool SimulateShipAttack(UFlareSimulatedSpacecraft* Ship, int32 WeaponGroupIndex, UFlareSimulatedSpacecraft* Target);
 
@@ -51,10 +97,43 @@ public:
 
 protected:
 
+	/*----------------------------------------------------
+		Target pools
+	----------------------------------------------------*/
+
+	/** Get the state bits of a target */
+	int32 GetTargetState(UFlareSimulatedSpacecraft* Target) const;
+
+	/** Get the score of a target state for these preferences */
+	float GetTargetStateScore(int32 State, const struct BattleTargetPreferences& Preferences) const;
+
+	/** Get the hostile targets of Company, building the pool on first use */
+	FFlareBattleTargetPool& GetTargetPool(UFlareCompany* Company);
+
+	/** Pick a target from the pool of the ship's company */
+	UFlareSimulatedSpacecraft* GetBestPoolTarget(UFlareSimulatedSpacecraft* Ship, const struct BattleTargetPreferences& Preferences);
+
+	/** Move a target to the class of its new state in every pool after it took damage */
+	void UpdateTargetState(UFlareSimulatedSpacecraft* Target);
+
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
 	UFlareSimulatedSector*                  Sector;
 	AFlareGame*                             Game;
 	UFlareCompany*                          PlayerCompany;
 	UFlareSpacecraftComponentsCatalog*      Catalog;
+	int32                                   TurnCount;
+	bool                                    UseTargetPools;
+	bool                                    Silent;
+
+	// Target pools
+	TMap<UFlareCompany*, FFlareBattleTargetPool>     TargetPools;
+	TMap<UFlareSimulatedSpacecraft*, int32>          TargetStates;
+	TArray<UFlareSimulatedSpacecraft*>               Fighters;
+	bool                                             FightersValid;
 
 public:
 
@@ -67,5 +146,11 @@ public:
 		return Game;
 	}
 
+	/** Get the number of turns played by the last simulation */
+	int32 GetTurnCount() const
+	{
+		return TurnCount;
+	}
+
         bool HasBattle();
 };
@@ -20,6 +20,7 @@
 
 UFlareCompany::UFlareCompany(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, WorldIndex(INDEX_NONE)
 {
 }
 
@@ -227,7 +228,7 @@ EFlareHostility::Type UFlareCompany::GetHostility(const UFlareCompany* TargetCom
 	{
 		return EFlareHostility::Owned;
 	}
-	else if (TargetCompany && CompanyData.HostileCompanies.Contains(TargetCompany->GetIdentifier()))
+	else if (TargetCompany && Game->GetGameWorld()->IsHostile(this, TargetCompany))
 	{
 		return EFlareHostility::Hostile;
 	}
@@ -253,12 +254,12 @@ EFlareHostility::Type UFlareCompany::GetWarState(const UFlareCompany* TargetComp
 	{
 		return EFlareHostility::Owned;
 	}
-	else if (GetHostility(TargetCompany) == EFlareHostility::Hostile || TargetCompany->GetHostility(this) == EFlareHostility::Hostile)
+	else if (TargetCompany && Game->GetGameWorld()->IsAtWar(this, TargetCompany))
 	{
 		return EFlareHostility::Hostile;
 	}
 
-	return GetHostility(TargetCompany);
+	return EFlareHostility::Neutral;
 }
 
 void UFlareCompany::ClearLastWarDate()
@@ -289,6 +290,8 @@ void UFlareCompany::SetHostilityTo(UFlareCompany* TargetCompany, bool Hostile)
 		if (Hostile && !WasHostile)
 		{
 			CompanyData.HostileCompanies.AddUnique(TargetCompany->GetIdentifier());
+			Game->GetGameWorld()->SetHostility(this, TargetCompany, true);
+			Game->GetGameWorld()->InvalidateBattleStates();
 			TargetCompany->GiveReputation(this, -50, true);
 
 			UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
@@ -332,6 +335,8 @@ void UFlareCompany::SetHostilityTo(UFlareCompany* TargetCompany, bool Hostile)
 		else if(!Hostile && WasHostile)
 		{
 			CompanyData.HostileCompanies.Remove(TargetCompany->GetIdentifier());
+			Game->GetGameWorld()->SetHostility(this, TargetCompany, false);
+			Game->GetGameWorld()->InvalidateBattleStates();
 
 			UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 
@@ -1025,9 +1030,10 @@ bool UFlareCompany::HasKnowResourceInput(FFlareResourceDescription* Resource)
 {
 	for(UFlareSimulatedSector* Sector : VisitedSectors)
 	{
-		for(UFlareSimulatedSpacecraft* Station : Sector->GetSectorStations())
+		for(const FFlareMarketStation& MarketStation : Sector->GetMarketStations(Resource))
 		{
-			EFlareResourcePriceContext::Type StationResourceUsage = Station->GetResourceUseType(Resource);
+			UFlareSimulatedSpacecraft* Station = MarketStation.Station;
+			EFlareResourcePriceContext::Type StationResourceUsage = MarketStation.Usage;
 
 			if(StationResourceUsage != EFlareResourcePriceContext::FactoryInput &&
 				StationResourceUsage != EFlareResourcePriceContext::ConsumerConsumption &&
@@ -1051,9 +1057,10 @@ bool UFlareCompany::HasKnowResourceOutput(FFlareResourceDescription* Resource)
 {
 	for(UFlareSimulatedSector* Sector : VisitedSectors)
 	{
-		for(UFlareSimulatedSpacecraft* Station : Sector->GetSectorStations())
+		for(const FFlareMarketStation& MarketStation : Sector->GetMarketStations(Resource))
 		{
-			EFlareResourcePriceContext::Type StationResourceUsage = Station->GetResourceUseType(Resource);
+			UFlareSimulatedSpacecraft* Station = MarketStation.Station;
+			EFlareResourcePriceContext::Type StationResourceUsage = MarketStation.Usage;
 
 			if(StationResourceUsage != EFlareResourcePriceContext::FactoryOutput)
 			{
@@ -307,6 +307,7 @@ protected:
 
 	int32                                   ResearchAmount;
 	TMap<FName, FFlareTechnologyDescription*> UnlockedTechnologies;
+	int32                                   WorldIndex;
 
 
 public:
@@ -328,6 +329,23 @@ public:
 		return CompanyData.Identifier;
 	}
 
+	/** Get the index of this company in the world company list */
+	inline int32 GetWorldIndex() const
+	{
+		return WorldIndex;
+	}
+
+	inline void SetWorldIndex(int32 Index)
+	{
+		WorldIndex = Index;
+	}
+
+	/** Get the list of companies this company is hostile to, by identifier */
+	inline const TArray<FName>& GetHostileCompanies() const
+	{
+		return CompanyData.HostileCompanies;
+	}
+
 	inline const FFlareCompanyDescription* GetDescription() const
 	{
 		return CompanyDescription;
@@ -10,12 +10,13 @@
 #include "../Player/FlareMenuManager.h"
 #include "../Player/FlareHUD.h"
 #include "../Player/FlarePlayerController.h"
-#include "../Spacecrafts/FlareShell.h"
+#include "../Spacecrafts/FlareShellManager.h"
 #include "../Spacecrafts/FlareSimulatedSpacecraft.h"
 #include "../Quests/FlareQuestManager.h"
 #include "../Data/FlareQuestCatalog.h"
 #include "../Data/FlareResourceCatalog.h"
 #include "../Data/FlareSectorCatalogEntry.h"
+#include "FlareGameUserSettings.h"
 #include "Save/FlareSaveGameSystem.h"
 #include "AssetRegistryModule.h"
 #include "Log/FlareLogWriter.h"
@@ -386,56 +387,52 @@ void AFlareGame::ReadAllSaveSlots()
 	{
 		FFlareSaveSlotInfo SaveSlotInfo;
 		SaveSlotInfo.EmblemBrush.ImageSize = EmblemSize;
-		UFlareSaveGame* Save = AFlareGame::ReadSaveSlot(Index);
-		SaveSlotInfo.Save = Save;
+		FString SaveFile = "SaveSlot" + FString::FromInt(Index);
 
-		if (Save)
+		// Read the summary, or load the full save when it is missing
+		FFlareSaveSummary Summary;
+		SaveSlotInfo.Exists = SaveGameSystem->LoadSummary(SaveFile, Summary);
+		if (!SaveSlotInfo.Exists)
 		{
-			SaveSlotInfo.UUID = Save->PlayerData.UUID;
-
-			// Basic setup
-			UFlareCustomizationCatalog* Catalog = GetCustomizationCatalog();
-			FLOGV("AFlareGame::ReadAllSaveSlots : found valid save data in slot %d", Index);
-
-			// Count player ships
-			SaveSlotInfo.CompanyShipCount = 0;
-
-			// Find player company and count ships
-			FFlareCompanySave* PlayerCompany = NULL;
-            for (int32 CompanyIndex = 0; CompanyIndex < Save->WorldData.CompanyData.Num(); CompanyIndex++)
+			UFlareSaveGame* Save = AFlareGame::ReadSaveSlot(Index);
+			if (Save)
 			{
-                const FFlareCompanySave& Company = Save->WorldData.CompanyData[CompanyIndex];
-				if (Company.Identifier == Save->PlayerData.CompanyIdentifier)
+				SaveGameSystem->ComputeSummary(Save, Summary);
+				SaveSlotInfo.Exists = true;
+
+				// Store it for the next time
+				if (SaveGameSystem->DoesSaveGameExist(SaveFile))
 				{
-                    PlayerCompany = &(Save->WorldData.CompanyData[CompanyIndex]);
-					SaveSlotInfo.CompanyShipCount = Save->WorldData.CompanyData[CompanyIndex].ShipData.Num();
+					FLOGV("AFlareGame::ReadAllSaveSlots : writing missing summary for slot %d", Index);
+					SaveGameSystem->SaveSummary(SaveFile, Save);
 				}
 			}
+		}
 
-			// Company info
-			if (PlayerCompany)
-			{
-				const FFlareCompanyDescription* Desc = &Save->PlayerCompanyDescription;
-
-				// Money and general infos
-				SaveSlotInfo.CompanyValue = PlayerCompany->CompanyValue;
-				SaveSlotInfo.CompanyName = Desc->Name;
-
-				// Emblem material
-				SaveSlotInfo.Emblem = UMaterialInstanceDynamic::Create(BaseEmblemMaterial, GetWorld());
-				SaveSlotInfo.Emblem->SetTextureParameterValue("Emblem", GetCustomizationCatalog()->GetEmblem(Save->PlayerData.PlayerEmblemIndex));
-				SaveSlotInfo.Emblem->SetVectorParameterValue("BasePaintColor", Desc->CustomizationBasePaintColor);
-				SaveSlotInfo.Emblem->SetVectorParameterValue("PaintColor", Desc->CustomizationPaintColor);
-				SaveSlotInfo.Emblem->SetVectorParameterValue("OverlayColor", Desc->CustomizationOverlayColor);
-				SaveSlotInfo.Emblem->SetVectorParameterValue("GlowColor", Desc->CustomizationLightColor);
-
-				// Create the brush dynamically
-				SaveSlotInfo.EmblemBrush.SetResourceObject(SaveSlotInfo.Emblem);
-			}
+		if (SaveSlotInfo.Exists)
+		{
+			FLOGV("AFlareGame::ReadAllSaveSlots : found valid save data in slot %d", Index);
+			const FFlareCompanyDescription* Desc = &Summary.PlayerCompanyDescription;
+
+			// Money and general infos
+			SaveSlotInfo.UUID = Summary.UUID;
+			SaveSlotInfo.CompanyShipCount = Summary.CompanyShipCount;
+			SaveSlotInfo.CompanyValue = Summary.CompanyValue;
+			SaveSlotInfo.CompanyName = Desc->Name;
+
+			// Emblem material
+			SaveSlotInfo.Emblem = UMaterialInstanceDynamic::Create(BaseEmblemMaterial, GetWorld());
+			SaveSlotInfo.Emblem->SetTextureParameterValue("Emblem", GetCustomizationCatalog()->GetEmblem(Summary.PlayerEmblemIndex));
+			SaveSlotInfo.Emblem->SetVectorParameterValue("BasePaintColor", Desc->CustomizationBasePaintColor);
+			SaveSlotInfo.Emblem->SetVectorParameterValue("PaintColor", Desc->CustomizationPaintColor);
+			SaveSlotInfo.Emblem->SetVectorParameterValue("OverlayColor", Desc->CustomizationOverlayColor);
+			SaveSlotInfo.Emblem->SetVectorParameterValue("GlowColor", Desc->CustomizationLightColor);
+
+			// Create the brush dynamically
+			SaveSlotInfo.EmblemBrush.SetResourceObject(SaveSlotInfo.Emblem);
 		}
 		else
 		{
-			SaveSlotInfo.Save = NULL;
 			SaveSlotInfo.Emblem = NULL;
 			SaveSlotInfo.EmblemBrush = FSlateNoResource();
 			SaveSlotInfo.CompanyShipCount = 0;
@@ -468,7 +465,7 @@ void AFlareGame::SetCurrentSlot(int32 Index)
 bool AFlareGame::DoesSaveSlotExist(int32 Index) const
 {
 	int32 RealIndex = Index - 1;
-	return RealIndex < SaveSlots.Num() && SaveSlots[RealIndex].Save;
+	return RealIndex < SaveSlots.Num() && SaveSlots[RealIndex].Exists;
 }
 
 const FFlareSaveSlotInfo& AFlareGame::GetSaveSlotInfo(int32 Index)
@@ -702,21 +699,23 @@ class FAsyncSave : public FNonAbandonableTask
 {
 	friend class FAutoDeleteAsyncTask<FAsyncSave>;
 public:
-	FAsyncSave(UFlareSaveGameSystem* SaveSystemParam, const FString SaveNameParam, UFlareSaveGame *SaveDataParam) :
+	FAsyncSave(UFlareSaveGameSystem* SaveSystemParam, const FString SaveNameParam, UFlareSaveGame *SaveDataParam, bool BinaryParam) :
 		SaveName(SaveNameParam),
 		SaveData(SaveDataParam),
-		SaveSystem(SaveSystemParam)
+		SaveSystem(SaveSystemParam),
+		Binary(BinaryParam)
 	{}
 
 protected:
 	FString SaveName;
 	UFlareSaveGame *SaveData;
 	UFlareSaveGameSystem* SaveSystem;
+	bool Binary;
 
 	void DoWork()
 	{
 		FLOG("Async save start");
-		SaveSystem->SaveGame(SaveName, SaveData);
+		SaveSystem->SaveGame(SaveName, SaveData, Binary);
 		FLOG("Async save end");
 	}
 
@@ -754,16 +753,17 @@ bool AFlareGame::SaveGame(AFlarePlayerController* PC, bool Async)
 		FString SaveName = "SaveSlot" + FString::FromInt(CurrentSaveIndex);
 
 		// Save prototype
-
+		UFlareGameUserSettings* MyGameSettings = Cast<UFlareGameUserSettings>(GEngine->GetGameUserSettings());
+		bool Binary = MyGameSettings->UseBinarySaves;
 		SaveGameSystem->PushSaveData(Save);
 
 		if(Async)
 		{
-			(new FAutoDeleteAsyncTask<FAsyncSave>(SaveGameSystem, SaveName, Save))->StartBackgroundTask();
+			(new FAutoDeleteAsyncTask<FAsyncSave>(SaveGameSystem, SaveName, Save, Binary))->StartBackgroundTask();
 		}
 		else
 		{
-			SaveGameSystem->SaveGame(SaveName, Save);
+			SaveGameSystem->SaveGame(SaveName, Save, Binary);
 		}
 
 		return true;
@@ -806,7 +806,7 @@ void AFlareGame::UnloadGame()
 	for (int32 Index = 0; Index < ActorList.Num(); Index++)
 	{
 		if (ActorList[Index]->IsA(AFlareBomb::StaticClass())
-		 || ActorList[Index]->IsA(AFlareShell::StaticClass())
+		 || ActorList[Index]->IsA(AFlareShellManager::StaticClass())
 		 || ActorList[Index]->IsA(AFlareSpacecraft::StaticClass()))
 		{
 			ActorCount++;
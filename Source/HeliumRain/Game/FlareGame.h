@@ -42,9 +42,10 @@ struct FFlareSaveSlotInfo
 {
 	GENERATED_USTRUCT_BODY()
 
-	UPROPERTY() UFlareSaveGame*            Save;
 	UPROPERTY() UMaterialInstanceDynamic*  Emblem;
 
+	bool                       Exists;
+
 	FSlateBrush                EmblemBrush;
 
 	int32                      CompanyShipCount;
@@ -399,6 +400,11 @@ public:
 		return TechnologyCatalog;
 	}
 
+	inline UFlareSaveGameSystem* GetSaveGameSystem() const
+	{
+		return SaveGameSystem;
+	}
+
 	inline bool IsLoadedOrCreated() const
 	{
 		return LoadedOrCreated;
@@ -5,11 +5,12 @@
 #include "FlareGame.h"
 #include "../Player/FlarePlayerController.h"
 #include "FlareCompany.h"
+#include "FlareBattle.h"
 #include "FlareSectorHelper.h"
+#include "Save/FlareSaveGameSystem.h"
 
 #define LOCTEXT_NAMESPACE "FlareGameTools"
 
-bool UFlareGameTools::FastFastForward = false;
 
 /*----------------------------------------------------
 	Constructor
@@ -408,9 +409,452 @@ void UFlareGameTools::RevealMap()
 	GetGame()->ActivateCurrentSector();
 }
 
-void UFlareGameTools::SetFastFastForward(bool FFF)
+void UFlareGameTools::BenchmarkSimulation(int32 SaveSlot, int32 DayCount, int32 Seed)
 {
-	FastFastForward = FFF;
+	if (!GetGame()->DoesSaveSlotExist(SaveSlot))
+	{
+		FLOGV("UFlareGameTools::BenchmarkSimulation failed: no save in slot %d", SaveSlot);
+		return;
+	}
+
+	if (DayCount <= 0)
+	{
+		FLOG("UFlareGameTools::BenchmarkSimulation failed: invalid day count");
+		return;
+	}
+
+	// Load the save, without active sector
+	if (GetGame()->IsLoadedOrCreated())
+	{
+		GetGame()->UnloadGame();
+	}
+	GetGame()->SetCurrentSlot(SaveSlot);
+	if (!GetGame()->LoadGame(GetPC()))
+	{
+		FLOGV("UFlareGameTools::BenchmarkSimulation failed: could not load slot %d", SaveSlot);
+		return;
+	}
+	UFlareWorld* World = GetGameWorld();
+	int64 StartDate = World->GetDate();
+
+	// Simulate, with the same random draws for each run of a seed
+	FMath::RandInit(Seed);
+	FString Report = TEXT("Day,Battles,AI,NewDay,Factories,People,TradeRoutes,Travels,Reputation,Prices,ReserveShips,BattleChecks,Total,UsedPhysicalMB\n");
+	FFlareSimulationTimings Cumulated;
+	double StartTs = FPlatformTime::Seconds();
+
+	for (int32 DayIndex = 0; DayIndex < DayCount; DayIndex++)
+	{
+		int64 Date = World->GetDate();
+		World->Simulate();
+
+		const FFlareSimulationTimings& Timings = World->GetLastSimulationTimings();
+		Cumulated.Battles += Timings.Battles;
+		Cumulated.AI += Timings.AI;
+		Cumulated.NewDay += Timings.NewDay;
+		Cumulated.Factories += Timings.Factories;
+		Cumulated.People += Timings.People;
+		Cumulated.TradeRoutes += Timings.TradeRoutes;
+		Cumulated.Travels += Timings.Travels;
+		Cumulated.Reputation += Timings.Reputation;
+		Cumulated.Prices += Timings.Prices;
+		Cumulated.ReserveShips += Timings.ReserveShips;
+		Cumulated.BattleChecks += Timings.BattleChecks;
+		Cumulated.Total += Timings.Total;
+
+		FPlatformMemoryStats MemoryStats = FPlatformMemory::GetStats();
+		Report += FString::Printf(TEXT("%lld,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%llu\n"), Date,
+			Timings.Battles, Timings.AI, Timings.NewDay, Timings.Factories, Timings.People,
+			Timings.TradeRoutes, Timings.Travels, Timings.Reputation, Timings.Prices, Timings.ReserveShips,
+			Timings.BattleChecks, Timings.Total, (uint64)(MemoryStats.UsedPhysical / (1024 * 1024)));
+	}
+
+	double Duration = FPlatformTime::Seconds() - StartTs;
+	uint32 Checksum = World->GetWorldChecksum();
+	FMath::RandInit(FPlatformTime::Cycles());
+
+	// Summary
+	Report += FString::Printf(TEXT("Sum,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,%f,\n"),
+		Cumulated.Battles, Cumulated.AI, Cumulated.NewDay, Cumulated.Factories, Cumulated.People,
+		Cumulated.TradeRoutes, Cumulated.Travels, Cumulated.Reputation, Cumulated.Prices, Cumulated.ReserveShips,
+		Cumulated.BattleChecks, Cumulated.Total);
+	Report += FString::Printf(TEXT("Checksum,%08X\n"), Checksum);
+
+	FString FileName = FString::Printf(TEXT("%s/Benchmark/Simulation-Slot%d-%lld-%d-Seed%d.csv"), *FPaths::GameSavedDir(), SaveSlot, StartDate, DayCount, Seed);
+	if (!FFileHelper::SaveStringToFile(Report, *FileName))
+	{
+		FLOGV("UFlareGameTools::BenchmarkSimulation : failed to write '%s'", *FileName);
+	}
+
+	FLOGV("UFlareGameTools::BenchmarkSimulation : simulated %d days from slot %d with seed %d in %.3fs (%.3fs/day)",
+		DayCount, SaveSlot, Seed, Duration, Duration / DayCount);
+	FLOGV("UFlareGameTools::BenchmarkSimulation : battles %.3fs, AI %.3fs, new day %.3fs, factories %.3fs, people %.3fs",
+		Cumulated.Battles, Cumulated.AI, Cumulated.NewDay, Cumulated.Factories, Cumulated.People);
+	FLOGV("UFlareGameTools::BenchmarkSimulation : trade routes %.3fs, travels %.3fs, reputation %.3fs, prices %.3fs",
+		Cumulated.TradeRoutes, Cumulated.Travels, Cumulated.Reputation, Cumulated.Prices);
+	FLOGV("UFlareGameTools::BenchmarkSimulation : reserve ships %.3fs, battle checks %.3fs",
+		Cumulated.ReserveShips, Cumulated.BattleChecks);
+	FLOGV("UFlareGameTools::BenchmarkSimulation : world checksum %08X, report in '%s'", Checksum, *FileName);
+}
+
+void UFlareGameTools::CompareAIPlanning(int32 SaveSlot, int32 DayCount)
+{
+	if (!GetGame()->DoesSaveSlotExist(SaveSlot))
+	{
+		FLOGV("UFlareGameTools::CompareAIPlanning failed: no save in slot %d", SaveSlot);
+		return;
+	}
+
+	if (DayCount <= 0)
+	{
+		FLOG("UFlareGameTools::CompareAIPlanning failed: invalid day count");
+		return;
+	}
+
+	const int32 ModeCount = 2;
+	const TCHAR* ModeNames[ModeCount] = { TEXT("serial"), TEXT("parallel") };
+	uint32 Checksums[ModeCount] = { 0, 0 };
+	double Durations[ModeCount] = { 0, 0 };
+
+	for (int32 ModeIndex = 0; ModeIndex < ModeCount; ModeIndex++)
+	{
+		// Load the save, without active sector
+		if (GetGame()->IsLoadedOrCreated())
+		{
+			GetGame()->UnloadGame();
+		}
+		GetGame()->SetCurrentSlot(SaveSlot);
+		if (!GetGame()->LoadGame(GetPC()))
+		{
+			FLOGV("UFlareGameTools::CompareAIPlanning failed: could not load slot %d", SaveSlot);
+			FMath::RandInit(FPlatformTime::Cycles());
+			return;
+		}
+		UFlareWorld* World = GetGameWorld();
+		World->SetSerialAIPlanning(ModeIndex == 0);
+
+		// Same seed for both runs, only the planning threads differ
+		FMath::RandInit(1);
+
+		double StartTs = FPlatformTime::Seconds();
+		for (int32 DayIndex = 0; DayIndex < DayCount; DayIndex++)
+		{
+			World->Simulate();
+		}
+		Durations[ModeIndex] = FPlatformTime::Seconds() - StartTs;
+		Checksums[ModeIndex] = World->GetWorldChecksum();
+
+		World->SetSerialAIPlanning(false);
+	}
+
+	FMath::RandInit(FPlatformTime::Cycles());
+
+	for (int32 ModeIndex = 0; ModeIndex < ModeCount; ModeIndex++)
+	{
+		FLOGV("UFlareGameTools::CompareAIPlanning : %s planning, %d days in %.3fs, world checksum %08X",
+			ModeNames[ModeIndex], DayCount, Durations[ModeIndex], Checksums[ModeIndex]);
+	}
+
+	FLOGV("UFlareGameTools::CompareAIPlanning : %s", (Checksums[0] == Checksums[1] ? TEXT("checksums match") : TEXT("checksums differ")));
+}
+
+void UFlareGameTools::BenchmarkBattle(int32 SaveSlot, FName SectorIdentifier, int32 BattleCount)
+{
+	if (!GetGame()->DoesSaveSlotExist(SaveSlot))
+	{
+		FLOGV("UFlareGameTools::BenchmarkBattle failed: no save in slot %d", SaveSlot);
+		return;
+	}
+
+	if (BattleCount <= 0)
+	{
+		FLOG("UFlareGameTools::BenchmarkBattle failed: invalid battle count");
+		return;
+	}
+
+	// Load the save, without active sector
+	if (GetGame()->IsLoadedOrCreated())
+	{
+		GetGame()->UnloadGame();
+	}
+	GetGame()->SetCurrentSlot(SaveSlot);
+	if (!GetGame()->LoadGame(GetPC()))
+	{
+		FLOGV("UFlareGameTools::BenchmarkBattle failed: could not load slot %d", SaveSlot);
+		return;
+	}
+	UFlareWorld* World = GetGameWorld();
+	UFlareSpacecraftComponentsCatalog* Catalog = GetGame()->GetShipPartsCatalog();
+
+	UFlareSimulatedSector* Sector = World->FindSector(SectorIdentifier);
+	if (!Sector)
+	{
+		FLOGV("UFlareGameTools::BenchmarkBattle failed: no sector with id '%s'", *SectorIdentifier.ToString());
+		return;
+	}
+
+	UFlareBattle* Battle = NewObject<UFlareBattle>(World, UFlareBattle::StaticClass());
+	Battle->Load(Sector);
+	if (!Battle->HasBattle())
+	{
+		FLOGV("UFlareGameTools::BenchmarkBattle failed: no battle in '%s'", *Sector->GetSectorName().ToString());
+		return;
+	}
+
+	// Save the state that battles change, to restore it after each run
+	TArray<UFlareSimulatedSpacecraft*> Spacecrafts = Sector->GetSectorSpacecrafts();
+	TArray<FFlareSpacecraftSave> SpacecraftData;
+	TArray<UFlareCompany*> Companies;
+	for (UFlareSimulatedSpacecraft* Spacecraft : Spacecrafts)
+	{
+		SpacecraftData.Add(Spacecraft->GetData());
+		Companies.AddUnique(Spacecraft->GetCompany());
+	}
+
+	TArray<float> Reputations;
+	for (UFlareCompany* Company : World->GetCompanies())
+	{
+		for (UFlareCompany* OtherCompany : World->GetCompanies())
+		{
+			Reputations.Add(Company->GetReputation(OtherCompany));
+		}
+	}
+
+	// Alive, controllable and armed spacecraft counts per company, for each run and resolver
+	const int32 ResolverCount = 2;
+	const int32 MetricCount = 3;
+	const TCHAR* ResolverNames[ResolverCount] = { TEXT("Reference"), TEXT("Pooled") };
+	const TCHAR* MetricNames[MetricCount] = { TEXT("Alive"), TEXT("Controllable"), TEXT("Armed") };
+	TArray<float> MetricSums[ResolverCount];
+	TArray<float> MetricSquareSums[ResolverCount];
+	double Durations[ResolverCount] = { 0, 0 };
+	int32 TurnSums[ResolverCount] = { 0, 0 };
+
+	FString Report = TEXT("Resolver,Seed,Turns,Seconds");
+	for (UFlareCompany* Company : Companies)
+	{
+		for (int32 MetricIndex = 0; MetricIndex < MetricCount; MetricIndex++)
+		{
+			Report += FString::Printf(TEXT(",%s%s"), *Company->GetShortName().ToString(), MetricNames[MetricIndex]);
+		}
+	}
+	Report += TEXT("\n");
+
+	for (int32 ResolverIndex = 0; ResolverIndex < ResolverCount; ResolverIndex++)
+	{
+		MetricSums[ResolverIndex].SetNumZeroed(Companies.Num() * MetricCount);
+		MetricSquareSums[ResolverIndex].SetNumZeroed(Companies.Num() * MetricCount);
+
+		for (int32 BattleIndex = 0; BattleIndex < BattleCount; BattleIndex++)
+		{
+			int32 Seed = BattleIndex + 1;
+			FMath::RandInit(Seed);
+
+			// Resolve
+			Battle = NewObject<UFlareBattle>(World, UFlareBattle::StaticClass());
+			Battle->Load(Sector);
+			Battle->SetUseTargetPools(ResolverIndex == 1);
+			Battle->SetSilent(true);
+
+			double StartTs = FPlatformTime::Seconds();
+			Battle->Simulate();
+			double Duration = FPlatformTime::Seconds() - StartTs;
+
+			Durations[ResolverIndex] += Duration;
+			TurnSums[ResolverIndex] += Battle->GetTurnCount();
+			Report += FString::Printf(TEXT("%s,%d,%d,%f"), ResolverNames[ResolverIndex], Seed, Battle->GetTurnCount(), Duration);
+
+			// Record the outcome
+			TArray<int32> Metrics;
+			Metrics.SetNumZeroed(Companies.Num() * MetricCount);
+			for (UFlareSimulatedSpacecraft* Spacecraft : Spacecrafts)
+			{
+				UFlareSimulatedSpacecraftDamageSystem* DamageSystem = Spacecraft->GetDamageSystem();
+				int32 MetricOffset = Companies.IndexOfByKey(Spacecraft->GetCompany()) * MetricCount;
+
+				Metrics[MetricOffset] += (DamageSystem->IsAlive() ? 1 : 0);
+				Metrics[MetricOffset + 1] += (DamageSystem->IsAlive() && !DamageSystem->IsUncontrollable() ? 1 : 0);
+				Metrics[MetricOffset + 2] += (Spacecraft->IsMilitary() && !DamageSystem->IsDisarmed() ? 1 : 0);
+			}
+
+			for (int32 MetricIndex = 0; MetricIndex < Metrics.Num(); MetricIndex++)
+			{
+				MetricSums[ResolverIndex][MetricIndex] += Metrics[MetricIndex];
+				MetricSquareSums[ResolverIndex][MetricIndex] += FMath::Square(Metrics[MetricIndex]);
+				Report += FString::Printf(TEXT(",%d"), Metrics[MetricIndex]);
+			}
+			Report += TEXT("\n");
+
+			// Restore the sector
+			for (int32 SpacecraftIndex = 0; SpacecraftIndex < Spacecrafts.Num(); SpacecraftIndex++)
+			{
+				UFlareSimulatedSpacecraft* Spacecraft = Spacecrafts[SpacecraftIndex];
+				Spacecraft->GetData() = SpacecraftData[SpacecraftIndex];
+
+				for (FFlareSpacecraftComponentSave& Component : Spacecraft->GetData().Components)
+				{
+					Spacecraft->GetDamageSystem()->SetDamageDirty(Catalog->Get(Component.ComponentIdentifier));
+				}
+				Spacecraft->GetDamageSystem()->SetAmmoDirty();
+			}
+
+			int32 ReputationIndex = 0;
+			for (UFlareCompany* Company : World->GetCompanies())
+			{
+				for (UFlareCompany* OtherCompany : World->GetCompanies())
+				{
+					if (Company != OtherCompany)
+					{
+						Company->ForceReputation(OtherCompany, Reputations[ReputationIndex]);
+					}
+					ReputationIndex++;
+				}
+			}
+		}
+	}
+
+	FMath::RandInit(FPlatformTime::Cycles());
+
+	FString FileName = FString::Printf(TEXT("%s/Benchmark/Battle-Slot%d-%s-%d.csv"), *FPaths::GameSavedDir(), SaveSlot, *SectorIdentifier.ToString(), BattleCount);
+	if (!FFileHelper::SaveStringToFile(Report, *FileName))
+	{
+		FLOGV("UFlareGameTools::BenchmarkBattle : failed to write '%s'", *FileName);
+	}
+
+	// Summary, with the difference of means in standard errors
+	for (int32 ResolverIndex = 0; ResolverIndex < ResolverCount; ResolverIndex++)
+	{
+		FLOGV("UFlareGameTools::BenchmarkBattle : %s resolver, %d battles in %.3fs (%.3fms/battle, %.1f turns/battle)",
+			ResolverNames[ResolverIndex], BattleCount, Durations[ResolverIndex],
+			1000 * Durations[ResolverIndex] / BattleCount, (float) TurnSums[ResolverIndex] / BattleCount);
+	}
+
+	for (int32 CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
+	{
+		for (int32 MetricIndex = 0; MetricIndex < MetricCount; MetricIndex++)
+		{
+			int32 Index = CompanyIndex * MetricCount + MetricIndex;
+			float Means[ResolverCount];
+			float Variances[ResolverCount];
+
+			for (int32 ResolverIndex = 0; ResolverIndex < ResolverCount; ResolverIndex++)
+			{
+				Means[ResolverIndex] = MetricSums[ResolverIndex][Index] / BattleCount;
+				Variances[ResolverIndex] = FMath::Max(0.f, MetricSquareSums[ResolverIndex][Index] / BattleCount - FMath::Square(Means[ResolverIndex]));
+			}
+
+			float StandardError = FMath::Sqrt((Variances[0] + Variances[1]) / BattleCount);
+			float Deviation = (StandardError > 0 ? (Means[1] - Means[0]) / StandardError : 0);
+
+			FLOGV("UFlareGameTools::BenchmarkBattle : %s %s, reference %.2f (sd %.2f), pooled %.2f (sd %.2f), deviation %.2f",
+				*Companies[CompanyIndex]->GetShortName().ToString(), MetricNames[MetricIndex],
+				Means[0], FMath::Sqrt(Variances[0]), Means[1], FMath::Sqrt(Variances[1]), Deviation);
+		}
+	}
+
+	FLOGV("UFlareGameTools::BenchmarkBattle : report in '%s'", *FileName);
+}
+
+void UFlareGameTools::ComparePriceVariation(int32 SaveSlot)
+{
+	if (!GetGame()->DoesSaveSlotExist(SaveSlot))
+	{
+		FLOGV("UFlareGameTools::ComparePriceVariation failed: no save in slot %d", SaveSlot);
+		return;
+	}
+
+	// Load the save, without active sector
+	if (GetGame()->IsLoadedOrCreated())
+	{
+		GetGame()->UnloadGame();
+	}
+	GetGame()->SetCurrentSlot(SaveSlot);
+	if (!GetGame()->LoadGame(GetPC()))
+	{
+		FLOGV("UFlareGameTools::ComparePriceVariation failed: could not load slot %d", SaveSlot);
+		return;
+	}
+	UFlareWorld* World = GetGameWorld();
+	TArray<UFlareResourceCatalogEntry*>& Resources = GetGame()->GetResourceCatalog()->Resources;
+
+	float MaxDifference = 0;
+	int32 DifferenceCount = 0;
+	UFlareSimulatedSector* MaxDifferenceSector = NULL;
+	FFlareResourceDescription* MaxDifferenceResource = NULL;
+
+	for (UFlareSimulatedSector* Sector : World->GetSectors())
+	{
+		TArray<float> OriginalPrices;
+		TArray<float> PassPrices;
+		for (UFlareResourceCatalogEntry* Resource : Resources)
+		{
+			OriginalPrices.Add(Sector->GetPreciseResourcePrice(&Resource->Data));
+		}
+
+		// Single pass, then restore the prices and run the reference
+		for (int32 PassIndex = 0; PassIndex < 2; PassIndex++)
+		{
+			Sector->SetUseReferencePriceVariation(PassIndex == 1);
+			Sector->SimulatePriceVariation();
+
+			for (int32 ResourceIndex = 0; ResourceIndex < Resources.Num(); ResourceIndex++)
+			{
+				FFlareResourceDescription* Resource = &Resources[ResourceIndex]->Data;
+				float Price = Sector->GetPreciseResourcePrice(Resource);
+
+				if (PassIndex == 0)
+				{
+					PassPrices.Add(Price);
+				}
+				else
+				{
+					float Difference = FMath::Abs(Price - PassPrices[ResourceIndex]);
+					if (Difference > 0)
+					{
+						DifferenceCount++;
+					}
+					if (Difference > MaxDifference)
+					{
+						MaxDifference = Difference;
+						MaxDifferenceSector = Sector;
+						MaxDifferenceResource = Resource;
+					}
+				}
+
+				Sector->SetPreciseResourcePrice(Resource, OriginalPrices[ResourceIndex]);
+			}
+		}
+
+		Sector->SetUseReferencePriceVariation(false);
+	}
+
+	FLOGV("UFlareGameTools::ComparePriceVariation : %d sectors, %d resources, %d different prices",
+		World->GetSectors().Num(), Resources.Num(), DifferenceCount);
+	if (MaxDifferenceSector)
+	{
+		FLOGV("UFlareGameTools::ComparePriceVariation : largest difference %f for %s in %s",
+			MaxDifference, *MaxDifferenceResource->Name.ToString(), *MaxDifferenceSector->GetSectorName().ToString());
+	}
+}
+
+void UFlareGameTools::ConvertSaveSlot(int32 SaveSlot, bool Binary)
+{
+	FString SaveFile = "SaveSlot" + FString::FromInt(SaveSlot);
+
+	if (!GetGame()->GetSaveGameSystem()->DoesSaveGameExist(SaveFile))
+	{
+		FLOGV("UFlareGameTools::ConvertSaveSlot failed: no save in slot %d", SaveSlot);
+		return;
+	}
+
+	if (GetGame()->GetSaveGameSystem()->ConvertGame(SaveFile, Binary))
+	{
+		FLOGV("UFlareGameTools::ConvertSaveSlot : slot %d converted to %s", SaveSlot, Binary ? TEXT("binary") : TEXT("JSON"));
+	}
+	else
+	{
+		FLOGV("UFlareGameTools::ConvertSaveSlot failed: could not convert slot %d", SaveSlot);
+	}
 }
 
 /*----------------------------------------------------
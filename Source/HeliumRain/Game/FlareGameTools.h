@@ -65,8 +65,25 @@ public:
 	UFUNCTION(exec)
 	void RevealMap();
 
+	/** Load a save slot, simulate some days without active sector from a random seed and write a timing report. Unsaved progress is lost. */
 	UFUNCTION(exec)
-	void SetFastFastForward(bool FFF);
+	void BenchmarkSimulation(int32 SaveSlot, int32 DayCount, int32 Seed);
+
+	/** Load a save slot twice, simulate some days with serial then parallel AI planning and compare the world checksums. Unsaved progress is lost. */
+	UFUNCTION(exec)
+	void CompareAIPlanning(int32 SaveSlot, int32 DayCount);
+
+	/** Load a save slot, resolve the battle of a sector several times with both battle resolvers and write an outcome report. Unsaved progress is lost. */
+	UFUNCTION(exec)
+	void BenchmarkBattle(int32 SaveSlot, FName SectorIdentifier, int32 BattleCount);
+
+	/** Load a save slot, move the prices of every sector with the single pass and the per-resource reference, and report the largest difference. Unsaved progress is lost. */
+	UFUNCTION(exec)
+	void ComparePriceVariation(int32 SaveSlot);
+
+	/** Convert a save slot to the binary or JSON format */
+	UFUNCTION(exec)
+	void ConvertSaveSlot(int32 SaveSlot, bool Binary);
 
 	/*----------------------------------------------------
 		Company tools
@@ -280,6 +297,4 @@ public:
 
 	UFlareSector* GetActiveSector() const;
 
-	static bool FastFastForward;
-
 };
@@ -65,18 +65,32 @@ const FSlateBrush* UFlareGameTypes::GetCombatGroupIcon(EFlareCombatGroup::Type T
 }
 
 /*----------------------------------------------------
-	Float buffer
+	Time series
 ----------------------------------------------------*/
 
-void FFlareFloatBuffer::Init(int32 Size)
+FFlareTimeSeries::FFlareTimeSeries()
+	: MaxSize(0)
+	, WriteIndex(0)
+	, SumsValid(false)
+{
+}
+
+void FFlareTimeSeries::Init(int32 Size)
 {
 	MaxSize = Size;
 	Values.Empty(MaxSize);
 	WriteIndex = 0;
+
+	SumsValid = false;
 }
 
-void FFlareFloatBuffer::Resize(int32 Size)
+void FFlareTimeSeries::Resize(int32 Size)
 {
+	if (Size == MaxSize && Values.Num() <= MaxSize)
+	{
+		return;
+	}
+
 	if(Size <= Values.Num())
 	{
 		TArray<float> NewValues;
@@ -90,18 +104,29 @@ void FFlareFloatBuffer::Resize(int32 Size)
 	}
 
 	MaxSize = Size;
+	SumsValid = false;
 }
 
-void FFlareFloatBuffer::Append(float NewValue)
+void FFlareTimeSeries::Append(float NewValue)
 {
+	UpdateSums();
+
+	double Sum = NewValue;
+	if (Values.Num() > 0)
+	{
+		Sum += Sums[GetReadIndex(0)];
+	}
+
 	if(Values.Num() <= WriteIndex)
 	{
 		Values.Add(NewValue);
+		Sums.Add(Sum);
 		WriteIndex = Values.Num();
 	}
 	else
 	{
 		Values[WriteIndex] = NewValue;
+		Sums[WriteIndex] = Sum;
 		WriteIndex++;
 	}
 
@@ -111,13 +136,35 @@ void FFlareFloatBuffer::Append(float NewValue)
 	}
 }
 
-float FFlareFloatBuffer::GetValue(int32 Age)
+float FFlareTimeSeries::GetValue(int32 Age) const
 {
 	if(Values.Num() == 0)
 	{
 		return 0.f;
 	}
 
+	return Values[GetReadIndex(Age)];
+}
+
+float FFlareTimeSeries::GetMean(int32 StartAge, int32 EndAge)
+{
+	if (!ClampAges(StartAge, EndAge))
+	{
+		return 0.f;
+	}
+
+	UpdateSums();
+
+	// The running sum of the oldest value includes it
+	int32 NewestIndex = GetReadIndex(StartAge);
+	int32 OldestIndex = GetReadIndex(EndAge);
+	double Sum = Sums[NewestIndex] - Sums[OldestIndex] + Values[OldestIndex];
+
+	return Sum / (EndAge - StartAge + 1);
+}
+
+int32 FFlareTimeSeries::GetReadIndex(int32 Age) const
+{
 	if(Age >= Values.Num())
 	{
 		Age = Values.Num() - 1;
@@ -129,35 +176,40 @@ float FFlareFloatBuffer::GetValue(int32 Age)
 		ReadIndex += Values.Num();
 	}
 
-	return Values[ReadIndex];
+	return ReadIndex;
 }
 
-float FFlareFloatBuffer::GetMean(int32 StartAge, int32 EndAge)
+void FFlareTimeSeries::UpdateSums()
 {
-	float Count = 0.f;
-	float Sum = 0.f;
-
-	if(StartAge >= Values.Num())
+	if (SumsValid && Sums.Num() == Values.Num())
 	{
-		StartAge = Values.Num() - 1;
+		return;
 	}
 
-	if(EndAge >= Values.Num())
-	{
-		EndAge = Values.Num() - 1;
-	}
+	double Sum = 0;
+	Sums.SetNumUninitialized(Values.Num());
 
-	for (int Age = StartAge; Age <= EndAge; Age++)
+	for (int32 Age = Values.Num() - 1; Age >= 0; Age--)
 	{
-		Sum += GetValue(Age);
-		Count += 1.f;
+		int32 ReadIndex = GetReadIndex(Age);
+		Sum += Values[ReadIndex];
+		Sums[ReadIndex] = Sum;
 	}
 
-	if(Count == 0.f)
+	SumsValid = true;
+}
+
+bool FFlareTimeSeries::ClampAges(int32& StartAge, int32& EndAge) const
+{
+	if (Values.Num() == 0)
 	{
-		return 0.f;
+		return false;
 	}
-	return Sum/Count;
+
+	StartAge = FMath::Clamp(StartAge, 0, Values.Num() - 1);
+	EndAge = FMath::Clamp(EndAge, 0, Values.Num() - 1);
+
+	return (StartAge <= EndAge);
 }
 
 bool FFlareBundle::HasFloat(FName Key) const
@@ -341,12 +341,14 @@ struct FFlareCompanySave
 	int32 ResearchSpent;
 };
 
-/** Game save data */
+/** Daily values of a statistic, in a ring buffer with running sums */
 USTRUCT()
-struct FFlareFloatBuffer
+struct FFlareTimeSeries
 {
 	GENERATED_USTRUCT_BODY()
 
+	FFlareTimeSeries();
+
 	UPROPERTY(EditAnywhere, Category = Save)
 	int32 MaxSize;
 
@@ -363,9 +365,24 @@ struct FFlareFloatBuffer
 
 	void Append(float NewValue);
 
-	float GetValue(int32 Age);
+	float GetValue(int32 Age) const;
 
+	/** Get the mean of the values between two ages, included */
 	float GetMean(int32 StartAge, int32 EndAge);
+
+protected:
+
+	int32 GetReadIndex(int32 Age) const;
+
+	/** Compute the running sums if the values were changed from outside */
+	void UpdateSums();
+
+	/** Clamp an age range to the stored values. Return false if the range is empty */
+	bool ClampAges(int32& StartAge, int32& EndAge) const;
+
+	// Sum of all values appended up to each value, in the same ring as the values
+	TArray<double> Sums;
+	bool SumsValid;
 };
 
 
@@ -27,6 +27,7 @@ void UFlareGameUserSettings::SetToDefaults()
 	UseCockpit = true;
 	UseAnticollision = false;
 	PauseGameInMenus = false;
+	UseBinarySaves = false;
 	MaxShipsInSector = 20;
 
 	// Sound
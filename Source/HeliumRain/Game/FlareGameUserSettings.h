@@ -54,6 +54,10 @@ public:
 	UPROPERTY(Config)
 	bool                                     PauseGameInMenus;
 
+	/** Whether to write saves in the compact binary format */
+	UPROPERTY(Config)
+	bool                                     UseBinarySaves;
+
 	/** Max ship count in a sector */
 	UPROPERTY(Config)
 	int32                                    MaxShipsInSector;
@@ -0,0 +1,82 @@
+
+#include "../Flare.h"
+#include "FlarePilotScheduler.h"
+#include "../Spacecrafts/FlareSpacecraft.h"
+
+const float FFlarePilotScheduler::NearDistance = 500000; // 5km
+const float FFlarePilotScheduler::FarDistance = 2000000; // 20km
+
+const float FFlarePilotScheduler::CombatTickInterval = 0.05;
+const float FFlarePilotScheduler::MidTickInterval = 0.1;
+const float FFlarePilotScheduler::FarTickInterval = 0.25;
+const float FFlarePilotScheduler::DockedTickInterval = 1.0;
+
+const double FFlarePilotScheduler::RetargetBudget = 0.001; // 1ms
+const float FFlarePilotScheduler::MaxRetargetDelay = 1.0;
+
+
+/*----------------------------------------------------
+	Frame
+----------------------------------------------------*/
+
+FFlarePilotScheduler::FFlarePilotScheduler()
+{
+	Reset();
+}
+
+void FFlarePilotScheduler::Reset()
+{
+	PlayerLocation = FVector::ZeroVector;
+	HasPlayerShip = false;
+	RetargetTime = 0;
+}
+
+void FFlarePilotScheduler::BeginFrame(AFlareSpacecraft* PlayerShip)
+{
+	HasPlayerShip = (PlayerShip != NULL);
+	PlayerLocation = (PlayerShip ? PlayerShip->GetActorLocation() : FVector::ZeroVector);
+	RetargetTime = 0;
+}
+
+
+/*----------------------------------------------------
+	Scheduling
+----------------------------------------------------*/
+
+float FFlarePilotScheduler::GetPilotTickInterval(AFlareSpacecraft* Ship, bool InCombat) const
+{
+	// Docked ships only wait to undock
+	if (Ship->GetNavigationSystem()->IsDocked())
+	{
+		return DockedTickInterval;
+	}
+
+	// Without a player ship, there is nothing to prioritize
+	if (!HasPlayerShip)
+	{
+		return 0;
+	}
+
+	float DistanceSquared = FVector::DistSquared(Ship->GetActorLocation(), PlayerLocation);
+	if (DistanceSquared < FMath::Square(NearDistance))
+	{
+		return 0;
+	}
+	else if (InCombat)
+	{
+		return CombatTickInterval;
+	}
+	else if (DistanceSquared < FMath::Square(FarDistance))
+	{
+		return MidTickInterval;
+	}
+	else
+	{
+		return FarTickInterval;
+	}
+}
+
+bool FFlarePilotScheduler::CanRetarget(float TimeSinceAllowed) const
+{
+	return (RetargetTime < RetargetBudget || TimeSinceAllowed >= MaxRetargetDelay);
+}
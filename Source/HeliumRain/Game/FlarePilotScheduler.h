@@ -0,0 +1,73 @@
+#pragma once
+
+#include "../Flare.h"
+
+class AFlareSpacecraft;
+
+
+/** Decides how often the AI pilots of the active sector think, and shares a per-frame time budget for re-targeting.
+ *  Pilots that are skipped keep their previous controls, which the navigation system still applies every frame. */
+class FFlarePilotScheduler
+{
+public:
+
+	FFlarePilotScheduler();
+
+	/*----------------------------------------------------
+		Frame
+	----------------------------------------------------*/
+
+	void Reset();
+
+	/** Start a new frame around the player ship, which may be NULL */
+	void BeginFrame(AFlareSpacecraft* PlayerShip);
+
+
+	/*----------------------------------------------------
+		Scheduling
+	----------------------------------------------------*/
+
+	/** Get the minimum time between two ticks of the pilot of Ship */
+	float GetPilotTickInterval(AFlareSpacecraft* Ship, bool InCombat) const;
+
+	/** Check if a pilot can look for a new target this frame. Pilots that waited too long always can. */
+	bool CanRetarget(float TimeSinceAllowed) const;
+
+	/** Record the time spent looking for a target */
+	void AddRetargetTime(double Seconds)
+	{
+		RetargetTime += Seconds;
+	}
+
+
+protected:
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
+	FVector                              PlayerLocation;
+	bool                                 HasPlayerShip;
+	double                               RetargetTime;
+
+
+public:
+
+	/** Ships closer than this to the player think every frame, in cm */
+	static const float NearDistance;
+
+	/** Ships farther than this from the player think the least often, in cm */
+	static const float FarDistance;
+
+	static const float CombatTickInterval;
+	static const float MidTickInterval;
+	static const float FarTickInterval;
+	static const float DockedTickInterval;
+
+	/** Time allowed for re-targeting in each frame, in seconds */
+	static const double RetargetBudget;
+
+	/** Longest time a pilot can be denied re-targeting, in seconds */
+	static const float MaxRetargetDelay;
+
+};
@@ -110,6 +110,41 @@ struct FFlarePlayerSave
 	int32 PlayerEmblemIndex;
 };
 
+/** Save slot summary, stored next to the save so that menus don't have to load it */
+USTRUCT()
+struct FFlareSaveSummary
+{
+	GENERATED_USTRUCT_BODY()
+
+	/** Unique identifier of the game */
+	UPROPERTY(EditAnywhere, Category = Save)
+	FName UUID;
+
+	/** Emblem index */
+	UPROPERTY(EditAnywhere, Category = Save)
+	int32 PlayerEmblemIndex;
+
+	/** Player company name and colors */
+	UPROPERTY(EditAnywhere, Category = Save)
+	FFlareCompanyDescription PlayerCompanyDescription;
+
+	/** Player ship count */
+	UPROPERTY(EditAnywhere, Category = Save)
+	int32 CompanyShipCount;
+
+	/** Player company value */
+	UPROPERTY(EditAnywhere, Category = Save)
+	int64 CompanyValue;
+
+	/** Size of the save file this summary was written for */
+	UPROPERTY(EditAnywhere, Category = Save)
+	int64 SaveSize;
+
+	/** Modification time of the save file this summary was written for, in ticks */
+	UPROPERTY(EditAnywhere, Category = Save)
+	int64 SaveTimestamp;
+};
+
 
 UCLASS()
 class UFlareSaveGame : public USaveGame
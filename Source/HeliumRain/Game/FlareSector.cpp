@@ -3,7 +3,7 @@
 #include "FlareSimulatedSector.h"
 #include "FlareSector.h"
 #include "FlareCollider.h"
-#include "../Spacecrafts/FlareShell.h"
+#include "../Spacecrafts/FlareShellManager.h"
 #include "../Spacecrafts/FlareSpacecraft.h"
 #include "../Player/FlarePlayerController.h"
 
@@ -17,6 +17,11 @@ UFlareSector::UFlareSector(const FObjectInitializer& ObjectInitializer)
 {
 	SectorRepartitionCache = false;
 	IsDestroyingSector = false;
+	ShellManager = NULL;
+	SpatialIndexFrame = 0;
+	SpatialIndexDirty = true;
+	PilotSchedulerFrame = 0;
+	ThreatTableFrame = 0;
 }
 
 /*----------------------------------------------------
@@ -29,6 +34,16 @@ void UFlareSector::Load(UFlareSimulatedSector* Parent)
 	ParentSector = Parent;
 	LocalTime = Parent->GetData()->LocalTime;
 
+	// Create the shell manager
+	FActorSpawnParameters ShellManagerSpawnParams;
+	ShellManagerSpawnParams.bNoFail = true;
+	ShellManagerSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	ShellManager = GetGame()->GetWorld()->SpawnActor<AFlareShellManager>(AFlareShellManager::StaticClass(), FVector::ZeroVector, FRotator::ZeroRotator, ShellManagerSpawnParams);
+	ShellManager->Initialize(this);
+
+	// Load colliders
+	LoadColliders();
+
 	// Load asteroids
 	for (int i = 0 ; i < ParentSector->GetData()->AsteroidData.Num(); i++)
 	{
@@ -107,9 +122,10 @@ void UFlareSector::DestroySector()
 		SectorAsteroids[AsteroidIndex]->Destroy();
 	}
 
-	for (int ShellIndex = 0 ; ShellIndex < SectorShells.Num(); ShellIndex++)
+	if (ShellManager)
 	{
-		SectorShells[ShellIndex]->Destroy();
+		ShellManager->Destroy();
+		ShellManager = NULL;
 	}
 
 	SectorSpacecrafts.Empty();
@@ -117,7 +133,14 @@ void UFlareSector::DestroySector()
 	SectorStations.Empty();
 	SectorBombs.Empty();
 	SectorAsteroids.Empty();
-	SectorShells.Empty();
+	SectorColliders.Empty();
+	SectorColliderSizes.Empty();
+	SpatialIndex.Reset();
+	SpatialIndexDirty = true;
+	PilotScheduler.Reset();
+	PilotSchedulerFrame = 0;
+	ThreatTable.Reset();
+	ThreatTableFrame = 0;
 
 	IsDestroyingSector = false;
 }
@@ -127,6 +150,24 @@ void UFlareSector::DestroySector()
 	Gameplay
 ----------------------------------------------------*/
 
+void UFlareSector::LoadColliders()
+{
+	SectorColliders.Empty();
+	SectorColliderSizes.Empty();
+
+	TArray<AActor*> ColliderActorList;
+	UGameplayStatics::GetAllActorsOfClass(GetGame()->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
+	for (int32 ColliderIndex = 0; ColliderIndex < ColliderActorList.Num(); ColliderIndex++)
+	{
+		AFlareCollider* Collider = Cast<AFlareCollider>(ColliderActorList[ColliderIndex]);
+		SectorColliders.Add(Collider);
+		SectorColliderSizes.Add(Cast<UStaticMeshComponent>(Collider->GetRootComponent())->Bounds.SphereRadius);
+	}
+
+	FLOGV("UFlareSector::LoadColliders : %d colliders", SectorColliders.Num());
+	InvalidateSpatialIndex();
+}
+
 AFlareAsteroid* UFlareSector::LoadAsteroid(const FFlareAsteroidSave& AsteroidData)
 {
     FActorSpawnParameters Params;
@@ -138,6 +179,7 @@ AFlareAsteroid* UFlareSector::LoadAsteroid(const FFlareAsteroidSave& AsteroidDat
 
 	// TODO Check double add
 	SectorAsteroids.Add(Asteroid);
+	InvalidateSpatialIndex();
     return Asteroid;
 }
 
@@ -178,6 +220,7 @@ AFlareSpacecraft* UFlareSector::LoadSpacecraft(UFlareSimulatedSpacecraft* Parent
 			SectorShips.Add(Spacecraft);
 		}
 		SectorSpacecrafts.Add(Spacecraft);
+		InvalidateSpatialIndex();
 
 		switch (ParentSpacecraft->GetData().SpawnMode)
 		{
@@ -408,19 +451,6 @@ void UFlareSector::UnregisterBomb(AFlareBomb* Bomb)
 	}
 }
 
-void UFlareSector::RegisterShell(AFlareShell* Shell)
-{
-	SectorShells.AddUnique(Shell);
-}
-
-void UFlareSector::UnregisterShell(AFlareShell* Shell)
-{
-	if (!IsDestroyingSector)
-	{
-		SectorShells.Remove(Shell);
-	}
-}
-
 void UFlareSector::SetPause(bool Pause)
 {
 	for (int i = 0 ; i < SectorSpacecrafts.Num(); i++)
@@ -438,62 +468,25 @@ void UFlareSector::SetPause(bool Pause)
 		SectorAsteroids[i]->SetPause(Pause);
 	}
 
-	for (int i = 0 ; i < SectorShells.Num(); i++)
+	if (ShellManager)
 	{
-		SectorShells[i]->SetPause(Pause);
+		ShellManager->SetPause(Pause);
 	}
 }
 
 
 AActor* UFlareSector::GetNearestBody(FVector Location, float* NearestDistance, bool IncludeSize, AActor* ActorToIgnore)
 {
-	AActor* NearestCandidateActor = NULL;
-	float NearestCandidateActorDistance = 0;
-
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < SectorSpacecrafts.Num(); SpacecraftIndex++)
-	{
-		AFlareSpacecraft* SpacecraftCandidate = GetSpacecrafts()[SpacecraftIndex];
-		float Distance = FVector::Dist(SpacecraftCandidate->GetActorLocation(), Location) - SpacecraftCandidate->GetMeshScale();
-		if (SpacecraftCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
-		{
-			NearestCandidateActor = SpacecraftCandidate;
-			NearestCandidateActorDistance = Distance;
-		}
-	}
-
-	for (int32 AsteroidIndex = 0; AsteroidIndex < GetAsteroids().Num(); AsteroidIndex++)
-	{
-		AFlareAsteroid* AsteroidCandidate = GetAsteroids()[AsteroidIndex];
-
-		FBox CandidateBox = AsteroidCandidate->GetComponentsBoundingBox();
-		float CandidateSize = FMath::Max(CandidateBox.GetExtent().Size(), 1.0f);
-
-		float Distance = FVector::Dist(AsteroidCandidate->GetActorLocation(), Location) - CandidateSize;
-		if (AsteroidCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
-		{
-			NearestCandidateActor = AsteroidCandidate;
-			NearestCandidateActorDistance = Distance;
-		}
-	}
-
-	TArray<AActor*> ColliderActorList;
-	UGameplayStatics::GetAllActorsOfClass(GetGame()->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
-	for (int32 ColliderIndex = 0; ColliderIndex < ColliderActorList.Num(); ColliderIndex++)
+	auto IsNotIgnored = [=](const FFlareSpatialIndexEntry& Entry)
 	{
-		AActor* ColliderCandidate = ColliderActorList[ColliderIndex];
+		return Entry.Actor != ActorToIgnore;
+	};
 
-		float CandidateSize = Cast<UStaticMeshComponent>(ColliderCandidate->GetRootComponent())->Bounds.SphereRadius;
-
-		float Distance = FVector::Dist(ColliderCandidate->GetActorLocation(), Location) - CandidateSize;
-		if (ColliderCandidate != ActorToIgnore && (!NearestCandidateActor || NearestCandidateActorDistance > Distance))
-		{
-			NearestCandidateActor = ColliderCandidate;
-			NearestCandidateActorDistance = Distance;
-		}
-	}
+	float NearestCandidateActorDistance = 0;
+	const FFlareSpatialIndexEntry* NearestEntry = GetSpatialIndex().GetNearest(Location, EFlareSpatialBody::All, IncludeSize, IsNotIgnored, &NearestCandidateActorDistance);
 
 	*NearestDistance = NearestCandidateActorDistance;
-	return NearestCandidateActor;
+	return NearestEntry ? NearestEntry->Actor : NULL;
 }
 
 void UFlareSector::PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Location)
@@ -522,13 +515,11 @@ void UFlareSector::PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Locatio
 
 #if !UE_BUILD_SHIPPING
 	{
-		TArray<AActor*> ColliderActorList;
-		UGameplayStatics::GetAllActorsOfClass(GetGame()->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
-		for (int32 ColliderIndex = 0; ColliderIndex < ColliderActorList.Num(); ColliderIndex++)
+		for (int32 ColliderIndex = 0; ColliderIndex < SectorColliders.Num(); ColliderIndex++)
 		{
-			AActor* ColliderCandidate = ColliderActorList[ColliderIndex];
+			AFlareCollider* ColliderCandidate = SectorColliders[ColliderIndex];
 
-			float CandidateSize = Cast<UStaticMeshComponent>(ColliderCandidate->GetRootComponent())->Bounds.SphereRadius;
+			float CandidateSize = SectorColliderSizes[ColliderIndex];
 			float SpacecraftSize = Spacecraft->GetSimpleCollisionRadius();
 			float Distance = FVector::Dist(ColliderCandidate->GetActorLocation(), Location);
 			
@@ -541,6 +532,68 @@ void UFlareSector::PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Locatio
 #endif
 
 	Spacecraft->SetActorLocation(Location);
+	InvalidateSpatialIndex();
+}
+
+FFlareSpatialIndex& UFlareSector::GetSpatialIndex()
+{
+	float Time = GetGame()->GetWorld()->GetTimeSeconds();
+
+	if (SpatialIndexDirty || SpatialIndexFrame != GFrameCounter)
+	{
+		SpatialIndex.Reset();
+
+		for (int32 SpacecraftIndex = 0; SpacecraftIndex < SectorSpacecrafts.Num(); SpacecraftIndex++)
+		{
+			AFlareSpacecraft* Spacecraft = SectorSpacecrafts[SpacecraftIndex];
+			SpatialIndex.Add(Spacecraft, Spacecraft, Spacecraft->Airframe->GetPhysicsLinearVelocity(), Spacecraft->GetMeshScale(), EFlareSpatialBody::Spacecraft);
+		}
+
+		for (int32 AsteroidIndex = 0; AsteroidIndex < SectorAsteroids.Num(); AsteroidIndex++)
+		{
+			AFlareAsteroid* Asteroid = SectorAsteroids[AsteroidIndex];
+			FBox AsteroidBox = Asteroid->GetComponentsBoundingBox();
+			float AsteroidSize = FMath::Max(AsteroidBox.GetExtent().Size(), 1.0f);
+			SpatialIndex.Add(Asteroid, NULL, Asteroid->GetAsteroidComponent()->GetPhysicsLinearVelocity(), AsteroidSize, EFlareSpatialBody::Asteroid);
+		}
+
+		for (int32 ColliderIndex = 0; ColliderIndex < SectorColliders.Num(); ColliderIndex++)
+		{
+			SpatialIndex.Add(SectorColliders[ColliderIndex], NULL, FVector::ZeroVector, SectorColliderSizes[ColliderIndex], EFlareSpatialBody::Collider);
+		}
+
+		SpatialIndex.Build(Time);
+		SpatialIndexFrame = GFrameCounter;
+		SpatialIndexDirty = false;
+	}
+	else
+	{
+		SpatialIndex.SetTime(Time);
+	}
+
+	return SpatialIndex;
+}
+
+FFlarePilotScheduler& UFlareSector::GetPilotScheduler()
+{
+	if (PilotSchedulerFrame != GFrameCounter)
+	{
+		PilotScheduler.BeginFrame(GetGame()->GetPC()->GetShipPawn());
+		PilotSchedulerFrame = GFrameCounter;
+	}
+
+	return PilotScheduler;
+}
+
+FFlareThreatTable& UFlareSector::GetThreatTable()
+{
+	if (ThreatTableFrame != GFrameCounter)
+	{
+		ThreatTable.Build(this);
+		ThreatTableFrame = GFrameCounter;
+	}
+
+	return ThreatTable;
 }
 
 /*----------------------------------------------------
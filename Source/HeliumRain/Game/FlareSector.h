@@ -5,11 +5,16 @@
 #include "../Spacecrafts/FlareBomb.h"
 #include "FlareAsteroid.h"
 #include "FlareSimulatedSector.h"
+#include "FlareSpatialIndex.h"
+#include "FlarePilotScheduler.h"
+#include "FlareThreatTable.h"
 #include "FlareSector.generated.h"
 
 class UFlareSimulatedSector;
 class AFlareGame;
 class AFlareAsteroid;
+class AFlareShellManager;
+class AFlareCollider;
 
 UCLASS()
 class HELIUMRAIN_API UFlareSector : public UObject
@@ -42,20 +47,34 @@ public:
 
 	AFlareBomb* LoadBomb(const FFlareBombSave& BombData);
 
+	/** Register the colliders of the sector level, once it is loaded */
+	void LoadColliders();
+
 	void RegisterBomb(AFlareBomb* Bomb);
 
 	void UnregisterBomb(AFlareBomb* Bomb);
 
-	void RegisterShell(AFlareShell* Shell);
-
-	void UnregisterShell(AFlareShell* Shell);
-
 	virtual void SetPause(bool Pause);
 
 	AActor* GetNearestBody(FVector Location, float* NearestDistance, bool IncludeSize = true, AActor* ActorToIgnore = NULL);
 
 	void PlaceSpacecraft(AFlareSpacecraft* Spacecraft, FVector Location);
 
+	/** Get the spatial index of spacecrafts, asteroids and colliders, rebuilt once per frame */
+	FFlareSpatialIndex& GetSpatialIndex();
+
+	/** Rebuild the spatial index on the next query, after bodies were added or moved */
+	void InvalidateSpatialIndex()
+	{
+		SpatialIndexDirty = true;
+	}
+
+	/** Get the AI pilot scheduler, updated once per frame */
+	FFlarePilotScheduler& GetPilotScheduler();
+
+	/** Get the potential targets of the sector, rebuilt once per frame */
+	FFlareThreatTable& GetThreatTable();
+
 protected:
 
 	/*----------------------------------------------------
@@ -78,7 +97,10 @@ protected:
 	UPROPERTY()
 	TArray<AFlareBomb*>            SectorBombs;
 	UPROPERTY()
-	TArray<AFlareShell*>           SectorShells;
+	AFlareShellManager*            ShellManager;
+	UPROPERTY()
+	TArray<AFlareCollider*>        SectorColliders;
+	TArray<float>                  SectorColliderSizes;
 
 	int64						   LocalTime;
 	bool						   SectorRepartitionCache;
@@ -86,6 +108,16 @@ protected:
 	FVector                        SectorCenter;
 	float                          SectorRadius;
 
+	FFlareSpatialIndex             SpatialIndex;
+	uint64                         SpatialIndexFrame;
+	bool                           SpatialIndexDirty;
+
+	FFlarePilotScheduler           PilotScheduler;
+	uint64                         PilotSchedulerFrame;
+
+	FFlareThreatTable              ThreatTable;
+	uint64                         ThreatTableFrame;
+
 
 public:
 
@@ -149,6 +181,11 @@ public:
 		return SectorBombs;
 	}
 
+	inline AFlareShellManager* GetShellManager()
+	{
+		return ShellManager;
+	}
+
 	inline int64 GetLocalTime()
 	{
 		return LocalTime;
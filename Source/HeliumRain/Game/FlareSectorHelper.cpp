@@ -17,7 +17,7 @@ UFlareSimulatedSpacecraft*  SectorHelper::FindTradeStation(FlareTradeRequest Req
 	}
 
 	UFlareSimulatedSector* Sector = Request.Client->GetCurrentSector();
-	TArray<UFlareSimulatedSpacecraft*>& SectorStations = Sector->GetSectorStations();
+	const TArray<FFlareMarketStation>& MarketStations = Sector->GetMarketStations(Request.Resource);
 
 	float UnloadQuantityScoreMultiplier = 0;
 	float LoadQuantityScoreMultiplier = 0;
@@ -69,15 +69,15 @@ UFlareSimulatedSpacecraft*  SectorHelper::FindTradeStation(FlareTradeRequest Req
 	uint32 AvailableQuantity = Request.Client->GetCargoBay()->GetResourceQuantity(Request.Resource, Request.Client->GetCompany());
 	uint32 FreeSpace = Request.Client->GetCargoBay()->GetFreeSpaceForResource(Request.Resource, Request.Client->GetCompany());
 
-	for (int32 StationIndex = 0; StationIndex < SectorStations.Num(); StationIndex++)
+	for (int32 StationIndex = 0; StationIndex < MarketStations.Num(); StationIndex++)
 	{
-		UFlareSimulatedSpacecraft* Station = SectorStations[StationIndex];
+		UFlareSimulatedSpacecraft* Station = MarketStations[StationIndex].Station;
 
 		if(!Request.Client->CanTradeWith(Station))
 		{
 			continue;
 		}
-		EFlareResourcePriceContext::Type StationResourceUsage = Station->GetResourceUseType(Request.Resource);
+		EFlareResourcePriceContext::Type StationResourceUsage = MarketStations[StationIndex].Usage;
 
 		if(NeedOutput && (StationResourceUsage != EFlareResourcePriceContext::FactoryOutput &&
 						  StationResourceUsage != EFlareResourcePriceContext::MaintenanceConsumption))
@@ -140,7 +140,7 @@ UFlareSimulatedSpacecraft*  SectorHelper::FindTradeStation(FlareTradeRequest Req
 		}
 		else
 		{
-			EFlareResourcePriceContext::Type ResourceUsage = Station->GetResourceUseType(Request.Resource);
+			EFlareResourcePriceContext::Type ResourceUsage = StationResourceUsage;
 
 			uint32 MaxBuyableQuantity = Request.Client->GetCompany()->GetMoney() / Sector->GetResourcePrice(Request.Resource, ResourceUsage);
 			LoadMaxQuantity = FMath::Min(LoadMaxQuantity , MaxBuyableQuantity);
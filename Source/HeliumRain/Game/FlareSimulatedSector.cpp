@@ -12,9 +12,16 @@
 DECLARE_CYCLE_STAT(TEXT("FlareSector SimulatePriceVariation"), STAT_FlareSector_SimulatePriceVariation, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareSector GetSectorFriendlyness"), STAT_FlareSector_GetSectorFriendlyness, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareSector GetSectorBattleState"), STAT_FlareSector_GetSectorBattleState, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSector UpdateMarketIndex"), STAT_FlareSector_UpdateMarketIndex, STATGROUP_Flare);
 
 #define LOCTEXT_NAMESPACE "FlareSimulatedSector"
 
+// Compare each cached battle state with a new computation
+//#define DEBUG_BATTLE_STATE_CACHE
+
+// Daily prices kept for each resource
+#define RESOURCE_PRICE_HISTORY 50
+
 
 /*----------------------------------------------------
 	Constructor
@@ -24,6 +31,9 @@ UFlareSimulatedSector::UFlareSimulatedSector(const FObjectInitializer& ObjectIni
 	: Super(ObjectInitializer)
 {
 	PersistentStationIndex = 0;
+	WorldIndex = INDEX_NONE;
+	MarketIndexValid = false;
+	UseReferencePriceVariation = false;
 }
 
 void UFlareSimulatedSector::Load(const FFlareSectorDescription* Description, const FFlareSectorSave& Data, const FFlareSectorOrbitParameters& OrbitParameters)
@@ -45,6 +55,8 @@ void UFlareSimulatedSector::Load(const FFlareSectorDescription* Description, con
 	SectorShips.Empty();
 	SectorStations.Empty();
 	SectorSpacecrafts.Empty();
+	InvalidateBattleStates();
+	InvalidateMarketIndex();
 	SectorFleets.Empty();
 
 	FFlareCelestialBody* Body = Game->GetGameWorld()->GetPlanerarium()->FindCelestialBody(SectorOrbitParameters.CelestialBodyIdentifier);
@@ -357,6 +369,8 @@ UFlareSimulatedSpacecraft* UFlareSimulatedSector::CreateSpacecraft(FFlareSpacecr
 		SectorShips.Add(Spacecraft);
 	}
 	SectorSpacecrafts.Add(Spacecraft);
+	InvalidateBattleStates();
+	InvalidateMarketIndex();
 
 	Spacecraft->SetCurrentSector(this);
 
@@ -412,6 +426,8 @@ void UFlareSimulatedSector::AddFleet(UFlareFleet* Fleet)
 		SectorShips.AddUnique(Fleet->GetShips()[ShipIndex]);
 		SectorSpacecrafts.AddUnique(Fleet->GetShips()[ShipIndex]);
 	}
+
+	InvalidateBattleStates();
 }
 
 void UFlareSimulatedSector::DisbandFleet(UFlareFleet* Fleet)
@@ -446,6 +462,8 @@ void UFlareSimulatedSector::RetireFleet(UFlareFleet* Fleet)
 
 int UFlareSimulatedSector::RemoveSpacecraft(UFlareSimulatedSpacecraft* Spacecraft)
 {
+	InvalidateBattleStates();
+	InvalidateMarketIndex();
 	SectorStations.Remove(Spacecraft);
 	SectorShips.Remove(Spacecraft);
 	return SectorSpacecrafts.Remove(Spacecraft);
@@ -662,41 +680,195 @@ void UFlareSimulatedSector::AttachStationToActor(UFlareSimulatedSpacecraft* Spac
 	Spacecraft->SetActorAttachment(AttachActorName);
 }
 
-void UFlareSimulatedSector::SimulatePriceVariation()
+/** Add the price a station wants for a resource, weighted by its use of the resource */
+static void AddWantedPrice(UFlareCargoBay* CargoBay, FFlareResourceDescription* Resource, int32 ResourceIndex, float Weight,
+	TArray<float>& WantedPriceSums, TArray<float>& WantedWeightSums)
 {
-	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+	float StockRatio = FMath::Clamp((float) CargoBay->GetResourceQuantity(Resource, NULL) / (float) CargoBay->GetSlotCapacity(), 0.f, 1.f);
+	WantedPriceSums[ResourceIndex] += Weight * (1.f - StockRatio);
+	WantedWeightSums[ResourceIndex] += Weight;
+}
+
+/** Add the prices wanted by an active factory for the resources of a cycle, counting each resource once */
+static void AddFactoryWantedPrices(UFlareCargoBay* CargoBay, UFlareResourceCatalog* ResourceCatalog, const TArray<FFlareFactoryResource>& FactoryResources,
+	TArray<float>& WantedPriceSums, TArray<float>& WantedWeightSums)
+{
+	for (int32 FactoryResourceIndex = 0; FactoryResourceIndex < FactoryResources.Num(); FactoryResourceIndex++)
 	{
-		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
-		SimulatePriceVariation(Resource);
+		FFlareResourceDescription* Resource = &FactoryResources[FactoryResourceIndex].Resource->Data;
+		int32 ResourceIndex = ResourceCatalog->GetResourceIndex(Resource);
+		bool Duplicate = false;
+
+		for (int32 PreviousIndex = 0; PreviousIndex < FactoryResourceIndex; PreviousIndex++)
+		{
+			if (&FactoryResources[PreviousIndex].Resource->Data == Resource)
+			{
+				Duplicate = true;
+				break;
+			}
+		}
+
+		if (ResourceIndex != INDEX_NONE && !Duplicate)
+		{
+			AddWantedPrice(CargoBay, Resource, ResourceIndex, FactoryResources[FactoryResourceIndex].Quantity, WantedPriceSums, WantedWeightSums);
+		}
 	}
 }
 
-void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Resource)
+/** Move the prices toward the mean price wanted by the stations. Prices without any wanted weight are left unchanged. */
+static void ComputePriceVariations(int32 ResourceCount, const float* WantedPriceSums, const float* WantedWeightSums,
+	const float* MinPrices, const float* MaxPrices, const float* PriceRanges, float* Prices)
 {
-	SCOPE_CYCLE_COUNTER(STAT_FlareSector_SimulatePriceVariation);
-
-	float OldPrice = GetPreciseResourcePrice(Resource);
 	// Prices can increase because :
-
 	//  - The input of a station is low (and less than half)
 	//  - Consumer ressource is low
 	//  - Maintenance ressource is low (and less than half)
 
-
 	// Prices can decrease because :
 	//  - Output of a station is full (and more than half)
 	//  - Consumer ressource is full (and more than half)
 	//  - Maintenance ressource is full (and more than half) (very slow decrease)
 
+	const float MaxPriceVariation = 10;
+	const float A = (MaxPriceVariation - 2) * (MaxPriceVariation - 2) / (MaxPriceVariation * (MaxPriceVariation - 1));
+	const float B = (MaxPriceVariation - 2) / (MaxPriceVariation * (MaxPriceVariation - 1));
+	const float C = MaxPriceVariation / (MaxPriceVariation - 2);
+
+	for (int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
+	{
+		bool HasWeight = (WantedWeightSums[ResourceIndex] > 0);
+		float OldPrice = Prices[ResourceIndex];
+		float MeanWantedPriceRatio = WantedPriceSums[ResourceIndex] / (HasWeight ? WantedWeightSums[ResourceIndex] : 1.f);
+		float OldPriceRatio = (OldPrice - MinPrices[ResourceIndex]) / PriceRanges[ResourceIndex];
+		float WantedVariation = MeanWantedPriceRatio - OldPriceRatio;
+
+		float OldPriceRatioToVariationDirection = (WantedVariation > 0 ? OldPriceRatio : 1 - OldPriceRatio);
+		float VariationScale = (1 / (A*OldPriceRatioToVariationDirection + B)) - C;
+		float Variation = VariationScale * WantedVariation;
+		float NewPrice = FMath::Clamp(FMath::Max(1.f, OldPrice * (1 + Variation / 100.f)), MinPrices[ResourceIndex], MaxPrices[ResourceIndex]);
+
+		Prices[ResourceIndex] = ((HasWeight && WantedVariation != 0.f) ? NewPrice : OldPrice);
+	}
+}
+
+void UFlareSimulatedSector::SimulatePriceVariation()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSector_SimulatePriceVariation);
+
+	if (UseReferencePriceVariation)
+	{
+		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+		{
+			SimulatePriceVariation(&Game->GetResourceCatalog()->Resources[ResourceIndex]->Data);
+		}
+		return;
+	}
+
+	UFlareResourceCatalog* ResourceCatalog = Game->GetResourceCatalog();
+	int32 ResourceCount = ResourceCatalog->Resources.Num();
+
+	TArray<float> WantedPriceSums;
+	TArray<float> WantedWeightSums;
+	TArray<float> Prices;
+	TArray<float> MinPrices;
+	TArray<float> MaxPrices;
+	TArray<float> PriceRanges;
+	WantedPriceSums.SetNumZeroed(ResourceCount);
+	WantedWeightSums.SetNumZeroed(ResourceCount);
+	Prices.SetNumUninitialized(ResourceCount);
+	MinPrices.SetNumUninitialized(ResourceCount);
+	MaxPrices.SetNumUninitialized(ResourceCount);
+	PriceRanges.SetNumUninitialized(ResourceCount);
+
+	for (int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
+	{
+		FFlareResourceDescription* Resource = &ResourceCatalog->Resources[ResourceIndex]->Data;
+		Prices[ResourceIndex] = GetPreciseResourcePrice(Resource);
+		MinPrices[ResourceIndex] = Resource->MinPrice;
+		MaxPrices[ResourceIndex] = Resource->MaxPrice;
+		PriceRanges[ResourceIndex] = (float) (Resource->MaxPrice - Resource->MinPrice);
+	}
+
+	// Sum the wanted prices station by station. Each resource sees the stations in the same order as the market index, so the sums are the same.
+	for (UFlareSimulatedSpacecraft* Station : SectorStations)
+	{
+		UFlareCargoBay* CargoBay = Station->GetCargoBay();
+
+		if (CargoBay->HasRestrictions())
+		{
+			// Not allow station with slot restriction to impact the price
+			continue;
+		}
+
+		for (UFlareFactory* Factory : Station->GetFactories())
+		{
+			if (Factory->IsActive())
+			{
+				AddFactoryWantedPrices(CargoBay, ResourceCatalog, Factory->GetCycleData().InputResources, WantedPriceSums, WantedWeightSums);
+				AddFactoryWantedPrices(CargoBay, ResourceCatalog, Factory->GetCycleData().OutputResources, WantedPriceSums, WantedWeightSums);
+			}
+		}
+
+		if (Station->HasCapability(EFlareSpacecraftCapability::Consumer))
+		{
+			for (UFlareResourceCatalogEntry* Entry : ResourceCatalog->ConsumerResources)
+			{
+				float Weight = GetPeople()->GetRessourceConsumption(&Entry->Data, false);
+				AddWantedPrice(CargoBay, &Entry->Data, ResourceCatalog->GetResourceIndex(&Entry->Data), Weight, WantedPriceSums, WantedWeightSums);
+			}
+		}
+
+		if (Station->HasCapability(EFlareSpacecraftCapability::Maintenance))
+		{
+			for (UFlareResourceCatalogEntry* Entry : ResourceCatalog->MaintenanceResources)
+			{
+				AddWantedPrice(CargoBay, &Entry->Data, ResourceCatalog->GetResourceIndex(&Entry->Data), 1, WantedPriceSums, WantedWeightSums);
+			}
+		}
+	}
+
+	ComputePriceVariations(ResourceCount, WantedPriceSums.GetData(), WantedWeightSums.GetData(),
+		MinPrices.GetData(), MaxPrices.GetData(), PriceRanges.GetData(), Prices.GetData());
+
+	int32 NearestSectorCount = -1;
+	for (int32 ResourceIndex = 0; ResourceIndex < ResourceCount; ResourceIndex++)
+	{
+		FFlareResourceDescription* Resource = &ResourceCatalog->Resources[ResourceIndex]->Data;
+
+		if (WantedWeightSums[ResourceIndex] > 0)
+		{
+			ResourcePrices[Resource] = Prices[ResourceIndex];
+		}
+		else
+		{
+			// Without station, the price is averaged over the nearest sectors, each counted with the price of this sector
+			if (NearestSectorCount < 0)
+			{
+				NearestSectorCount = GetNearestSectorCount();
+			}
+
+			float PriceSum = 0;
+			for (int32 SectorIndex = 0; SectorIndex < NearestSectorCount; SectorIndex++)
+			{
+				PriceSum += Prices[ResourceIndex];
+			}
 
+			float MeanNearPrice = PriceSum / NearestSectorCount;
+			SetPreciseResourcePrice(Resource, MeanNearPrice);
+		}
+	}
+}
+
+void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Resource)
+{
+	float OldPrice = GetPreciseResourcePrice(Resource);
 	float WantedPriceSum = 0;
 	float WantedWeightSum = 0;
 
-
-	// Prices never go below min production cost
-	for (int32 CountIndex = 0 ; CountIndex < SectorStations.Num(); CountIndex++)
+	const TArray<FFlareMarketStation>& MarketStations = GetMarketStations(Resource);
+	for (int32 CountIndex = 0 ; CountIndex < MarketStations.Num(); CountIndex++)
 	{
-		UFlareSimulatedSpacecraft* Station = SectorStations[CountIndex];
+		UFlareSimulatedSpacecraft* Station = MarketStations[CountIndex].Station;
 
 		if(Station->GetCargoBay()->HasRestrictions())
 		{
@@ -715,7 +887,6 @@ void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Re
 				continue;
 			}
 
-
 			if (Factory->HasInputResource(Resource))
 			{
 				float Weight = Factory->GetInputResourceQuantity(Resource);
@@ -749,27 +920,10 @@ void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Re
 	{
 		float MeanWantedPriceRatio = WantedPriceSum / WantedWeightSum;
 		float OldPriceRatio = (OldPrice - Resource->MinPrice) / (float) (Resource->MaxPrice - Resource->MinPrice);
-
-
 		float WantedVariation = MeanWantedPriceRatio - OldPriceRatio;
 
-
-		/*FLOGV(">>> %s price in %s", *Resource->Name.ToString(), *GetSectorName().ToString());
-		FLOGV("   WantedPriceSum %f", WantedPriceSum);
-		FLOGV("   WantedWeightSum %f", WantedWeightSum);
-		FLOGV("   MeanWantedPriceRatio %f", MeanWantedPriceRatio);
-		FLOGV("   OldPrice %f", OldPrice);
-		FLOGV("   OldPriceRatio %f", OldPriceRatio);
-		FLOGV("   WantedVariation %f", WantedVariation);*/
-
-
-
-
 		if(WantedVariation != 0.f)
 		{
-
-
-
 			float MaxPriceVariation = 10;
 			float OldPriceRatioToVariationDirection;
 
@@ -787,39 +941,15 @@ void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Re
 			float C = MaxPriceVariation / (MaxPriceVariation - 2);
 
 			float VariationScale = (1 / (A*OldPriceRatioToVariationDirection + B)) - C;
-
-
-
 			float Variation = VariationScale * WantedVariation;
-
-
 			float NewPrice = FMath::Max(1.f, OldPrice * (1 + Variation / 100.f));
 
-
-			/*FLOGV("   VariationScale %f", VariationScale);
-			FLOGV("   Variation %f", Variation);
-			FLOGV("   NewPrice %f", NewPrice);*/
-
 			SetPreciseResourcePrice(Resource, NewPrice);
-			/*if(NewPrice > Resource->MaxPrice)
-			{
-				FLOGV("%s price at max in %s", *Resource->Name.ToString(), *GetSectorName().ToString());
-			}
-			else if(NewPrice < Resource->MinPrice)
-			{
-				FLOGV("%s price at min in %s", *Resource->Name.ToString(), *GetSectorName().ToString());
-			}
-			else
-			{
-				FLOGV("%s price in %s change from %f to %f (%f)", *Resource->Name.ToString(), *GetSectorName().ToString(), OldPrice / 100.f, NewPrice / 100.f, Variation);
-			}*/
 		}
 	}
 	else
 	{
-
 		// Find nearest sectors
-
 		int64 MinTravelDuration = -1;
 		int32 NumSector = 0;
 		float PriceSum = 0;
@@ -835,7 +965,6 @@ void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Re
 
 			int64 TravelDuration = UFlareTravel::ComputeTravelDuration(GetGame()->GetGameWorld(), this, SectorCandidate, NULL);
 
-
 			if (MinTravelDuration == -1 || MinTravelDuration > TravelDuration)
 			{
 				MinTravelDuration = TravelDuration;
@@ -855,6 +984,37 @@ void UFlareSimulatedSector::SimulatePriceVariation(FFlareResourceDescription* Re
 	}
 }
 
+int32 UFlareSimulatedSector::GetNearestSectorCount()
+{
+	int64 MinTravelDuration = -1;
+	int32 NumSector = 0;
+
+	for (int SectorIndex = 0; SectorIndex < GetGame()->GetGameWorld()->GetSectors().Num(); SectorIndex++)
+	{
+		UFlareSimulatedSector* SectorCandidate = GetGame()->GetGameWorld()->GetSectors()[SectorIndex];
+
+		if(SectorCandidate == this)
+		{
+			continue;
+		}
+
+		int64 TravelDuration = UFlareTravel::ComputeTravelDuration(GetGame()->GetGameWorld(), this, SectorCandidate, NULL);
+
+		if (MinTravelDuration == -1 || MinTravelDuration > TravelDuration)
+		{
+			MinTravelDuration = TravelDuration;
+			NumSector = 0;
+		}
+
+		if (MinTravelDuration == TravelDuration)
+		{
+			NumSector++;
+		}
+	}
+
+	return NumSector;
+}
+
 void UFlareSimulatedSector::ClearBombs()
 {
 	for (int i = 0 ; i < SectorData.BombData.Num(); i++)
@@ -956,8 +1116,8 @@ void UFlareSimulatedSector::LoadResourcePrices()
 		FFlareResourceDescription* Resource = Game->GetResourceCatalog()->Get(ResourcePrice->ResourceIdentifier);
 		float Price = ResourcePrice->Price;
 		ResourcePrices.Add(Resource, Price);
-		FFlareFloatBuffer* Prices = &ResourcePrice->Prices;
-		Prices->Resize(50);
+		FFlareTimeSeries* Prices = &ResourcePrice->Prices;
+		Prices->Resize(RESOURCE_PRICE_HISTORY);
 		LastResourcePrices.Add(Resource, *Prices);
 	}
 }
@@ -1043,6 +1203,28 @@ EFlareSectorFriendlyness::Type UFlareSimulatedSector::GetSectorFriendlyness(UFla
 }
 
 FFlareSectorBattleState UFlareSimulatedSector::GetSectorBattleState(UFlareCompany* Company)
+{
+	check(IsInGameThread());
+
+	FFlareSectorBattleState* CachedBattleState = BattleStates.Find(Company);
+	if (CachedBattleState)
+	{
+#ifdef DEBUG_BATTLE_STATE_CACHE
+		FFlareSectorBattleState BattleState = ComputeSectorBattleState(Company);
+		if (BattleState != *CachedBattleState || BattleState.HasDanger != CachedBattleState->HasDanger)
+		{
+			FLOGV("UFlareSimulatedSector::GetSectorBattleState : outdated cache in '%s' for '%s'",
+				*GetSectorName().ToString(), *Company->GetCompanyName().ToString());
+			FCHECK(false);
+		}
+#endif
+		return *CachedBattleState;
+	}
+
+	return BattleStates.Add(Company, ComputeSectorBattleState(Company));
+}
+
+FFlareSectorBattleState UFlareSimulatedSector::ComputeSectorBattleState(UFlareCompany* Company)
 {
 	SCOPE_CYCLE_COUNTER(STAT_FlareSector_GetSectorBattleState);
 
@@ -1065,6 +1247,8 @@ FFlareSectorBattleState UFlareSimulatedSector::GetSectorBattleState(UFlareCompan
 	int DangerousFriendlyActiveSpacecraftCount = 0;
 	int CrippledFriendlySpacecraftCount = 0;
 
+	const TBitArray<>& WarMask = Game->GetGameWorld()->GetWarMask(Company);
+
 	for (int SpacecraftIndex = 0 ; SpacecraftIndex < GetSectorShips().Num(); SpacecraftIndex++)
 	{
 
@@ -1094,7 +1278,7 @@ FFlareSectorBattleState UFlareSimulatedSector::GetSectorBattleState(UFlareCompan
 				CrippledFriendlySpacecraftCount++;
 			}
 		}
-		else if (OtherCompany->GetWarState(Company) == EFlareHostility::Hostile)
+		else if (WarMask[OtherCompany->GetWorldIndex()])
 		{
 			HostileSpacecraftCount++;
 			if (!Spacecraft->GetDamageSystem()->IsDisarmed())
@@ -1124,7 +1308,7 @@ FFlareSectorBattleState UFlareSimulatedSector::GetSectorBattleState(UFlareCompan
 			FriendlySpacecraftCount++;
 			CrippledFriendlySpacecraftCount++;
 		}
-		else if (OtherCompany->GetWarState(Company) == EFlareHostility::Hostile)
+		else if (WarMask[OtherCompany->GetWorldIndex()])
 		{
 			HostileSpacecraftCount++;
 		}
@@ -1305,8 +1489,8 @@ float UFlareSimulatedSector::GetPreciseResourcePrice(FFlareResourceDescription*
 	{
 		if (!LastResourcePrices.Contains(Resource))
 		{
-			FFlareFloatBuffer Prices;
-			Prices.Init(50);
+			FFlareTimeSeries Prices;
+			Prices.Init(RESOURCE_PRICE_HISTORY);
 			Prices.Append(GetPreciseResourcePrice(Resource, 0));
 			LastResourcePrices.Add(Resource, Prices);
 		}
@@ -1321,15 +1505,16 @@ void UFlareSimulatedSector::SwapPrices()
 	for(int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
 	{
 		FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
+		FFlareTimeSeries* Prices = LastResourcePrices.Find(Resource);
 
-		if (!LastResourcePrices.Contains(Resource))
+		if (!Prices)
 		{
-			FFlareFloatBuffer Prices;
-			Prices.Init(50);
-			LastResourcePrices.Add(Resource, Prices);
+			FFlareTimeSeries NewPrices;
+			NewPrices.Init(RESOURCE_PRICE_HISTORY);
+			Prices = &LastResourcePrices.Add(Resource, NewPrices);
 		}
 
-		LastResourcePrices[Resource].Append(GetPreciseResourcePrice(Resource, 0));
+		Prices->Append(GetPreciseResourcePrice(Resource, 0));
 	}
 }
 
@@ -1339,69 +1524,129 @@ void UFlareSimulatedSector::SetPreciseResourcePrice(FFlareResourceDescription* R
 }
 
 
-static bool ReserveShipComparator (UFlareSimulatedSpacecraft& Ship1, UFlareSimulatedSpacecraft& Ship2)
+/** Priority of a ship to stay out of reserve, highest first */
+struct FFlareReserveShipKey
 {
-	bool SELECT_SHIP1 = true;
-	bool SELECT_SHIP2 = false;
+	uint64                                  Priority;
+	UFlareSimulatedSpacecraft*              Ship;
+};
 
-	UFlareSimulatedSpacecraft* PlayerShip = Ship1.GetGame()->GetPC()->GetPlayerShip();
-	UFlareFleet* PlayerFleet = Ship1.GetGame()->GetPC()->GetPlayerFleet();
+static uint64 GetReserveShipPriority(UFlareSimulatedSpacecraft* Ship, UFlareSimulatedSpacecraft* PlayerShip, UFlareFleet* PlayerFleet, uint32 Seed)
+{
+	uint32 State = 0;
 
 	// Player ship is always the first in list
-	if (&Ship1 == PlayerShip)
+	if (Ship == PlayerShip)
 	{
-		return SELECT_SHIP1;
+		State |= (1u << 31);
 	}
 
-	if (&Ship2 == PlayerShip)
+	// Ships in player fleet are prioritary
+	if (Ship->GetCurrentFleet() == PlayerFleet)
 	{
-		return SELECT_SHIP2;
+		State |= (1u << 30);
 	}
 
-	// Ships in player fleet are prioritary
-	if (Ship1.GetCurrentFleet() == PlayerFleet && Ship2.GetCurrentFleet() != PlayerFleet)
+	// Priority to armed ships
+	if (!Ship->GetDamageSystem()->IsDisarmed())
 	{
-		return SELECT_SHIP1;
+		State |= (1u << 29);
 	}
 
-	if (Ship2.GetCurrentFleet() == PlayerFleet && Ship1.GetCurrentFleet() != PlayerFleet)
+	// Priority to controllable ships
+	if (!Ship->GetDamageSystem()->IsUncontrollable())
 	{
-		return SELECT_SHIP2;
+		State |= (1u << 28);
 	}
 
-	// Priority to armed ships
-	if (Ship1.GetDamageSystem()->IsDisarmed() && !Ship2.GetDamageSystem()->IsDisarmed())
+	// TODO sort by fleet order
+
+	// Priority to full ships
+	State |= FMath::Min((uint32) Ship->GetCargoBay()->GetUsedCargoSpace(), (1u << 28) - 1);
+
+	// Break ties with a seeded hash, so that the same ships are picked every time
+	uint32 Hash = FCrc::StrCrc32(*Ship->GetImmatriculation().ToString(), Seed);
+
+	return ((uint64) State << 32) | Hash;
+}
+
+/** Move the Count highest priority keys to the start of the array, in linear average time */
+static void SelectReserveShipKeys(TArray<FFlareReserveShipKey>& Keys, int32 Count)
+{
+	int32 Target = Count - 1;
+	int32 Left = 0;
+	int32 Right = Keys.Num() - 1;
+
+	while (Left < Right)
 	{
-		return SELECT_SHIP2;
+		uint64 Pivot = Keys[(Left + Right) / 2].Priority;
+		int32 LeftIndex = Left;
+		int32 RightIndex = Right;
+
+		while (LeftIndex <= RightIndex)
+		{
+			while (Keys[LeftIndex].Priority > Pivot)
+			{
+				LeftIndex++;
+			}
+			while (Keys[RightIndex].Priority < Pivot)
+			{
+				RightIndex--;
+			}
+			if (LeftIndex <= RightIndex)
+			{
+				Keys.Swap(LeftIndex, RightIndex);
+				LeftIndex++;
+				RightIndex--;
+			}
+		}
+
+		if (Target <= RightIndex)
+		{
+			Right = RightIndex;
+		}
+		else if (Target >= LeftIndex)
+		{
+			Left = LeftIndex;
+		}
+		else
+		{
+			break;
+		}
 	}
+}
 
-	if (Ship2.GetDamageSystem()->IsDisarmed() && !Ship1.GetDamageSystem()->IsDisarmed())
+/** Put all ships but the AllowedShipCount ones with the highest priority in reserve */
+static void ReserveLowPriorityShips(const TArray<UFlareSimulatedSpacecraft*>& Ships, int32 AllowedShipCount, uint32 Seed)
+{
+	if (AllowedShipCount >= Ships.Num())
 	{
-		return SELECT_SHIP1;
+		return;
 	}
 
-	// Priority to controllable ships
-	if (Ship1.GetDamageSystem()->IsUncontrollable() && !Ship2.GetDamageSystem()->IsUncontrollable())
+	AFlarePlayerController* PC = Ships[0]->GetGame()->GetPC();
+	UFlareSimulatedSpacecraft* PlayerShip = PC->GetPlayerShip();
+	UFlareFleet* PlayerFleet = PC->GetPlayerFleet();
+
+	TArray<FFlareReserveShipKey> Keys;
+	Keys.Reserve(Ships.Num());
+	for (UFlareSimulatedSpacecraft* Ship : Ships)
 	{
-		return SELECT_SHIP2;
+		FFlareReserveShipKey Key;
+		Key.Priority = GetReserveShipPriority(Ship, PlayerShip, PlayerFleet, Seed);
+		Key.Ship = Ship;
+		Keys.Add(Key);
 	}
 
-	if (Ship2.GetDamageSystem()->IsUncontrollable() && !Ship1.GetDamageSystem()->IsUncontrollable())
+	if (AllowedShipCount > 0)
 	{
-		return SELECT_SHIP1;
+		SelectReserveShipKeys(Keys, AllowedShipCount);
 	}
 
-
-	// TODO sort by fleet order
-
-
-	// Priority to full ships
-	if(Ship1.GetCargoBay()->GetUsedCargoSpace() != Ship2.GetCargoBay()->GetUsedCargoSpace())
+	for (int32 ShipIndex = AllowedShipCount; ShipIndex < Keys.Num(); ShipIndex++)
 	{
-		return Ship1.GetCargoBay()->GetUsedCargoSpace() > Ship2.GetCargoBay()->GetUsedCargoSpace();
+		Keys[ShipIndex].Ship->SetReserve(true);
 	}
-
-	return FMath::RandBool();
 }
 
 static const int32 MIN_SPAWN = 1;
@@ -1483,6 +1728,7 @@ void UFlareSimulatedSector::UpdateReserveShips()
 		}
 	}
 
+	uint32 Seed = FCrc::StrCrc32(*GetIdentifier().ToString());
 	float MilitaryProportion = (GetSectorBattleState(Game->GetPC()->GetCompany()).InBattle ? 0.75f : 0.25);
 	float CargoProportion = 1.f-MilitaryProportion;
 
@@ -1498,12 +1744,7 @@ void UFlareSimulatedSector::UpdateReserveShips()
 			AllowedShipCount += MIN_SPAWN;
 			FLOGV("Allow %d/%d cargo for %s", AllowedShipCount, CargoCompanyShipCount, *Company->GetCompanyName().ToString());
 
-			CargoShipListByCompanies[CompanyIndex].Sort(&ReserveShipComparator);
-			for (int32 ShipIndex = AllowedShipCount; ShipIndex < CargoCompanyShipCount; ShipIndex++)
-			{
-				UFlareSimulatedSpacecraft* Ship = CargoShipListByCompanies[CompanyIndex][ShipIndex];
-				Ship->SetReserve(true);
-			}
+			ReserveLowPriorityShips(CargoShipListByCompanies[CompanyIndex], AllowedShipCount, Seed);
 		}
 
 		int32 MilitaryCompanyShipCount = MilitaryShipListByCompanies[CompanyIndex].Num();
@@ -1514,14 +1755,94 @@ void UFlareSimulatedSector::UpdateReserveShips()
 			AllowedShipCount += MIN_SPAWN;
 			FLOGV("Allow %d/%d military for %s", AllowedShipCount, MilitaryCompanyShipCount, *Company->GetCompanyName().ToString());
 
-			MilitaryShipListByCompanies[CompanyIndex].Sort(&ReserveShipComparator);
-			for (int32 ShipIndex = AllowedShipCount; ShipIndex < MilitaryCompanyShipCount; ShipIndex++)
+			ReserveLowPriorityShips(MilitaryShipListByCompanies[CompanyIndex], AllowedShipCount, Seed);
+		}
+	}
+}
+
+const TArray<FFlareMarketStation>& UFlareSimulatedSector::GetMarketStations(FFlareResourceDescription* Resource)
+{
+	if (!MarketIndexValid)
+	{
+		UpdateMarketIndex();
+	}
+
+	const TArray<FFlareMarketStation>* Stations = MarketIndex.Find(Resource);
+	return (Stations ? *Stations : EmptyMarketStations);
+}
+
+const TArray<UFlareSimulatedSpacecraft*>& UFlareSimulatedSector::GetConsumerStations()
+{
+	if (!MarketIndexValid)
+	{
+		UpdateMarketIndex();
+	}
+
+	return ConsumerStations;
+}
+
+void UFlareSimulatedSector::UpdateMarketIndex()
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSector_UpdateMarketIndex);
+
+	MarketIndex.Empty();
+	ConsumerStations.Empty();
+
+	UFlareResourceCatalog* ResourceCatalog = Game->GetResourceCatalog();
+	TArray<FFlareResourceDescription*> StationResources;
+
+	for (UFlareSimulatedSpacecraft* Station : SectorStations)
+	{
+		// List the resources this station can use
+		StationResources.Reset();
+
+		for (UFlareFactory* Factory : Station->GetFactories())
+		{
+			for (const FFlareFactoryResource& FactoryResource : Factory->GetCycleData().InputResources)
+			{
+				StationResources.AddUnique(&FactoryResource.Resource->Data);
+			}
+
+			for (const FFlareFactoryResource& FactoryResource : Factory->GetCycleData().OutputResources)
 			{
-				UFlareSimulatedSpacecraft* Ship = MilitaryShipListByCompanies[CompanyIndex][ShipIndex];
-				Ship->SetReserve(true);
+				StationResources.AddUnique(&FactoryResource.Resource->Data);
+			}
+		}
+
+		bool IsConsumer = Station->HasCapability(EFlareSpacecraftCapability::Consumer);
+		bool IsMaintenance = Station->HasCapability(EFlareSpacecraftCapability::Maintenance);
+
+		if (IsConsumer)
+		{
+			ConsumerStations.Add(Station);
+		}
+
+		if (IsConsumer || IsMaintenance)
+		{
+			for (UFlareResourceCatalogEntry* Entry : ResourceCatalog->Resources)
+			{
+				if ((IsConsumer && Entry->Data.IsConsumerResource) || (IsMaintenance && Entry->Data.IsMaintenanceResource))
+				{
+					StationResources.AddUnique(&Entry->Data);
+				}
+			}
+		}
+
+		// Use the same priorities as the price queries
+		for (FFlareResourceDescription* Resource : StationResources)
+		{
+			EFlareResourcePriceContext::Type Usage = Station->GetResourceUseType(Resource);
+			if (Usage != EFlareResourcePriceContext::Default)
+			{
+				FFlareMarketStation MarketStation;
+				MarketStation.Station = Station;
+				MarketStation.Usage = Usage;
+				MarketIndex.FindOrAdd(Resource).Add(MarketStation);
 			}
 		}
 	}
+
+	MarketIndexValid = true;
 }
 
 int64 UFlareSimulatedSector::GetResourcePrice(FFlareResourceDescription* Resource, EFlareResourcePriceContext::Type PriceContext, int32 Age)
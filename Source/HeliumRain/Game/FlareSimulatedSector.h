@@ -252,7 +252,7 @@ struct FFFlareResourcePrice
 	float Price;
 
 	UPROPERTY(EditAnywhere, Category = Save)
-	FFlareFloatBuffer Prices;
+	FFlareTimeSeries Prices;
 };
 
 /** Sector save data */
@@ -321,6 +321,16 @@ struct FFlareStationSpawnParameters
 };
 
 
+/** A station using a resource, as listed by the sector market index */
+struct FFlareMarketStation
+{
+	UFlareSimulatedSpacecraft*              Station;
+
+	/** Same as UFlareSimulatedSpacecraft::GetResourceUseType, never Default */
+	EFlareResourcePriceContext::Type        Usage;
+};
+
+
 UCLASS()
 class HELIUMRAIN_API UFlareSimulatedSector : public UObject
 {
@@ -373,6 +383,24 @@ public:
 
 	int RemoveSpacecraft(UFlareSimulatedSpacecraft* Spacecraft);
 
+	/** Forget the cached battle states, after a change in ships, damage, reserve or war state */
+	void InvalidateBattleStates()
+	{
+		BattleStates.Reset();
+	}
+
+	/** Forget the market index, after a station was added, removed, rebuilt, or changed the ship it builds */
+	void InvalidateMarketIndex()
+	{
+		MarketIndexValid = false;
+	}
+
+	/** Get the stations using a resource, in station order, with their usage */
+	const TArray<FFlareMarketStation>& GetMarketStations(FFlareResourceDescription* Resource);
+
+	/** Get the stations with the consumer capability, in station order */
+	const TArray<UFlareSimulatedSpacecraft*>& GetConsumerStations();
+
 	/** Check whether we can build a station, understand why if not */
 	bool CanBuildStation(FFlareSpacecraftDescription* StationDescription, UFlareCompany* Company, TArray<FText>& OutReason, bool IgnoreCost = false);
 
@@ -389,9 +417,14 @@ public:
 
 	void AttachStationToActor(UFlareSimulatedSpacecraft* Spacecraft, FName AttachActorName);
 
+	/** Move the prices of all resources toward the prices wanted by the sector stations */
 	void SimulatePriceVariation();
 
-	void SimulatePriceVariation(FFlareResourceDescription* Resource);
+	/** Move prices one resource at a time instead of in a single pass, to check that both give the same prices */
+	void SetUseReferencePriceVariation(bool NewUseReferencePriceVariation)
+	{
+		UseReferencePriceVariation = NewUseReferencePriceVariation;
+	}
 
 	void ClearBombs();
 
@@ -420,6 +453,7 @@ protected:
 	UFlarePeople*							People;
 
 	int32                                   PersistentStationIndex;
+	int32                                   WorldIndex;
 	float									LightRatio;
 
 	AFlareGame*                             Game;
@@ -428,7 +462,29 @@ protected:
 	FFlareSectorOrbitParameters             SectorOrbitParameters;
 	const FFlareSectorDescription*          SectorDescription;
 	TMap<FFlareResourceDescription*, float> ResourcePrices;
-	TMap<FFlareResourceDescription*, FFlareFloatBuffer> LastResourcePrices;
+	TMap<FFlareResourceDescription*, FFlareTimeSeries> LastResourcePrices;
+
+	// Battle states by company, computed on demand on the game thread
+	TMap<UFlareCompany*, FFlareSectorBattleState> BattleStates;
+
+	// Market index, rebuilt on demand
+	TMap<FFlareResourceDescription*, TArray<FFlareMarketStation>> MarketIndex;
+	TArray<FFlareMarketStation>             EmptyMarketStations;
+	TArray<UFlareSimulatedSpacecraft*>      ConsumerStations;
+	bool                                    MarketIndexValid;
+	bool                                    UseReferencePriceVariation;
+
+	/** Build the market index from the sector stations */
+	void UpdateMarketIndex();
+
+	/** Move the price of a resource, scanning the market stations of this resource only */
+	void SimulatePriceVariation(FFlareResourceDescription* Resource);
+
+	/** Count the other sectors at the shortest travel duration from this one */
+	int32 GetNearestSectorCount();
+
+	/** Compute the battle status of a company from the sector spacecrafts */
+	FFlareSectorBattleState ComputeSectorBattleState(UFlareCompany* Company);
 
 public:
 
@@ -499,6 +555,17 @@ public:
 		return SectorData.IsTravelSector;
 	}
 
+	/** Dense index of this sector in the world sector list, INDEX_NONE for travel sectors */
+	inline int32 GetWorldIndex() const
+	{
+		return WorldIndex;
+	}
+
+	inline void SetWorldIndex(int32 Index)
+	{
+		WorldIndex = Index;
+	}
+
 
 	int64 GetStationConstructionFee(int64 BasePrice);
 
@@ -0,0 +1,315 @@
+
+#include "../Flare.h"
+#include "FlareSpatialIndex.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlareSpatialIndex Build"), STAT_FlareSpatialIndex_Build, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareSpatialIndex Query"), STAT_FlareSpatialIndex_Query, STATGROUP_Flare);
+
+const float FFlareSpatialIndex::CellSize = 50000; // 500m
+
+
+/*----------------------------------------------------
+	Build
+----------------------------------------------------*/
+
+FFlareSpatialIndex::FFlareSpatialIndex()
+{
+	Reset();
+}
+
+void FFlareSpatialIndex::Reset()
+{
+	Entries.Reset();
+	Cells.Reset();
+	LargeEntries.Reset();
+	EntryQueryStamps.Reset();
+	QueryStamp = 0;
+	BoundsMin = FVector::ZeroVector;
+	BoundsMax = FVector::ZeroVector;
+	MaxSpeed = 0;
+	BuildTime = 0;
+	CurrentTime = 0;
+}
+
+void FFlareSpatialIndex::Add(AActor* Actor, AFlareSpacecraft* Spacecraft, FVector Velocity, float Radius, EFlareSpatialBody::Type BodyType)
+{
+	FFlareSpatialIndexEntry Entry;
+	Entry.Actor = Actor;
+	Entry.Spacecraft = Spacecraft;
+	Entry.Location = Actor->GetActorLocation();
+	Entry.Velocity = Velocity;
+	Entry.Radius = FMath::Max(Radius, 0.f);
+	Entry.BodyType = BodyType;
+	Entries.Add(Entry);
+}
+
+void FFlareSpatialIndex::Build(float Time)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSpatialIndex_Build);
+
+	Cells.Reset();
+	LargeEntries.Reset();
+	EntryQueryStamps.SetNumZeroed(Entries.Num());
+	QueryStamp = 0;
+	MaxSpeed = 0;
+	BuildTime = Time;
+	CurrentTime = Time;
+	BoundsMin = FVector(MAX_FLT, MAX_FLT, MAX_FLT);
+	BoundsMax = FVector(-MAX_FLT, -MAX_FLT, -MAX_FLT);
+
+	for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); EntryIndex++)
+	{
+		const FFlareSpatialIndexEntry& Entry = Entries[EntryIndex];
+		FVector Extent = FVector(Entry.Radius, Entry.Radius, Entry.Radius);
+
+		BoundsMin = BoundsMin.ComponentMin(Entry.Location - Extent);
+		BoundsMax = BoundsMax.ComponentMax(Entry.Location + Extent);
+		MaxSpeed = FMath::Max(MaxSpeed, Entry.Velocity.Size());
+
+		FIntVector MinCell = GetCell(Entry.Location - Extent);
+		FIntVector MaxCell = GetCell(Entry.Location + Extent);
+		FIntVector Span = MaxCell - MinCell;
+
+		// Large bodies are checked by every query
+		if (Span.GetMax() >= MaxCellSpan)
+		{
+			LargeEntries.Add(EntryIndex);
+			continue;
+		}
+
+		for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+				{
+					Cells.FindOrAdd(FIntVector(X, Y, Z)).Add(EntryIndex);
+				}
+			}
+		}
+	}
+}
+
+void FFlareSpatialIndex::SetTime(float Time)
+{
+	CurrentTime = Time;
+}
+
+
+/*----------------------------------------------------
+	Queries
+----------------------------------------------------*/
+
+void FFlareSpatialIndex::GetInRadius(FVector Location, float Radius, int32 BodyTypes, TArray<const FFlareSpatialIndexEntry*>& OutEntries)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSpatialIndex_Query);
+
+	float SearchRadius = Radius + GetSlack();
+	FVector Extent = FVector(SearchRadius, SearchRadius, SearchRadius);
+	GatherCells(Location - Extent, Location + Extent, BodyTypes, QueryIndices);
+
+	for (int32 Index : QueryIndices)
+	{
+		const FFlareSpatialIndexEntry& Entry = Entries[Index];
+		if (FVector::DistSquared(Entry.Location, Location) <= FMath::Square(SearchRadius + Entry.Radius))
+		{
+			OutEntries.Add(&Entry);
+		}
+	}
+}
+
+void FFlareSpatialIndex::GetAlongSegment(FVector Start, FVector End, float Radius, int32 BodyTypes, TArray<const FFlareSpatialIndexEntry*>& OutEntries)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareSpatialIndex_Query);
+
+	float SearchRadius = Radius + GetSlack();
+	FVector Extent = FVector(SearchRadius, SearchRadius, SearchRadius);
+	GatherCells(Start.ComponentMin(End) - Extent, Start.ComponentMax(End) + Extent, BodyTypes, QueryIndices);
+
+	for (int32 Index : QueryIndices)
+	{
+		const FFlareSpatialIndexEntry& Entry = Entries[Index];
+		if (FMath::PointDistToSegmentSquared(Entry.Location, Start, End) <= FMath::Square(SearchRadius + Entry.Radius))
+		{
+			OutEntries.Add(&Entry);
+		}
+	}
+}
+
+void FFlareSpatialIndex::GetNearest(FVector Location, int32 Count, int32 BodyTypes, bool IncludeSize,
+	TFunctionRef<bool(const FFlareSpatialIndexEntry&)> Filter, TArray<const FFlareSpatialIndexEntry*>& OutEntries)
+{
+	if (Entries.Num() == 0 || Count <= 0)
+	{
+		return;
+	}
+
+	// Distance beyond which every body has been found
+	FVector FarthestCorner = FVector(
+		FMath::Max(FMath::Abs(Location.X - BoundsMin.X), FMath::Abs(Location.X - BoundsMax.X)),
+		FMath::Max(FMath::Abs(Location.Y - BoundsMin.Y), FMath::Abs(Location.Y - BoundsMax.Y)),
+		FMath::Max(FMath::Abs(Location.Z - BoundsMin.Z), FMath::Abs(Location.Z - BoundsMax.Z)));
+	float MaxSearchRadius = FarthestCorner.Size() + GetSlack();
+
+	struct FCandidate
+	{
+		const FFlareSpatialIndexEntry* Entry;
+		float Distance;
+		int32 Index;
+
+		bool operator<(const FCandidate& Other) const
+		{
+			return Distance < Other.Distance || (Distance == Other.Distance && Index < Other.Index);
+		}
+	};
+
+	TArray<const FFlareSpatialIndexEntry*> InRange;
+	TArray<FCandidate> Candidates;
+
+	// Grow the search sphere until enough bodies are found inside it
+	for (float SearchRadius = CellSize; ; SearchRadius *= 2)
+	{
+		bool SearchedAll = (SearchRadius >= MaxSearchRadius);
+
+		InRange.Reset();
+		Candidates.Reset();
+		GetInRadius(Location, SearchRadius, BodyTypes, InRange);
+
+		for (const FFlareSpatialIndexEntry* Entry : InRange)
+		{
+			float Distance = FVector::Dist(Entry->Actor->GetActorLocation(), Location) - (IncludeSize ? Entry->Radius : 0);
+			if ((SearchedAll || Distance <= SearchRadius) && Filter(*Entry))
+			{
+				FCandidate Candidate;
+				Candidate.Entry = Entry;
+				Candidate.Distance = Distance;
+				Candidate.Index = Entry - Entries.GetData();
+				Candidates.Add(Candidate);
+			}
+		}
+
+		if (SearchedAll || Candidates.Num() >= Count)
+		{
+			break;
+		}
+	}
+
+	Candidates.Sort();
+	for (int32 CandidateIndex = 0; CandidateIndex < Candidates.Num() && CandidateIndex < Count; CandidateIndex++)
+	{
+		OutEntries.Add(Candidates[CandidateIndex].Entry);
+	}
+}
+
+const FFlareSpatialIndexEntry* FFlareSpatialIndex::GetNearest(FVector Location, int32 BodyTypes, bool IncludeSize,
+	TFunctionRef<bool(const FFlareSpatialIndexEntry&)> Filter, float* OutDistance)
+{
+	TArray<const FFlareSpatialIndexEntry*> Nearest;
+	GetNearest(Location, 1, BodyTypes, IncludeSize, Filter, Nearest);
+
+	if (Nearest.Num() == 0)
+	{
+		return NULL;
+	}
+
+	if (OutDistance)
+	{
+		*OutDistance = FVector::Dist(Nearest[0]->Actor->GetActorLocation(), Location) - (IncludeSize ? Nearest[0]->Radius : 0);
+	}
+	return Nearest[0];
+}
+
+
+/*----------------------------------------------------
+	Internal
+----------------------------------------------------*/
+
+FIntVector FFlareSpatialIndex::GetCell(FVector Location) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Location.X / CellSize),
+		FMath::FloorToInt(Location.Y / CellSize),
+		FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void FFlareSpatialIndex::GatherCells(FVector Min, FVector Max, int32 BodyTypes, TArray<int32>& OutIndices)
+{
+	OutIndices.Reset();
+	QueryStamp++;
+
+	// Stamps wrapped around, clear them
+	if (QueryStamp == 0)
+	{
+		FMemory::Memzero(EntryQueryStamps.GetData(), EntryQueryStamps.Num() * sizeof(uint32));
+		QueryStamp = 1;
+	}
+
+	auto AddEntry = [this, BodyTypes, &OutIndices](int32 Index)
+	{
+		if (EntryQueryStamps[Index] != QueryStamp && (Entries[Index].BodyType & BodyTypes))
+		{
+			EntryQueryStamps[Index] = QueryStamp;
+			OutIndices.Add(Index);
+		}
+	};
+
+	for (int32 Index : LargeEntries)
+	{
+		AddEntry(Index);
+	}
+
+	// Clamp the box to the bodies
+	Min = Min.ComponentMax(BoundsMin);
+	Max = Max.ComponentMin(BoundsMax);
+	if (Min.X > Max.X || Min.Y > Max.Y || Min.Z > Max.Z)
+	{
+		OutIndices.Sort();
+		return;
+	}
+
+	FIntVector MinCell = GetCell(Min);
+	FIntVector MaxCell = GetCell(Max);
+	FIntVector Span = MaxCell - MinCell + FIntVector(1, 1, 1);
+	int64 CellCount = (int64)Span.X * Span.Y * Span.Z;
+
+	// Scanning all bodies is cheaper than looking up that many cells. Start over without the large bodies to keep the insertion order.
+	if (CellCount > Cells.Num() || CellCount > Entries.Num())
+	{
+		OutIndices.Reset();
+		for (int32 Index = 0; Index < Entries.Num(); Index++)
+		{
+			if (Entries[Index].BodyType & BodyTypes)
+			{
+				OutIndices.Add(Index);
+			}
+		}
+		return;
+	}
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				TArray<int32>* Cell = Cells.Find(FIntVector(X, Y, Z));
+				if (Cell)
+				{
+					for (int32 Index : *Cell)
+					{
+						AddEntry(Index);
+					}
+				}
+			}
+		}
+	}
+
+	// Keep the insertion order
+	OutIndices.Sort();
+}
+
+float FFlareSpatialIndex::GetSlack() const
+{
+	// Allow for some acceleration since the build, and a small margin
+	return 1.5f * MaxSpeed * FMath::Max(CurrentTime - BuildTime, 0.f) + 100;
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "../Flare.h"
+
+class AFlareSpacecraft;
+
+
+/** Kinds of bodies stored in the spatial index */
+namespace EFlareSpatialBody
+{
+	enum Type
+	{
+		Spacecraft = 1,
+		Asteroid = 2,
+		Collider = 4,
+
+		All = Spacecraft | Asteroid | Collider
+	};
+}
+
+/** A body in the spatial index, as it was when the index was built */
+struct FFlareSpatialIndexEntry
+{
+	AActor*                      Actor;
+	AFlareSpacecraft*            Spacecraft;
+	FVector                      Location;
+	FVector                      Velocity;
+	float                        Radius;
+	EFlareSpatialBody::Type      BodyType;
+};
+
+
+/** Sparse uniform grid over the bodies of the active sector.
+ *  Positions are captured when the index is built, so queries return a superset of the bodies in range :
+ *  callers still check the actual location of each result. */
+class FFlareSpatialIndex
+{
+public:
+
+	FFlareSpatialIndex();
+
+	/*----------------------------------------------------
+		Build
+	----------------------------------------------------*/
+
+	/** Remove all bodies */
+	void Reset();
+
+	/** Add a body. Queries return bodies in insertion order. */
+	void Add(AActor* Actor, AFlareSpacecraft* Spacecraft, FVector Velocity, float Radius, EFlareSpatialBody::Type BodyType);
+
+	/** Sort the bodies into the grid, at world time Time */
+	void Build(float Time);
+
+	/** Set the current world time, to account for the movement of bodies since the build */
+	void SetTime(float Time);
+
+
+	/*----------------------------------------------------
+		Queries
+	----------------------------------------------------*/
+
+	/** Get the bodies that may be less than Radius away from Location (center to surface) */
+	void GetInRadius(FVector Location, float Radius, int32 BodyTypes, TArray<const FFlareSpatialIndexEntry*>& OutEntries);
+
+	/** Get the bodies that may be less than Radius away from the segment between Start and End (center to surface) */
+	void GetAlongSegment(FVector Start, FVector End, float Radius, int32 BodyTypes, TArray<const FFlareSpatialIndexEntry*>& OutEntries);
+
+	/** Get up to Count bodies accepted by Filter, nearest first. Distances use the current actor locations, minus the body radius if IncludeSize is set. */
+	void GetNearest(FVector Location, int32 Count, int32 BodyTypes, bool IncludeSize,
+		TFunctionRef<bool(const FFlareSpatialIndexEntry&)> Filter, TArray<const FFlareSpatialIndexEntry*>& OutEntries);
+
+	/** Get the nearest body accepted by Filter, or NULL */
+	const FFlareSpatialIndexEntry* GetNearest(FVector Location, int32 BodyTypes, bool IncludeSize,
+		TFunctionRef<bool(const FFlareSpatialIndexEntry&)> Filter, float* OutDistance = NULL);
+
+	/** Get the highest body speed, measured when the index was built */
+	float GetMaxSpeed() const
+	{
+		return MaxSpeed;
+	}
+
+	const TArray<FFlareSpatialIndexEntry>& GetEntries() const
+	{
+		return Entries;
+	}
+
+
+protected:
+
+	/*----------------------------------------------------
+		Internal
+	----------------------------------------------------*/
+
+	FIntVector GetCell(FVector Location) const;
+
+	/** Get the sorted entries of all cells in a box, or of all entries if the box is too large */
+	void GatherCells(FVector Min, FVector Max, int32 BodyTypes, TArray<int32>& OutIndices);
+
+	/** Distance a body may have moved since the build */
+	float GetSlack() const;
+
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
+	TArray<FFlareSpatialIndexEntry>      Entries;
+	TMap<FIntVector, TArray<int32>>      Cells;
+	TArray<int32>                        LargeEntries;
+
+	// Query deduplication
+	TArray<uint32>                       EntryQueryStamps;
+	uint32                               QueryStamp;
+
+	FVector                              BoundsMin;
+	FVector                              BoundsMax;
+	float                                MaxSpeed;
+	float                                BuildTime;
+	float                                CurrentTime;
+
+	// Temporary data
+	TArray<int32>                        QueryIndices;
+
+
+public:
+
+	/** Grid cell size, in cm */
+	static const float CellSize;
+
+	/** Bodies covering more cells than this on an axis are checked by every query */
+	static const int32 MaxCellSpan = 4;
+
+};
@@ -0,0 +1,117 @@
+
+#include "../Flare.h"
+#include "FlareThreatTable.h"
+#include "FlareGame.h"
+#include "FlareSector.h"
+#include "FlareWorld.h"
+#include "FlareCompany.h"
+#include "../Spacecrafts/FlareSpacecraft.h"
+#include "../Spacecrafts/FlareShipPilot.h"
+#include "../Spacecrafts/FlarePilotHelper.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlareThreatTable Build"), STAT_FlareThreatTable_Build, STATGROUP_Flare);
+
+
+/*----------------------------------------------------
+	Build
+----------------------------------------------------*/
+
+FFlareThreatTable::FFlareThreatTable()
+{
+	Reset();
+}
+
+void FFlareThreatTable::Reset()
+{
+	Entries.Reset();
+	CompanyThreats.Reset();
+	CompanyThreatsValid.Reset();
+}
+
+void FFlareThreatTable::Build(UFlareSector* Sector)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareThreatTable_Build);
+
+	Reset();
+
+	TMap<AFlareSpacecraft*, int32> EntryIndices;
+	TArray<AFlareSpacecraft*>& Spacecrafts = Sector->GetSpacecrafts();
+
+	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Spacecrafts.Num(); SpacecraftIndex++)
+	{
+		AFlareSpacecraft* Spacecraft = Spacecrafts[SpacecraftIndex];
+		UFlareSimulatedSpacecraft* Parent = Spacecraft->GetParent();
+		UFlareSimulatedSpacecraftDamageSystem* DamageSystem = Parent->GetDamageSystem();
+
+		// Ignore destroyed ships and out limit ships
+		if (!DamageSystem->IsAlive() || Spacecraft->GetActorLocation().Size() > Sector->GetSectorLimits())
+		{
+			continue;
+		}
+
+		FFlareThreatEntry Entry;
+		Entry.Spacecraft = Spacecraft;
+		Entry.PilotTarget = Spacecraft->GetPilot()->GetTargetShip();
+		Entry.Location = Spacecraft->GetActorLocation();
+		Entry.Velocity = Spacecraft->Airframe->GetPhysicsLinearVelocity();
+		Entry.Size = Spacecraft->GetMeshScale();
+		Entry.CompanyIndex = Spacecraft->GetCompany()->GetWorldIndex();
+		Entry.IncomingBombCount = 0;
+		Entry.PartSize = Parent->GetSize();
+		Entry.IsStation = Parent->IsStation();
+		Entry.IsMilitary = Parent->IsMilitary();
+		Entry.IsDangerous = PilotHelper::IsShipDangerous(Spacecraft);
+		Entry.IsStranded = DamageSystem->IsStranded();
+		Entry.IsUncontrollable = DamageSystem->IsUncontrollable();
+		Entry.IsDisarmed = DamageSystem->IsDisarmed();
+		Entry.IsHarpooned = Parent->IsHarpooned();
+
+		EntryIndices.Add(Spacecraft, Entries.Add(Entry));
+	}
+
+	// Count incoming bombs
+	for (AFlareBomb* Bomb : Sector->GetBombs())
+	{
+		if (Bomb->GetTargetSpacecraft() && Bomb->IsActive())
+		{
+			int32* EntryIndex = EntryIndices.Find(Bomb->GetTargetSpacecraft());
+			if (EntryIndex)
+			{
+				Entries[*EntryIndex].IncomingBombCount++;
+			}
+		}
+	}
+}
+
+
+/*----------------------------------------------------
+	Queries
+----------------------------------------------------*/
+
+const TArray<const FFlareThreatEntry*>& FFlareThreatTable::GetHostileThreats(const UFlareCompany* Company)
+{
+	int32 CompanyIndex = Company->GetWorldIndex();
+	if (CompanyIndex >= CompanyThreats.Num())
+	{
+		CompanyThreats.SetNum(CompanyIndex + 1);
+		CompanyThreatsValid.SetNumZeroed(CompanyIndex + 1);
+	}
+
+	TArray<const FFlareThreatEntry*>& Threats = CompanyThreats[CompanyIndex];
+	if (!CompanyThreatsValid[CompanyIndex])
+	{
+		const TBitArray<>& WarMask = Company->GetGame()->GetGameWorld()->GetWarMask(Company);
+
+		for (const FFlareThreatEntry& Entry : Entries)
+		{
+			if (WarMask[Entry.CompanyIndex])
+			{
+				Threats.Add(&Entry);
+			}
+		}
+
+		CompanyThreatsValid[CompanyIndex] = true;
+	}
+
+	return Threats;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "../Flare.h"
+#include "../Spacecrafts/FlareSpacecraftTypes.h"
+
+class AFlareSpacecraft;
+class UFlareCompany;
+class UFlareSector;
+
+
+/** State of a potential target, as it was when the threat table was built */
+struct FFlareThreatEntry
+{
+	AFlareSpacecraft*            Spacecraft;
+	AFlareSpacecraft*            PilotTarget;
+	FVector                      Location;
+	FVector                      Velocity;
+	float                        Size;
+	int32                        CompanyIndex;
+	int32                        IncomingBombCount;
+	EFlarePartSize::Type         PartSize;
+
+	bool                         IsStation;
+	bool                         IsMilitary;
+	bool                         IsDangerous;
+	bool                         IsStranded;
+	bool                         IsUncontrollable;
+	bool                         IsDisarmed;
+	bool                         IsHarpooned;
+};
+
+
+/** Alive ships of the active sector, with the state that target selection needs, shared by all pilots and turrets for a frame */
+class FFlareThreatTable
+{
+public:
+
+	FFlareThreatTable();
+
+	/*----------------------------------------------------
+		Build
+	----------------------------------------------------*/
+
+	/** Remove all entries */
+	void Reset();
+
+	/** Capture the alive ships of a sector, and the bombs targeting them */
+	void Build(UFlareSector* Sector);
+
+
+	/*----------------------------------------------------
+		Queries
+	----------------------------------------------------*/
+
+	/** Get the entries of the ships at war with Company */
+	const TArray<const FFlareThreatEntry*>& GetHostileThreats(const UFlareCompany* Company);
+
+	const TArray<FFlareThreatEntry>& GetEntries() const
+	{
+		return Entries;
+	}
+
+
+protected:
+
+	/*----------------------------------------------------
+		Data
+	----------------------------------------------------*/
+
+	TArray<FFlareThreatEntry>                  Entries;
+
+	// Per-company hostile entries, filled on demand
+	TArray<TArray<const FFlareThreatEntry*>>   CompanyThreats;
+	TArray<bool>                               CompanyThreatsValid;
+
+};
@@ -258,13 +258,25 @@ void UFlareTravel::GenerateTravelDuration()
 
 int64 UFlareTravel::ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, UFlareCompany* Company)
 {
-	int64 TravelDuration = 0;
-
 	if (OriginSector == DestinationSector)
 	{
 		return 0;
 	}
 
+	int64 TravelDuration = World->GetBaseTravelDuration(OriginSector, DestinationSector);
+
+	if(Company && Company->IsTechnologyUnlocked("fast-travel"))
+	{
+		TravelDuration /= 2;
+	}
+
+	return FMath::Max((int64) 2, TravelDuration+1);
+}
+
+int64 UFlareTravel::ComputeBaseTravelDuration(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector)
+{
+	int64 TravelDuration = 0;
+
 	double OriginAltitude;
 	double DestinationAltitude;
 	double OriginPhase;
@@ -296,12 +308,7 @@ int64 UFlareTravel::ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSec
 		TravelDuration = (UFlareGameTools::SECONDS_IN_DAY/2 + ComputeAltitudeTravelDuration(World, OriginCelestialBody, OriginAltitude, DestinationCelestialBody, DestinationAltitude)) / UFlareGameTools::SECONDS_IN_DAY;
 	}
 
-	if(Company && Company->IsTechnologyUnlocked("fast-travel"))
-	{
-		TravelDuration /= 2;
-	}
-
-	return FMath::Max((int64) 2, TravelDuration+1);
+	return TravelDuration;
 }
 
 double UFlareTravel::ComputeSphereOfInfluenceAltitude(UFlareWorld* World, FFlareCelestialBody* CelestialBody)
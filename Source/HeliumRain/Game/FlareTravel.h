@@ -78,8 +78,12 @@ public:
 
 	FFlareSectorOrbitParameters ComputeCurrentTravelLocation();
 
+	/** Get the travel duration in days, using the world travel duration matrix when possible */
 	static int64 ComputeTravelDuration(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector, UFlareCompany* Company);
 
+	/** Compute the orbital travel duration in days, before technology bonus */
+	static int64 ComputeBaseTravelDuration(UFlareWorld* World, UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector);
+
 	static int64 ComputePhaseTravelDuration(UFlareWorld* World, FFlareCelestialBody* CelestialBody, double Altitude, double OriginPhase, double DestinationPhase);
 
 	static int64 ComputeAltitudeTravelDuration(UFlareWorld* World, FFlareCelestialBody* OriginCelestialBody, double OriginAltitude, FFlareCelestialBody* DestinationCelestialBody, double DestinationAltitude);
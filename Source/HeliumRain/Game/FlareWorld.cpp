@@ -8,6 +8,9 @@
 #include "FlareFleet.h"
 #include "FlareBattle.h"
 
+#include "Async/ParallelFor.h"
+#include "../Economy/FlareCargoBay.h"
+
 #include "../Data/FlareSectorCatalogEntry.h"
 #include "../Player/FlarePlayerController.h"
 
@@ -21,6 +24,10 @@
 
 UFlareWorld::UFlareWorld(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, FastForwardActive(false)
+	, FastForwardStartDate(0)
+	, FastForwardEndDate(0)
+	, SerialAIPlanning(false)
 {
 }
 
@@ -96,6 +103,9 @@ void UFlareWorld::Load(const FFlareWorldSave& Data)
 		LoadSector(SectorDescription, *SectorSave, OrbitParameters);
 	}
 
+	// Sectors are static, travel durations too
+	ComputeTravelDurations();
+
 	// Load all travels
 	for (int32 i = 0; i < WorldData.TravelData.Num(); i++)
 	{
@@ -125,8 +135,9 @@ UFlareCompany* UFlareWorld::LoadCompany(const FFlareCompanySave& CompanyData)
 
     // Create the new company
 	Company = NewObject<UFlareCompany>(this, UFlareCompany::StaticClass(), CompanyData.Identifier);
+    Company->SetWorldIndex(Companies.AddUnique(Company));
     Company->Load(CompanyData);
-    Companies.AddUnique(Company);
+    UpdateHostilities();
 
 	//FLOGV("UFlareWorld::LoadCompany : loaded '%s'", *Company->GetCompanyName().ToString());
 
@@ -141,7 +152,7 @@ UFlareSimulatedSector* UFlareWorld::LoadSector(const FFlareSectorDescription* De
 	// Create the new sector
 	Sector = NewObject<UFlareSimulatedSector>(this, UFlareSimulatedSector::StaticClass(), SectorData.Identifier);
 	Sector->Load(Description, SectorData, OrbitParameters);
-	Sectors.AddUnique(Sector);
+	Sector->SetWorldIndex(Sectors.AddUnique(Sector));
 
 	//FLOGV("UFlareWorld::LoadSector : loaded '%s'", *Sector->GetSectorName().ToString());
 
@@ -149,6 +160,24 @@ UFlareSimulatedSector* UFlareWorld::LoadSector(const FFlareSectorDescription* De
 }
 
 
+void UFlareWorld::ComputeTravelDurations()
+{
+	int32 SectorCount = Sectors.Num();
+	TravelDurations.Empty(SectorCount * SectorCount);
+	TravelDurations.AddZeroed(SectorCount * SectorCount);
+
+	for (int32 OriginIndex = 0; OriginIndex < SectorCount; OriginIndex++)
+	{
+		for (int32 DestinationIndex = 0; DestinationIndex < SectorCount; DestinationIndex++)
+		{
+			if (OriginIndex != DestinationIndex)
+			{
+				TravelDurations[OriginIndex * SectorCount + DestinationIndex] = UFlareTravel::ComputeBaseTravelDuration(this, Sectors[OriginIndex], Sectors[DestinationIndex]);
+			}
+		}
+	}
+}
+
 UFlareTravel* UFlareWorld::LoadTravel(const FFlareTravelSave& TravelData)
 {
 	UFlareTravel* Travel = NULL;
@@ -412,6 +441,7 @@ bool UFlareWorld::CheckIntegrity()
 void UFlareWorld::Simulate()
 {
 	double StartTs = FPlatformTime::Seconds();
+	double PhaseTs = StartTs;
 	UFlareCompany* PlayerCompany = Game->GetPC()->GetCompany();
 	Game->GetPC()->MarkAsBusy();
 
@@ -419,6 +449,7 @@ void UFlareWorld::Simulate()
 	 *  End previous day
 	 */
 	FLOGV("** Simulate day %d", WorldData.Date);
+	SimulationTimings = FFlareSimulationTimings();
 
 	FLOG("* Simulate > Battles");
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
@@ -479,16 +510,70 @@ void UFlareWorld::Simulate()
 		}
 	}
 
+	SimulationTimings.Battles = FPlatformTime::Seconds() - PhaseTs;
+	PhaseTs = FPlatformTime::Seconds();
+
 	FLOG("* Simulate > AI");
 	// AI. Play them in random order
 	TArray<UFlareCompany*> CompaniesToSimulateAI = Companies;
+	TArray<UFlareCompany*> AIOrder;
 	while(CompaniesToSimulateAI.Num())
 	{
 		int32 Index = FMath::RandRange(0, CompaniesToSimulateAI.Num() - 1);
-		CompaniesToSimulateAI[Index]->SimulateAI();
+		AIOrder.Add(CompaniesToSimulateAI[Index]);
 		CompaniesToSimulateAI.RemoveAt(Index);
 	}
 
+	// Diplomacy comes first, so that plans see today's wars
+	for (UFlareCompany* Company : AIOrder)
+	{
+		Company->GetAI()->SimulateDiplomacy();
+	}
+
+	// Scan the world economy once for all companies
+	EconomySnapshot = WorldHelper::ComputeWorldEconomySnapshot(Game);
+
+	// AI planning only reads the world, and each company writes to its own AI : run them in parallel.
+	// Fill the lazy caches the planning reads here, to keep workers read-only.
+	Game->GetAINerfRatio();
+	for (UFlareSimulatedSector* Sector : Sectors)
+	{
+		for (UFlareResourceCatalogEntry* Resource : Game->GetResourceCatalog()->Resources)
+		{
+			Sector->GetPreciseResourcePrice(&Resource->Data);
+		}
+
+		for (UFlareSimulatedSpacecraft* Station : Sector->GetSectorStations())
+		{
+			for (UFlareFactory* Factory : Station->GetFactories())
+			{
+				Factory->GetCycleData();
+			}
+		}
+	}
+
+	TArray<UFlareCompanyAI*> PlanningAIs;
+	for (UFlareCompany* Company : Companies)
+	{
+		if (Company != PlayerCompany)
+		{
+			PlanningAIs.Add(Company->GetAI());
+		}
+	}
+
+	ParallelFor(PlanningAIs.Num(), [&](int32 AIIndex)
+	{
+		PlanningAIs[AIIndex]->Plan(EconomySnapshot);
+	}, SerialAIPlanning);
+
+	for (UFlareCompany* Company : AIOrder)
+	{
+		Company->SimulateAI();
+	}
+
+	// Don't keep references to spacecrafts that may be destroyed later
+	EconomySnapshot = WorldHelper::FlareWorldEconomySnapshot();
+
 	// Clear bombs
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
@@ -498,10 +583,13 @@ void UFlareWorld::Simulate()
 	CompanyMutualAssistance();
 	CheckIntegrity();
 
+	SimulationTimings.AI = FPlatformTime::Seconds() - PhaseTs;
+
 	/**
 	 *  Begin day
 	 */
 	FLOG("* Simulate > New day");
+	PhaseTs = FPlatformTime::Seconds();
 
 	WorldData.Date++;
 
@@ -530,23 +618,29 @@ void UFlareWorld::Simulate()
 	// Spacrecraft capture
 	ProcessShipCapture();
 	ProcessStationCapture();
+	SimulationTimings.NewDay = FPlatformTime::Seconds() - PhaseTs;
 
 	// Factories
 	FLOG("* Simulate > Factories");
+	PhaseTs = FPlatformTime::Seconds();
 	for (int FactoryIndex = 0; FactoryIndex < Factories.Num(); FactoryIndex++)
 	{
 		Factories[FactoryIndex]->Simulate();
 	}
+	SimulationTimings.Factories = FPlatformTime::Seconds() - PhaseTs;
 
 	// Peoples
 	FLOG("* Simulate > Peoples");
+	PhaseTs = FPlatformTime::Seconds();
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
 		Sectors[SectorIndex]->GetPeople()->Simulate();
 	}
+	SimulationTimings.People = FPlatformTime::Seconds() - PhaseTs;
 
 
 	FLOG("* Simulate > Trade routes");
+	PhaseTs = FPlatformTime::Seconds();
 
 	// Trade routes
 	for (int CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
@@ -558,22 +652,29 @@ void UFlareWorld::Simulate()
 			TradeRoutes[RouteIndex]->Simulate();
 		}
 	}
+	SimulationTimings.TradeRoutes = FPlatformTime::Seconds() - PhaseTs;
+
 	FLOG("* Simulate > Travels");
+	PhaseTs = FPlatformTime::Seconds();
 	// Travels
 	TArray<UFlareTravel*> TravelsToProcess = Travels;
 	for (int TravelIndex = 0; TravelIndex < TravelsToProcess.Num(); TravelIndex++)
 	{
 		TravelsToProcess[TravelIndex]->Simulate();
 	}
+	SimulationTimings.Travels = FPlatformTime::Seconds() - PhaseTs;
 
 	FLOG("* Simulate > Reputation");
+	PhaseTs = FPlatformTime::Seconds();
 	// Reputation stabilization
 	for (UFlareCompany* Company : Companies)
 	{
 		Company->GiveReputationToOthers(-Company->GetShame(), false);
 	}
+	SimulationTimings.Reputation = FPlatformTime::Seconds() - PhaseTs;
 
 	FLOG("* Simulate > Prices");
+	PhaseTs = FPlatformTime::Seconds();
 	// Price variation.
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
@@ -590,21 +691,27 @@ void UFlareWorld::Simulate()
 	{
 		Sectors[SectorIndex]->SwapPrices();
 	}
+	SimulationTimings.Prices = FPlatformTime::Seconds() - PhaseTs;
 	
 	// Update reserve ships
+	PhaseTs = FPlatformTime::Seconds();
 	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
 	{
 		Sectors[SectorIndex]->UpdateReserveShips();
 	}
+	SimulationTimings.ReserveShips = FPlatformTime::Seconds() - PhaseTs;
 
 	// Player being attacked ?
+	PhaseTs = FPlatformTime::Seconds();
 	ProcessIncomingPlayerEnemy();
 
 	// Lets AI check if in battle
 	CheckAIBattleState();
+	SimulationTimings.BattleChecks = FPlatformTime::Seconds() - PhaseTs;
 
 	
 	double EndTs = FPlatformTime::Seconds();
+	SimulationTimings.Total = EndTs - StartTs;
 	FLOGV("** Simulate day %d done in %.6fs", WorldData.Date-1, EndTs- StartTs);
 
 	Game->GetQuestManager()->OnNextDay();
@@ -954,6 +1061,53 @@ void UFlareWorld::FastForward()
 	Simulate();
 }
 
+void UFlareWorld::StartFastForward(int32 DayCount, UFlareCompany* PointOfView)
+{
+	FastForwardStartDate = WorldData.Date;
+	FastForwardEndDate = WorldData.Date + DayCount;
+
+	// Stop at the first event the company would want to see
+	TArray<FFlareWorldEvent> NextEvents = GenerateEvents(PointOfView);
+	for (int32 EventIndex = 0; EventIndex < NextEvents.Num(); EventIndex++)
+	{
+		if (NextEvents[EventIndex].Visibility == EFlareEventVisibility::Blocking && NextEvents[EventIndex].Date > WorldData.Date)
+		{
+			FastForwardEndDate = FMath::Min(FastForwardEndDate, NextEvents[EventIndex].Date);
+			break;
+		}
+	}
+
+	FLOGV("UFlareWorld::StartFastForward : from day %lld to day %lld", FastForwardStartDate, FastForwardEndDate);
+	FastForwardActive = (FastForwardEndDate > FastForwardStartDate);
+}
+
+bool UFlareWorld::TickFastForward(float TimeBudget)
+{
+	double StartTs = FPlatformTime::Seconds();
+
+	// Always simulate whole days so that the world is consistent between ticks
+	while (FastForwardActive)
+	{
+		FastForward();
+
+		if (WorldData.Date >= FastForwardEndDate)
+		{
+			FastForwardActive = false;
+		}
+		else if (FPlatformTime::Seconds() - StartTs > TimeBudget)
+		{
+			break;
+		}
+	}
+
+	return FastForwardActive;
+}
+
+void UFlareWorld::StopFastForward()
+{
+	FastForwardActive = false;
+}
+
 void UFlareWorld::ProcessIncomingPlayerEnemy()
 {
 	if (GetGame()->GetPC()->GetPlayerShip())
@@ -1074,11 +1228,14 @@ TArray<FFlareWorldEvent> UFlareWorld::GenerateEvents(UFlareCompany* PointOfView)
 {
 	TArray<FFlareWorldEvent> NextEvents;
 
-	// TODO Implements PointOfView
-
 	// Generate travel events
 	for (int TravelIndex = 0; TravelIndex < Travels.Num(); TravelIndex++)
 	{
+		if (PointOfView && Travels[TravelIndex]->GetFleet()->GetFleetCompany() != PointOfView)
+		{
+			continue;
+		}
+
 		FFlareWorldEvent TravelEvent;
 
 		TravelEvent.Date = WorldData.Date + Travels[TravelIndex]->GetRemainingTravelDuration();
@@ -1089,6 +1246,11 @@ TArray<FFlareWorldEvent> UFlareWorld::GenerateEvents(UFlareCompany* PointOfView)
 	// Generate factory events
 	for (int FactoryIndex = 0; FactoryIndex < Factories.Num(); FactoryIndex++)
 	{
+		if (PointOfView && Factories[FactoryIndex]->GetParent()->GetCompany() != PointOfView)
+		{
+			continue;
+		}
+
 		FFlareWorldEvent *FactoryEvent = Factories[FactoryIndex]->GenerateEvent();
 		if (FactoryEvent)
 		{
@@ -1123,6 +1285,80 @@ void UFlareWorld::OnFleetSupplyConsumed(int32 Quantity)
 	WorldData.DailyFleetSupplyConsumption += Quantity;
 }
 
+void UFlareWorld::InvalidateBattleStates()
+{
+	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+	{
+		Sectors[SectorIndex]->InvalidateBattleStates();
+	}
+
+	for (int TravelIndex = 0; TravelIndex < Travels.Num(); TravelIndex++)
+	{
+		Travels[TravelIndex]->GetTravelSector()->InvalidateBattleStates();
+	}
+}
+
+void UFlareWorld::UpdateHostilities()
+{
+	int32 CompanyCount = Companies.Num();
+
+	HostilityMatrix.SetNum(CompanyCount);
+	WarMatrix.SetNum(CompanyCount);
+
+	for (int32 CompanyIndex = 0; CompanyIndex < CompanyCount; CompanyIndex++)
+	{
+		HostilityMatrix[CompanyIndex].Init(false, CompanyCount);
+		WarMatrix[CompanyIndex].Init(false, CompanyCount);
+	}
+
+	TMap<FName, UFlareCompany*> CompaniesByIdentifier;
+	for (int32 CompanyIndex = 0; CompanyIndex < CompanyCount; CompanyIndex++)
+	{
+		CompaniesByIdentifier.Add(Companies[CompanyIndex]->GetIdentifier(), Companies[CompanyIndex]);
+	}
+
+	// Hostile companies may be listed before they are loaded
+	for (int32 CompanyIndex = 0; CompanyIndex < CompanyCount; CompanyIndex++)
+	{
+		const TArray<FName>& HostileCompanies = Companies[CompanyIndex]->GetHostileCompanies();
+		for (int32 HostileIndex = 0; HostileIndex < HostileCompanies.Num(); HostileIndex++)
+		{
+			UFlareCompany** HostileCompany = CompaniesByIdentifier.Find(HostileCompanies[HostileIndex]);
+			if (HostileCompany && *HostileCompany != Companies[CompanyIndex])
+			{
+				SetHostility(Companies[CompanyIndex], *HostileCompany, true);
+			}
+		}
+	}
+}
+
+bool UFlareWorld::IsHostile(const UFlareCompany* Source, const UFlareCompany* Target) const
+{
+	return HostilityMatrix[Source->GetWorldIndex()][Target->GetWorldIndex()];
+}
+
+bool UFlareWorld::IsAtWar(const UFlareCompany* Source, const UFlareCompany* Target) const
+{
+	return WarMatrix[Source->GetWorldIndex()][Target->GetWorldIndex()];
+}
+
+const TBitArray<>& UFlareWorld::GetWarMask(const UFlareCompany* Company) const
+{
+	return WarMatrix[Company->GetWorldIndex()];
+}
+
+void UFlareWorld::SetHostility(const UFlareCompany* Source, const UFlareCompany* Target, bool Hostile)
+{
+	int32 SourceIndex = Source->GetWorldIndex();
+	int32 TargetIndex = Target->GetWorldIndex();
+
+	HostilityMatrix[SourceIndex][TargetIndex] = Hostile;
+
+	bool AtWar = Hostile || HostilityMatrix[TargetIndex][SourceIndex];
+	WarMatrix[SourceIndex][TargetIndex] = AtWar;
+	WarMatrix[TargetIndex][SourceIndex] = AtWar;
+}
+
 UFlareTravel* UFlareWorld::	StartTravel(UFlareFleet* TravelingFleet, UFlareSimulatedSector* DestinationSector, bool Force)
 {
 	if (!TravelingFleet->CanTravel() && !Force)
@@ -1257,6 +1493,21 @@ UFlareSimulatedSector* UFlareWorld::FindSector(FName Identifier) const
 	return NULL;
 }
 
+int64 UFlareWorld::GetBaseTravelDuration(UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector)
+{
+	int32 SectorCount = Sectors.Num();
+	int32 OriginIndex = OriginSector->GetWorldIndex();
+	int32 DestinationIndex = DestinationSector->GetWorldIndex();
+
+	if (OriginIndex != INDEX_NONE && DestinationIndex != INDEX_NONE && TravelDurations.Num() == SectorCount * SectorCount)
+	{
+		return TravelDurations[OriginIndex * SectorCount + DestinationIndex];
+	}
+
+	// Sector outside of the world, like a travel sector
+	return UFlareTravel::ComputeBaseTravelDuration(this, OriginSector, DestinationSector);
+}
+
 UFlareSimulatedSector* UFlareWorld::FindSectorBySpacecraft(FName SpacecraftIdentifier) const
 {
 	for (int i = 0; i < Sectors.Num(); i++)
@@ -1369,6 +1620,52 @@ int64 UFlareWorld::GetWorldMoney()
 	return WorldMoney;
 }
 
+uint32 UFlareWorld::GetWorldChecksum()
+{
+	uint32 Checksum = 0;
+
+	Checksum = FCrc::MemCrc32(&WorldData.Date, sizeof(WorldData.Date), Checksum);
+
+	for (int CompanyIndex = 0; CompanyIndex < Companies.Num(); CompanyIndex++)
+	{
+		UFlareCompany* Company = Companies[CompanyIndex];
+		int64 Money = Company->GetMoney();
+		int32 SpacecraftCount = Company->GetCompanySpacecrafts().Num();
+
+		Checksum = FCrc::MemCrc32(&Money, sizeof(Money), Checksum);
+		Checksum = FCrc::MemCrc32(&SpacecraftCount, sizeof(SpacecraftCount), Checksum);
+
+		for (int32 SpacecraftIndex = 0; SpacecraftIndex < Company->GetCompanySpacecrafts().Num(); SpacecraftIndex++)
+		{
+			TArray<FFlareCargo>& CargoBaySlots = Company->GetCompanySpacecrafts()[SpacecraftIndex]->GetCargoBay()->GetSlots();
+			for (int32 CargoIndex = 0; CargoIndex < CargoBaySlots.Num(); CargoIndex++)
+			{
+				int32 Quantity = CargoBaySlots[CargoIndex].Quantity;
+				Checksum = FCrc::MemCrc32(&Quantity, sizeof(Quantity), Checksum);
+			}
+		}
+	}
+
+	for (int SectorIndex = 0; SectorIndex < Sectors.Num(); SectorIndex++)
+	{
+		UFlareSimulatedSector* Sector = Sectors[SectorIndex];
+		uint32 Population = Sector->GetPeople()->GetPopulation();
+		int64 PeopleMoney = Sector->GetPeople()->GetMoney();
+
+		Checksum = FCrc::MemCrc32(&Population, sizeof(Population), Checksum);
+		Checksum = FCrc::MemCrc32(&PeopleMoney, sizeof(PeopleMoney), Checksum);
+
+		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->Resources.Num(); ResourceIndex++)
+		{
+			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->Resources[ResourceIndex]->Data;
+			float Price = Sector->GetPreciseResourcePrice(Resource);
+			Checksum = FCrc::MemCrc32(&Price, sizeof(Price), Checksum);
+		}
+	}
+
+	return Checksum;
+}
+
 uint32 UFlareWorld::GetWorldPopulation()
 {
 	uint32 WorldPopulation = 0;
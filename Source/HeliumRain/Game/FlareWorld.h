@@ -4,6 +4,7 @@
 #include "Object.h"
 #include "FlareGameTypes.h"
 #include "FlareTravel.h"
+#include "FlareWorldHelper.h"
 #include "Planetarium/FlareSimulatedPlanetarium.h"
 #include "FlareWorld.generated.h"
 
@@ -57,13 +58,46 @@ struct FFlareWorldSave
 	TArray<FFlareTravelSave> TravelData;
 
 	UPROPERTY(VisibleAnywhere, Category = Save)
-	FFlareFloatBuffer FleetSupplyConsumptionStats;
+	FFlareTimeSeries FleetSupplyConsumptionStats;
 
 	UPROPERTY(VisibleAnywhere, Category = Save)
 	int32 DailyFleetSupplyConsumption;
 };
 
 
+/** Time spent in each phase of a simulated day, in seconds */
+struct FFlareSimulationTimings
+{
+	double Battles;
+	double AI;
+	double NewDay;
+	double Factories;
+	double People;
+	double TradeRoutes;
+	double Travels;
+	double Reputation;
+	double Prices;
+	double ReserveShips;
+	double BattleChecks;
+	double Total;
+
+	FFlareSimulationTimings()
+		: Battles(0)
+		, AI(0)
+		, NewDay(0)
+		, Factories(0)
+		, People(0)
+		, TradeRoutes(0)
+		, Travels(0)
+		, Reputation(0)
+		, Prices(0)
+		, ReserveShips(0)
+		, BattleChecks(0)
+		, Total(0)
+	{}
+};
+
+
 /** World event data */
 USTRUCT()
 struct FFlareWorldEvent
@@ -105,6 +139,9 @@ public:
 
 	UFlareTravel* LoadTravel(const FFlareTravelSave& TravelData);
 
+	/** Precompute the travel duration between all sectors */
+	void ComputeTravelDurations();
+
 	/*----------------------------------------------------
 		Gameplay
 	----------------------------------------------------*/
@@ -129,6 +166,15 @@ public:
 	/** Simulate world from now to the next event */
 	void FastForward();
 
+	/** Start simulating up to DayCount days, stopping early at the next blocking event for PointOfView */
+	void StartFastForward(int32 DayCount, UFlareCompany* PointOfView);
+
+	/** Simulate whole days until the time budget is spent. Return false once the fast forward is over */
+	bool TickFastForward(float TimeBudget);
+
+	/** Stop the fast forward at the end of the current day */
+	void StopFastForward();
+
 	UFlareTravel* StartTravel(UFlareFleet* TravelingFleet, UFlareSimulatedSector* DestinationSector, bool Force=false);
 
 	virtual void DeleteTravel(UFlareTravel* Travel);
@@ -147,6 +193,21 @@ public:
 
 	void OnFleetSupplyConsumed(int32 Quantity);
 
+	/** Forget the cached battle states of all sectors, after a change in war state */
+	void InvalidateBattleStates();
+
+	/** Rebuild the hostility matrix from the hostile company lists */
+	void UpdateHostilities();
+
+	/** Set the hostility of Source toward Target in the hostility matrix */
+	void SetHostility(const UFlareCompany* Source, const UFlareCompany* Target, bool Hostile);
+
+	/** Plan company AIs on the game thread only, instead of in parallel */
+	void SetSerialAIPlanning(bool NewSerialAIPlanning)
+	{
+		SerialAIPlanning = NewSerialAIPlanning;
+	}
+
 protected:
 
 	/*----------------------------------------------------
@@ -171,13 +232,36 @@ protected:
 	UPROPERTY()
 	TArray<UFlareTravel*>                Travels;
 
+	/** Base travel durations, indexed by origin and destination sector world indexes */
+	TArray<int64>                        TravelDurations;
+
+	/** Hostility of each company toward the others, indexed by company world indexes */
+	TArray<TBitArray<>>                  HostilityMatrix;
+
+	/** Companies at war with each company, in either direction */
+	TArray<TBitArray<>>                  WarMatrix;
+
 	UPROPERTY()
 	UFlareSimulatedPlanetarium*			Planetarium;
 
 	AFlareGame*                             Game;
 
+	/** Economic state shared by the company AIs, valid during the AI phase only */
+	WorldHelper::FlareWorldEconomySnapshot  EconomySnapshot;
+
 	bool WorldMoneyReferenceInit;
 
+	/** Phase timings of the last simulated day */
+	FFlareSimulationTimings                 SimulationTimings;
+
+	/** Plan company AIs on the game thread only, to check that parallel plans are the same */
+	bool                                    SerialAIPlanning;
+
+	// Fast forward
+	bool                                    FastForwardActive;
+	int64                                   FastForwardStartDate;
+	int64                                   FastForwardEndDate;
+
 public:
 	int64 WorldMoneyReference;
 
@@ -218,12 +302,37 @@ public:
 		return WorldData.Date;
 	}
 
+	inline const FFlareSimulationTimings& GetLastSimulationTimings() const
+	{
+		return SimulationTimings;
+	}
+
+	inline bool IsFastForwarding() const
+	{
+		return FastForwardActive;
+	}
+
+	/** Get the number of days simulated by the current fast forward, and its maximum */
+	inline void GetFastForwardProgress(int64& SimulatedDays, int64& TotalDays) const
+	{
+		SimulatedDays = WorldData.Date - FastForwardStartDate;
+		TotalDays = FastForwardEndDate - FastForwardStartDate;
+	}
+
+	inline const WorldHelper::FlareWorldEconomySnapshot& GetEconomySnapshot() const
+	{
+		return EconomySnapshot;
+	}
+
 	UFlareCompany* FindCompany(FName Identifier) const;
 
 	UFlareCompany* FindCompanyByShortName(FName CompanyShortName) const;
 
 	UFlareSimulatedSector* FindSector(FName Identifier) const;
 
+	/** Get the travel duration between two sectors, before technology bonus */
+	int64 GetBaseTravelDuration(UFlareSimulatedSector* OriginSector, UFlareSimulatedSector* DestinationSector);
+
 	UFlareSimulatedSector* FindSectorBySpacecraft(FName SpacecraftIdentifier) const;
 
 	UFlareFleet* FindFleet(FName Identifier) const;
@@ -237,8 +346,20 @@ public:
 		return Companies;
 	}
 
+	/** Check if Source is hostile to Target */
+	bool IsHostile(const UFlareCompany* Source, const UFlareCompany* Target) const;
+
+	/** Check if either company is hostile to the other */
+	bool IsAtWar(const UFlareCompany* Source, const UFlareCompany* Target) const;
+
+	/** Get the companies at war with a company, indexed by company world index */
+	const TBitArray<>& GetWarMask(const UFlareCompany* Company) const;
+
 	int64 GetWorldMoney();
 
 	uint32 GetWorldPopulation();
 
+	/** Get a checksum of the world economy, to compare simulation results */
+	uint32 GetWorldChecksum();
+
 };
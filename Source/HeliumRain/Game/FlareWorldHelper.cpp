@@ -4,6 +4,8 @@
 #include "FlareWorld.h"
 #include "../Economy/FlareCargoBay.h"
 #include "FlareSimulatedSector.h"
+#include "FlareSectorHelper.h"
+#include "FlareCompany.h"
 #include "../Spacecrafts/FlareSimulatedSpacecraft.h"
 #include "FlareScenarioTools.h"
 
@@ -110,7 +112,7 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldHelper::C
 	// FS
 	FFlareResourceDescription* FleetSupply = Game->GetScenarioTools()->FleetSupply;
 	WorldHelper::FlareResourceStats *FSResourceStats = &WorldStats[FleetSupply];
-	FFlareFloatBuffer* Stats = &Game->GetGameWorld()->GetData()->FleetSupplyConsumptionStats;
+	FFlareTimeSeries* Stats = &Game->GetGameWorld()->GetData()->FleetSupplyConsumptionStats;
 	float MeanConsumption = Stats->GetMean(0, Stats->MaxSize-1);
 	FSResourceStats->Consumption = MeanConsumption;
 
@@ -134,3 +136,140 @@ TMap<FFlareResourceDescription*, WorldHelper::FlareResourceStats> WorldHelper::C
 
 	return WorldStats;
 }
+
+WorldHelper::FlareWorldEconomySnapshot WorldHelper::ComputeWorldEconomySnapshot(AFlareGame* Game)
+{
+	FlareWorldEconomySnapshot Snapshot;
+	UFlareWorld* World = Game->GetGameWorld();
+
+	Snapshot.WorldStats = ComputeWorldResourceStats(Game);
+
+	for (int SectorIndex = 0; SectorIndex < World->GetSectors().Num(); SectorIndex++)
+	{
+		UFlareSimulatedSector* Sector = World->GetSectors()[SectorIndex];
+		FlareSectorEconomySnapshot& SectorSnapshot = Snapshot.Sectors.Add(Sector);
+
+		// Stations
+		for (int32 StationIndex = 0; StationIndex < Sector->GetSectorStations().Num(); StationIndex++)
+		{
+			UFlareSimulatedSpacecraft* Station = Sector->GetSectorStations()[StationIndex];
+			FlareStationFlow StationFlow;
+			StationFlow.Station = Station;
+
+			TArray<UFlareFactory*>& Factories = Station->GetFactories();
+			for (int32 FactoryIndex = 0; FactoryIndex < Factories.Num(); FactoryIndex++)
+			{
+				if (Factories[FactoryIndex]->IsShipyard())
+				{
+					SectorSnapshot.Shipyards.Add(Station);
+					break;
+				}
+			}
+
+			for (int32 FactoryIndex = 0; FactoryIndex < Factories.Num(); FactoryIndex++)
+			{
+				UFlareFactory* Factory = Factories[FactoryIndex];
+				if ((!Factory->IsActive() || !Factory->IsNeedProduction()))
+				{
+					// No resources needed
+					break;
+				}
+
+				int64 ProductionDuration = Factory->GetProductionDuration();
+				if (ProductionDuration == 0)
+				{
+					ProductionDuration = 10;
+				}
+
+				// Input flow
+				for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetInputResourcesCount(); ResourceIndex++)
+				{
+					int32 Flow = Factory->GetInputResourceQuantity(ResourceIndex) / ProductionDuration;
+					FFlareResourceDescription* Resource = Factory->GetInputResource(ResourceIndex);
+					StationFlow.Flow.Add(Resource, StationFlow.Flow.FindRef(Resource) - Flow);
+				}
+
+				// Ouput flow
+				for (int32 ResourceIndex = 0; ResourceIndex < Factory->GetOutputResourcesCount(); ResourceIndex++)
+				{
+					int32 Flow = Factory->GetOutputResourceQuantity(ResourceIndex) / ProductionDuration;
+					FFlareResourceDescription* Resource = Factory->GetOutputResource(ResourceIndex);
+					StationFlow.Flow.Add(Resource, StationFlow.Flow.FindRef(Resource) + Flow);
+				}
+			}
+
+			SectorSnapshot.StationFlows.Add(StationFlow);
+		}
+
+		// Population
+		for (int32 ResourceIndex = 0; ResourceIndex < Game->GetResourceCatalog()->ConsumerResources.Num(); ResourceIndex++)
+		{
+			FFlareResourceDescription* Resource = &Game->GetResourceCatalog()->ConsumerResources[ResourceIndex]->Data;
+			int32 Consumption = Sector->GetPeople()->GetRessourceConsumption(Resource, false);
+			SectorSnapshot.PeopleConsumption.Add(Resource, Consumption);
+		}
+
+		// Fleet supply needs
+		for (int CompanyIndex = 0; CompanyIndex < World->GetCompanies().Num(); CompanyIndex++)
+		{
+			UFlareCompany* Company = World->GetCompanies()[CompanyIndex];
+
+			int32 NeededFS;
+			int32 TotalNeededFS;
+			int64 MaxDuration;
+			int32 FleetSupplyNeeds = 0;
+
+			SectorHelper::GetRefillFleetSupplyNeeds(Sector, Company, NeededFS, TotalNeededFS, MaxDuration);
+			FleetSupplyNeeds += TotalNeededFS;
+
+			SectorHelper::GetRepairFleetSupplyNeeds(Sector, Company, NeededFS, TotalNeededFS, MaxDuration);
+			FleetSupplyNeeds += TotalNeededFS;
+
+			SectorSnapshot.FleetSupplyNeeds.Add(Company, FleetSupplyNeeds);
+		}
+
+		SectorSnapshot.IncomingCapacity = 0;
+	}
+
+	// Incoming capacity and resources
+	for (int32 TravelIndex = 0; TravelIndex < World->GetTravels().Num(); TravelIndex++)
+	{
+		UFlareTravel* Travel = World->GetTravels()[TravelIndex];
+		FlareSectorEconomySnapshot* SectorSnapshot = Snapshot.Sectors.Find(Travel->GetDestinationSector());
+		if (!SectorSnapshot)
+		{
+			continue;
+		}
+
+		int64 RemainingTravelDuration = FMath::Max((int64) 1, Travel->GetRemainingTravelDuration());
+		UFlareFleet* IncomingFleet = Travel->GetFleet();
+
+		for (int32 ShipIndex = 0; ShipIndex < IncomingFleet->GetShips().Num(); ShipIndex++)
+		{
+			UFlareSimulatedSpacecraft* Ship = IncomingFleet->GetShips()[ShipIndex];
+
+			if (Ship->GetCargoBay()->GetSlotCapacity() == 0 && Ship->GetDamageSystem()->IsStranded())
+			{
+				continue;
+			}
+			SectorSnapshot->IncomingCapacity += Ship->GetCargoBay()->GetCapacity() / RemainingTravelDuration;
+
+			TArray<FFlareCargo>& CargoBaySlots = Ship->GetCargoBay()->GetSlots();
+			for (int32 CargoIndex = 0; CargoIndex < CargoBaySlots.Num(); CargoIndex++)
+			{
+				FFlareCargo& Cargo = CargoBaySlots[CargoIndex];
+
+				if (!Cargo.Resource)
+				{
+					continue;
+				}
+
+				int32 IncomingResources = SectorSnapshot->IncomingResources.FindRef(Cargo.Resource);
+				IncomingResources += Cargo.Quantity / (RemainingTravelDuration * 0.5);
+				SectorSnapshot->IncomingResources.Add(Cargo.Resource, IncomingResources);
+			}
+		}
+	}
+
+	return Snapshot;
+}
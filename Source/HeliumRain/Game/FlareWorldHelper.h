@@ -1,6 +1,10 @@
 #pragma once
 #include "../Economy/FlareResource.h"
-#include "FlareWorld.h"
+
+class AFlareGame;
+class UFlareCompany;
+class UFlareSimulatedSector;
+class UFlareSimulatedSpacecraft;
 
 struct WorldHelper
 {
@@ -12,8 +16,45 @@ struct WorldHelper
 		int32 Stock;
 	};
 
+	/** Daily factory flow of a station, as used for the world resource flow */
+	struct FlareStationFlow
+	{
+		UFlareSimulatedSpacecraft* Station;
+		TMap<FFlareResourceDescription*, int32> Flow;
+	};
+
+	/** Company-independent economic state of a sector */
+	struct FlareSectorEconomySnapshot
+	{
+		/** All stations of the sector, in sector order */
+		TArray<FlareStationFlow> StationFlows;
+
+		/** Stations with at least one shipyard factory */
+		TArray<UFlareSimulatedSpacecraft*> Shipyards;
+
+		/** Cargo capacity and resources of the fleets travelling to this sector */
+		int32 IncomingCapacity;
+		TMap<FFlareResourceDescription*, int32> IncomingResources;
+
+		/** Daily consumption of consumer resources by the population */
+		TMap<FFlareResourceDescription*, int32> PeopleConsumption;
+
+		/** Fleet supply needed to fully repair and refill each company's ships */
+		TMap<UFlareCompany*, int32> FleetSupplyNeeds;
+	};
+
+	/** World economic state shared by all companies during the AI phase of a day */
+	struct FlareWorldEconomySnapshot
+	{
+		TMap<FFlareResourceDescription*, FlareResourceStats> WorldStats;
+		TMap<UFlareSimulatedSector*, FlareSectorEconomySnapshot> Sectors;
+	};
+
 	static TMap<FFlareResourceDescription*, FlareResourceStats> ComputeWorldResourceStats(AFlareGame* Game);
 
+	/** Walk the whole world once to build the economic snapshot read by the company AIs */
+	static FlareWorldEconomySnapshot ComputeWorldEconomySnapshot(AFlareGame* Game);
+
 
 private:
 
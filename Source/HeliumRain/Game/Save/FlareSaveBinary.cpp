@@ -0,0 +1,547 @@
+
+#include "../../Flare.h"
+#include "FlareSaveBinary.h"
+
+
+/*----------------------------------------------------
+	Interface
+----------------------------------------------------*/
+
+void FFlareSaveBinary::Write(TSharedRef<FJsonObject> Object, TArray<uint8>& Data)
+{
+	// Encode the tree first to build the string table
+	TArray<uint8> Body;
+	TMap<FString, int32> Strings;
+	FMemoryWriter BodyWriter(Body);
+	for (auto& Field : Object->Values)
+	{
+		uint32 KeyIndex = AddString(Field.Key, Strings);
+		BodyWriter.SerializeIntPacked(KeyIndex);
+		WriteValue(BodyWriter, Field.Value, Strings);
+	}
+
+	WriteFile(Strings, Object->Values.Num(), Body, Data);
+}
+
+TSharedPtr<FJsonObject> FFlareSaveBinary::Read(const TArray<uint8>& Data)
+{
+	if (!IsBinarySave(Data))
+	{
+		FLOG("FFlareSaveBinary::Read : invalid header");
+		return NULL;
+	}
+
+	FMemoryReader Reader(Data);
+	uint32 FileMagic;
+	uint32 FileVersion;
+	Reader << FileMagic;
+	Reader << FileVersion;
+
+	if (FileVersion > Version)
+	{
+		FLOGV("FFlareSaveBinary::Read : unsupported version %u", FileVersion);
+		return NULL;
+	}
+
+	// String table
+	uint32 StringCount;
+	Reader.SerializeIntPacked(StringCount);
+	if (Reader.IsError() || StringCount > (uint32)(Reader.TotalSize() - Reader.Tell()))
+	{
+		FLOG("FFlareSaveBinary::Read : invalid string table");
+		return NULL;
+	}
+
+	TArray<FString> Strings;
+	Strings.SetNum(StringCount);
+	for (uint32 StringIndex = 0; StringIndex < StringCount && !Reader.IsError(); StringIndex++)
+	{
+		Reader << Strings[StringIndex];
+	}
+
+	// Tree
+	TSharedPtr<FJsonObject> Object = ReadObject(Reader, Strings, 0);
+	if (Reader.IsError() || !Object.IsValid())
+	{
+		FLOG("FFlareSaveBinary::Read : corrupted data");
+		return NULL;
+	}
+
+	return Object;
+}
+
+bool FFlareSaveBinary::IsBinarySave(const TArray<uint8>& Data)
+{
+	if (Data.Num() < (int32)(2 * sizeof(uint32)))
+	{
+		return false;
+	}
+
+	uint32 FileMagic;
+	FMemoryReader Reader(Data);
+	Reader << FileMagic;
+	return FileMagic == Magic;
+}
+
+
+/*----------------------------------------------------
+	Internal
+----------------------------------------------------*/
+
+void FFlareSaveBinary::WriteFile(const TMap<FString, int32>& Strings, uint32 RootCount, const TArray<uint8>& RootBody, TArray<uint8>& Data)
+{
+	TArray<FString> StringTable;
+	StringTable.SetNum(Strings.Num());
+	for (auto& Entry : Strings)
+	{
+		StringTable[Entry.Value] = Entry.Key;
+	}
+
+	// Header, string table, tree
+	FMemoryWriter Writer(Data);
+	uint32 FileMagic = Magic;
+	uint32 FileVersion = Version;
+	uint32 StringCount = StringTable.Num();
+	Writer << FileMagic;
+	Writer << FileVersion;
+	Writer.SerializeIntPacked(StringCount);
+	for (int32 StringIndex = 0; StringIndex < StringTable.Num(); StringIndex++)
+	{
+		Writer << StringTable[StringIndex];
+	}
+	Writer.SerializeIntPacked(RootCount);
+	Writer.Serialize((void*) RootBody.GetData(), RootBody.Num());
+}
+
+void FFlareSaveBinary::SerializeInt64Packed(FArchive& Ar, int64& Value)
+{
+	// Zigzag encoding, seven bits per byte
+	if (Ar.IsLoading())
+	{
+		uint64 Encoded = 0;
+		uint8 Byte = 0;
+		int32 Shift = 0;
+		do
+		{
+			Ar << Byte;
+			Encoded |= (uint64)(Byte & 0x7F) << Shift;
+			Shift += 7;
+		}
+		while ((Byte & 0x80) && Shift < 64 && !Ar.IsError());
+
+		Value = (int64)(Encoded >> 1) ^ -(int64)(Encoded & 1);
+	}
+	else
+	{
+		uint64 Encoded = ((uint64)Value << 1) ^ (uint64)(Value >> 63);
+		do
+		{
+			uint8 Byte = Encoded & 0x7F;
+			Encoded >>= 7;
+			if (Encoded)
+			{
+				Byte |= 0x80;
+			}
+			Ar << Byte;
+		}
+		while (Encoded);
+	}
+}
+
+void FFlareSaveBinary::WriteValue(FArchive& Ar, const TSharedPtr<FJsonValue>& Value, TMap<FString, int32>& Strings)
+{
+	uint8 Tag;
+
+	switch (Value.IsValid() ? Value->Type : EJson::Null)
+	{
+		case EJson::Boolean:
+			Tag = Value->AsBool() ? TAG_True : TAG_False;
+			Ar << Tag;
+			break;
+
+		case EJson::Number:
+		{
+			double Number = Value->AsNumber();
+			float SingleNumber = Number;
+			if ((double) SingleNumber == Number)
+			{
+				Tag = TAG_Float;
+				Ar << Tag;
+				Ar << SingleNumber;
+			}
+			else
+			{
+				Tag = TAG_Double;
+				Ar << Tag;
+				Ar << Number;
+			}
+			break;
+		}
+
+		case EJson::String:
+		{
+			// Most numbers are saved as strings, pack them when the conversion is lossless
+			FString String = Value->AsString();
+			if (IsIntString(String))
+			{
+				int64 Integer = FCString::Atoi64(*String);
+				Tag = TAG_IntString;
+				Ar << Tag;
+				SerializeInt64Packed(Ar, Integer);
+			}
+			else
+			{
+				uint32 StringIndex = AddString(String, Strings);
+				Tag = TAG_String;
+				Ar << Tag;
+				Ar.SerializeIntPacked(StringIndex);
+			}
+			break;
+		}
+
+		case EJson::Array:
+		{
+			const TArray<TSharedPtr<FJsonValue>>& Array = Value->AsArray();
+			uint32 Count = Array.Num();
+			Tag = TAG_Array;
+			Ar << Tag;
+			Ar.SerializeIntPacked(Count);
+			for (int32 Index = 0; Index < Array.Num(); Index++)
+			{
+				WriteValue(Ar, Array[Index], Strings);
+			}
+			break;
+		}
+
+		case EJson::Object:
+			Tag = TAG_Object;
+			Ar << Tag;
+			WriteObject(Ar, Value->AsObject(), Strings);
+			break;
+
+		default:
+			Tag = TAG_Null;
+			Ar << Tag;
+			break;
+	}
+}
+
+void FFlareSaveBinary::WriteObject(FArchive& Ar, const TSharedPtr<FJsonObject>& Object, TMap<FString, int32>& Strings)
+{
+	uint32 Count = Object.IsValid() ? Object->Values.Num() : 0;
+	Ar.SerializeIntPacked(Count);
+
+	if (Object.IsValid())
+	{
+		for (auto& Field : Object->Values)
+		{
+			uint32 KeyIndex = AddString(Field.Key, Strings);
+			Ar.SerializeIntPacked(KeyIndex);
+			WriteValue(Ar, Field.Value, Strings);
+		}
+	}
+}
+
+int32 FFlareSaveBinary::AddString(const FString& String, TMap<FString, int32>& Strings)
+{
+	int32* Index = Strings.Find(String);
+	if (Index)
+	{
+		return *Index;
+	}
+
+	return Strings.Add(String, Strings.Num());
+}
+
+bool FFlareSaveBinary::IsIntString(const FString& String)
+{
+	// Only accept the canonical "%lld" form so that reading gives back the same string
+	const TCHAR* Chars = *String;
+	int32 Length = String.Len();
+	int32 Start = (Length > 0 && Chars[0] == '-') ? 1 : 0;
+	int32 DigitCount = Length - Start;
+
+	if (DigitCount < 1 || DigitCount > 18)
+	{
+		return false;
+	}
+	else if (Chars[Start] == '0' && (DigitCount > 1 || Start == 1))
+	{
+		return false;
+	}
+
+	for (int32 Index = Start; Index < Length; Index++)
+	{
+		if (Chars[Index] < '0' || Chars[Index] > '9')
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+TSharedPtr<FJsonValue> FFlareSaveBinary::ReadValue(FArchive& Ar, const TArray<FString>& Strings, int32 Depth)
+{
+	uint8 Tag = TAG_Null;
+	Ar << Tag;
+
+	switch (Tag)
+	{
+		case TAG_Null:
+			return MakeShareable(new FJsonValueNull());
+
+		case TAG_False:
+		case TAG_True:
+			return MakeShareable(new FJsonValueBoolean(Tag == TAG_True));
+
+		case TAG_Float:
+		{
+			float Number = 0;
+			Ar << Number;
+			return MakeShareable(new FJsonValueNumber(Number));
+		}
+
+		case TAG_Double:
+		{
+			double Number = 0;
+			Ar << Number;
+			return MakeShareable(new FJsonValueNumber(Number));
+		}
+
+		case TAG_String:
+		{
+			FString String;
+			if (!ReadStringIndex(Ar, Strings, String))
+			{
+				return NULL;
+			}
+			return MakeShareable(new FJsonValueString(String));
+		}
+
+		case TAG_IntString:
+		{
+			int64 Integer = 0;
+			SerializeInt64Packed(Ar, Integer);
+			return MakeShareable(new FJsonValueString(FString::Printf(TEXT("%lld"), Integer)));
+		}
+
+		case TAG_Array:
+		{
+			uint32 Count = 0;
+			Ar.SerializeIntPacked(Count);
+			if (Ar.IsError() || Depth >= MaxDepth || Count > (uint32)(Ar.TotalSize() - Ar.Tell()))
+			{
+				return NULL;
+			}
+
+			TArray<TSharedPtr<FJsonValue>> Array;
+			Array.Reserve(Count);
+			for (uint32 Index = 0; Index < Count; Index++)
+			{
+				TSharedPtr<FJsonValue> Item = ReadValue(Ar, Strings, Depth + 1);
+				if (!Item.IsValid())
+				{
+					return NULL;
+				}
+				Array.Add(Item);
+			}
+			return MakeShareable(new FJsonValueArray(Array));
+		}
+
+		case TAG_Object:
+		{
+			TSharedPtr<FJsonObject> Object = ReadObject(Ar, Strings, Depth + 1);
+			if (!Object.IsValid())
+			{
+				return NULL;
+			}
+			return MakeShareable(new FJsonValueObject(Object));
+		}
+
+		default:
+			FLOGV("FFlareSaveBinary::ReadValue : unknown tag %d", Tag);
+			return NULL;
+	}
+}
+
+TSharedPtr<FJsonObject> FFlareSaveBinary::ReadObject(FArchive& Ar, const TArray<FString>& Strings, int32 Depth)
+{
+	uint32 Count = 0;
+	Ar.SerializeIntPacked(Count);
+	if (Ar.IsError() || Depth >= MaxDepth || Count > (uint32)(Ar.TotalSize() - Ar.Tell()))
+	{
+		return NULL;
+	}
+
+	TSharedPtr<FJsonObject> Object = MakeShareable(new FJsonObject());
+	for (uint32 Index = 0; Index < Count; Index++)
+	{
+		FString Key;
+		if (!ReadStringIndex(Ar, Strings, Key))
+		{
+			return NULL;
+		}
+
+		TSharedPtr<FJsonValue> Value = ReadValue(Ar, Strings, Depth);
+		if (!Value.IsValid())
+		{
+			return NULL;
+		}
+
+		Object->SetField(Key, Value);
+	}
+
+	return Object;
+}
+
+bool FFlareSaveBinary::ReadStringIndex(FArchive& Ar, const TArray<FString>& Strings, FString& String)
+{
+	uint32 StringIndex = 0;
+	Ar.SerializeIntPacked(StringIndex);
+
+	if (Ar.IsError() || StringIndex >= (uint32)Strings.Num())
+	{
+		return false;
+	}
+
+	String = Strings[StringIndex];
+	return true;
+}
+
+
+/*----------------------------------------------------
+	Stream output
+----------------------------------------------------*/
+
+FFlareSaveBinaryOutput::FFlareSaveBinaryOutput()
+	: Depth(0)
+{
+	ArIsSaving = true;
+}
+
+void FFlareSaveBinaryOutput::WriteObjectStart(const FString& Key)
+{
+	// The root object has no tag
+	if (Depth > 0)
+	{
+		WriteKey(Key);
+		WriteTag(FFlareSaveBinary::TAG_Object);
+	}
+	PushScope(true);
+}
+
+void FFlareSaveBinaryOutput::WriteObjectEnd()
+{
+	PopScope();
+}
+
+void FFlareSaveBinaryOutput::WriteArrayStart(const FString& Key)
+{
+	WriteKey(Key);
+	WriteTag(FFlareSaveBinary::TAG_Array);
+	PushScope(false);
+}
+
+void FFlareSaveBinaryOutput::WriteArrayEnd()
+{
+	PopScope();
+}
+
+void FFlareSaveBinaryOutput::WriteString(const FString& Key, const FString& Value)
+{
+	WriteKey(Key);
+
+	// Same encoding as FFlareSaveBinary::WriteValue
+	if (FFlareSaveBinary::IsIntString(Value))
+	{
+		int64 Integer = FCString::Atoi64(*Value);
+		WriteTag(FFlareSaveBinary::TAG_IntString);
+		FFlareSaveBinary::SerializeInt64Packed(*this, Integer);
+	}
+	else
+	{
+		uint32 StringIndex = FFlareSaveBinary::AddString(Value, Strings);
+		WriteTag(FFlareSaveBinary::TAG_String);
+		SerializeIntPacked(StringIndex);
+	}
+}
+
+void FFlareSaveBinaryOutput::WriteNumber(const FString& Key, double Value)
+{
+	WriteKey(Key);
+
+	float SingleValue = Value;
+	if ((double) SingleValue == Value)
+	{
+		WriteTag(FFlareSaveBinary::TAG_Float);
+		*this << SingleValue;
+	}
+	else
+	{
+		WriteTag(FFlareSaveBinary::TAG_Double);
+		*this << Value;
+	}
+}
+
+void FFlareSaveBinaryOutput::WriteBool(const FString& Key, bool Value)
+{
+	WriteKey(Key);
+	WriteTag(Value ? FFlareSaveBinary::TAG_True : FFlareSaveBinary::TAG_False);
+}
+
+void FFlareSaveBinaryOutput::Finish(TArray<uint8>& Data)
+{
+	check(Depth == 0 && Stack.Num());
+	FFlareSaveBinary::WriteFile(Strings, Stack[0].Count, Stack[0].Body, Data);
+}
+
+void FFlareSaveBinaryOutput::Serialize(void* Data, int64 Length)
+{
+	check(Depth > 0);
+	Stack[Depth - 1].Body.Append((uint8*) Data, Length);
+}
+
+void FFlareSaveBinaryOutput::WriteKey(const FString& Key)
+{
+	FScope& Scope = Stack[Depth - 1];
+	Scope.Count++;
+
+	if (Scope.IsObject)
+	{
+		uint32 KeyIndex = FFlareSaveBinary::AddString(Key, Strings);
+		SerializeIntPacked(KeyIndex);
+	}
+}
+
+void FFlareSaveBinaryOutput::WriteTag(uint8 Tag)
+{
+	*this << Tag;
+}
+
+void FFlareSaveBinaryOutput::PushScope(bool IsObject)
+{
+	if (Depth == Stack.Num())
+	{
+		Stack.AddDefaulted();
+	}
+
+	FScope& Scope = Stack[Depth];
+	Scope.Body.Reset();
+	Scope.Count = 0;
+	Scope.IsObject = IsObject;
+	Depth++;
+}
+
+void FFlareSaveBinaryOutput::PopScope()
+{
+	Depth--;
+
+	// The root stays in the first scope until Finish
+	if (Depth > 0)
+	{
+		FScope& Scope = Stack[Depth];
+		SerializeIntPacked(Scope.Count);
+		Serialize(Scope.Body.GetData(), Scope.Body.Num());
+	}
+}
@@ -0,0 +1,134 @@
+
+#pragma once
+
+#include "../../Flare.h"
+#include "FlareSaveWriterOutput.h"
+
+
+/** Compact binary encoding of the save JSON tree, with a string table and packed integers */
+class FFlareSaveBinary
+{
+public:
+
+	/*----------------------------------------------------
+	  Interface
+	----------------------------------------------------*/
+
+	/** Encode a save object */
+	static void Write(TSharedRef<FJsonObject> Object, TArray<uint8>& Data);
+
+	/** Decode a save object, invalid if the data is corrupted or from an unknown version */
+	static TSharedPtr<FJsonObject> Read(const TArray<uint8>& Data);
+
+	/** Check if this data starts with a binary save header */
+	static bool IsBinarySave(const TArray<uint8>& Data);
+
+
+protected:
+
+	friend class FFlareSaveBinaryOutput;
+
+	/*----------------------------------------------------
+	  Internal
+	----------------------------------------------------*/
+
+	enum ETag
+	{
+		TAG_Null,
+		TAG_False,
+		TAG_True,
+		TAG_Float,
+		TAG_Double,
+		TAG_String,
+		TAG_IntString,
+		TAG_Array,
+		TAG_Object
+	};
+
+	/** Write the header and string table, followed by the encoded root object */
+	static void WriteFile(const TMap<FString, int32>& Strings, uint32 RootCount, const TArray<uint8>& RootBody, TArray<uint8>& Data);
+
+	static void SerializeInt64Packed(FArchive& Ar, int64& Value);
+
+	static void WriteValue(FArchive& Ar, const TSharedPtr<FJsonValue>& Value, TMap<FString, int32>& Strings);
+
+	static void WriteObject(FArchive& Ar, const TSharedPtr<FJsonObject>& Object, TMap<FString, int32>& Strings);
+
+	static int32 AddString(const FString& String, TMap<FString, int32>& Strings);
+
+	static bool IsIntString(const FString& String);
+
+	static TSharedPtr<FJsonValue> ReadValue(FArchive& Ar, const TArray<FString>& Strings, int32 Depth);
+
+	static TSharedPtr<FJsonObject> ReadObject(FArchive& Ar, const TArray<FString>& Strings, int32 Depth);
+
+	static bool ReadStringIndex(FArchive& Ar, const TArray<FString>& Strings, FString& String);
+
+
+public:
+
+	/** File identifier */
+	static const uint32 Magic = 0x42535248; // "HRSB"
+
+	/** Current format version */
+	static const uint32 Version = 1;
+
+	/** Maximum nesting accepted when reading */
+	static const int32 MaxDepth = 64;
+
+};
+
+
+/** Encodes the save tree in the binary format as it is generated, without building the JSON objects */
+class FFlareSaveBinaryOutput : public FFlareSaveWriterOutput, protected FArchive
+{
+public:
+
+	FFlareSaveBinaryOutput();
+
+	virtual void WriteObjectStart(const FString& Key) override;
+
+	virtual void WriteObjectEnd() override;
+
+	virtual void WriteArrayStart(const FString& Key) override;
+
+	virtual void WriteArrayEnd() override;
+
+	virtual void WriteString(const FString& Key, const FString& Value) override;
+
+	virtual void WriteNumber(const FString& Key, double Value) override;
+
+	virtual void WriteBool(const FString& Key, bool Value) override;
+
+	/** Get the encoded save, once the root object has been closed */
+	void Finish(TArray<uint8>& Data);
+
+protected:
+
+	/** Append encoded data to the innermost open object or array */
+	virtual void Serialize(void* Data, int64 Length) override;
+
+	/** Count a new value in the innermost scope, preceded by its key inside objects */
+	void WriteKey(const FString& Key);
+
+	void WriteTag(uint8 Tag);
+
+	/** Open an object or array. Its content is buffered until the item count is known */
+	void PushScope(bool IsObject);
+
+	/** Close the innermost scope and append its count and content to its parent */
+	void PopScope();
+
+	struct FScope
+	{
+		TArray<uint8>                     Body;
+		uint32                            Count;
+		bool                              IsObject;
+	};
+
+	/** Open scopes, kept allocated between siblings */
+	TArray<FScope>                        Stack;
+	int32                                 Depth;
+	TMap<FString, int32>                  Strings;
+
+};
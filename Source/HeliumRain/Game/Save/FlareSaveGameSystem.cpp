@@ -4,7 +4,10 @@
 #include "FlareSaveGameSystem.h"
 #include "FlareSaveWriter.h"
 #include "FlareSaveReaderV1.h"
+#include "FlareSaveBinary.h"
+#include "FlareSaveWriterOutput.h"
 #include "../FlareGame.h"
+#include "../FlareSaveGame.h"
 
 
 /*----------------------------------------------------
@@ -23,34 +26,31 @@ UFlareSaveGameSystem::UFlareSaveGameSystem(const FObjectInitializer& ObjectIniti
 
 bool UFlareSaveGameSystem::DoesSaveGameExist(const FString SaveName)
 {
-	return IFileManager::Get().FileSize(*GetSaveGamePath(SaveName)) >= 0;
+	return IFileManager::Get().FileSize(*GetBinarySaveGamePath(SaveName)) >= 0
+		|| IFileManager::Get().FileSize(*GetSaveGamePath(SaveName)) >= 0;
 }
 
-bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* SaveData)
+bool UFlareSaveGameSystem::SaveGame(const FString SaveName, UFlareSaveGame* SaveData, bool Binary)
 {
 	bool ret = false;
 	SaveLock.Lock();
-	FLOGV("UFlareSaveGameSystem::SaveGame SaveName=%s", *SaveName);
+	FLOGV("UFlareSaveGameSystem::SaveGame SaveName=%s Binary=%d", *SaveName, Binary);
 
 	UFlareSaveWriter* SaveWriter = NewObject<UFlareSaveWriter>(this, UFlareSaveWriter::StaticClass());
-	TSharedRef<FJsonObject> JsonObject = SaveWriter->SaveGame(SaveData);
 
-	// Save the json object
-	FString FileContents;
-	//TSharedRef< TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>> > JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&FileContents);
-	TSharedRef< TJsonWriter<> > JsonWriter = TJsonWriterFactory<>::Create(&FileContents);
-
-	if (FJsonSerializer::Serialize(JsonObject, JsonWriter))
+	if (Binary)
 	{
-		JsonWriter->Close();
-
-		ret = FFileHelper::SaveStringToFile(FileContents, *GetSaveGamePath(SaveName));
-		FLOG("UFlareSaveGameSystem::SaveGame : Save done");
+		ret = WriteBinarySave(SaveName, SaveWriter, SaveData);
 	}
 	else
 	{
-		FLOGV("Fail to serialize save %s", *SaveName);
-		ret = false;
+		ret = WriteSaveStream(SaveName, SaveWriter, SaveData);
+	}
+
+	if (ret)
+	{
+		SaveSummary(SaveName, SaveData);
+		FLOG("UFlareSaveGameSystem::SaveGame : Save done");
 	}
 
 	SaveLock.Unlock();
@@ -68,21 +68,135 @@ UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName)
 
 	UFlareSaveGame *SaveGame = NULL;
 
+	TSharedPtr< FJsonObject > Object = LoadSaveObject(SaveName);
+	if (Object.IsValid())
+	{
+		UFlareSaveReaderV1* SaveReader = NewObject<UFlareSaveReaderV1>(this, UFlareSaveReaderV1::StaticClass());
+		SaveGame = SaveReader->LoadGame(Object);
+	}
+
+	return SaveGame;
+}
+
+bool UFlareSaveGameSystem::DeleteGame(const FString SaveName)
+{
+	bool Deleted = IFileManager::Get().Delete(*GetBinarySaveGamePath(SaveName), true);
+	Deleted |= IFileManager::Get().Delete(*GetSaveGamePath(SaveName), true);
+	IFileManager::Get().Delete(*GetSummaryPath(SaveName), true);
+	return Deleted;
+}
+
+bool UFlareSaveGameSystem::ConvertGame(const FString SaveName, bool Binary)
+{
+	bool ret = false;
+	SaveLock.Lock();
+	FLOGV("UFlareSaveGameSystem::ConvertGame SaveName=%s Binary=%d", *SaveName, Binary);
+
+	TSharedPtr< FJsonObject > Object = LoadSaveObject(SaveName);
+	if (Object.IsValid())
+	{
+		ret = WriteSaveObject(SaveName, Object.ToSharedRef(), Binary);
+	}
+
+	// The content didn't change, only the file
+	FFlareSaveSummary Summary;
+	if (ret && ReadSummaryFile(SaveName, Summary))
+	{
+		Summary.SaveSize = GetSaveFileSize(SaveName);
+		Summary.SaveTimestamp = GetSaveFileTimestamp(SaveName);
+		WriteSummaryFile(SaveName, Summary);
+	}
+
+	SaveLock.Unlock();
+	return ret;
+}
+
+bool UFlareSaveGameSystem::LoadSummary(const FString SaveName, FFlareSaveSummary& Summary)
+{
+	if (!ReadSummaryFile(SaveName, Summary))
+	{
+		return false;
+	}
+
+	// A save written by an older version, an interrupted save or a replaced save file leaves a stale summary
+	if (Summary.SaveSize != GetSaveFileSize(SaveName) || Summary.SaveTimestamp != GetSaveFileTimestamp(SaveName))
+	{
+		FLOGV("UFlareSaveGameSystem::LoadSummary : summary for '%s' is out of date", *SaveName);
+		return false;
+	}
+
+	return true;
+}
+
+bool UFlareSaveGameSystem::SaveSummary(const FString SaveName, UFlareSaveGame* SaveData)
+{
+	FFlareSaveSummary Summary;
+	ComputeSummary(SaveData, Summary);
+	Summary.SaveSize = GetSaveFileSize(SaveName);
+	Summary.SaveTimestamp = GetSaveFileTimestamp(SaveName);
+
+	return WriteSummaryFile(SaveName, Summary);
+}
+
+void UFlareSaveGameSystem::ComputeSummary(UFlareSaveGame* SaveData, FFlareSaveSummary& Summary)
+{
+	Summary.UUID = SaveData->PlayerData.UUID;
+	Summary.PlayerEmblemIndex = SaveData->PlayerData.PlayerEmblemIndex;
+	Summary.PlayerCompanyDescription = SaveData->PlayerCompanyDescription;
+	Summary.CompanyShipCount = 0;
+	Summary.CompanyValue = 0;
+	Summary.SaveSize = 0;
+	Summary.SaveTimestamp = 0;
+
+	for (int32 CompanyIndex = 0; CompanyIndex < SaveData->WorldData.CompanyData.Num(); CompanyIndex++)
+	{
+		const FFlareCompanySave& Company = SaveData->WorldData.CompanyData[CompanyIndex];
+		if (Company.Identifier == SaveData->PlayerData.CompanyIdentifier)
+		{
+			Summary.CompanyShipCount = Company.ShipData.Num();
+			Summary.CompanyValue = Company.CompanyValue;
+		}
+	}
+}
+
+void UFlareSaveGameSystem::PushSaveData(UFlareSaveGame* SaveData)
+{
+	SaveListLock.Lock();
+	SaveList.Add(SaveData);
+	SaveListLock.Unlock();
+}
+
+
+/*----------------------------------------------------
+	Internal
+----------------------------------------------------*/
+
+TSharedPtr<FJsonObject> UFlareSaveGameSystem::LoadSaveObject(const FString SaveName)
+{
+	TSharedPtr< FJsonObject > Object;
+
+	// Binary saves take precedence
+	TArray<uint8> SaveData;
+	if (FFileHelper::LoadFileToArray(SaveData, *GetBinarySaveGamePath(SaveName), FILEREAD_Silent))
+	{
+		Object = FFlareSaveBinary::Read(SaveData);
+		if (!Object.IsValid())
+		{
+			FLOGV("Fail to decode save '%s'", *GetBinarySaveGamePath(SaveName));
+		}
+		return Object;
+	}
+
 	// Read the saveto a string
 	FString SaveString;
 	if(FFileHelper::LoadFileToString(SaveString, *GetSaveGamePath(SaveName)))
 	{
 		// Deserialize a JSON object from the string
-		TSharedPtr< FJsonObject > Object;
 		TSharedRef< TJsonReader<> > Reader = TJsonReaderFactory<>::Create(SaveString);
-		if(FJsonSerializer::Deserialize(Reader, Object) && Object.IsValid())
-		{
-			UFlareSaveReaderV1* SaveReader = NewObject<UFlareSaveReaderV1>(this, UFlareSaveReaderV1::StaticClass());
-			SaveGame = SaveReader->LoadGame(Object);
-		}
-		else
+		if(!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid())
 		{
 			FLOGV("Fail to deserialize save '%s'", *GetSaveGamePath(SaveName));
+			Object = NULL;
 		}
 	}
 	else
@@ -90,20 +204,171 @@ UFlareSaveGame* UFlareSaveGameSystem::LoadGame(const FString SaveName)
 		FLOGV("Fail to read save '%s'", *GetSaveGamePath(SaveName));
 	}
 
-	return SaveGame;
+	return Object;
 }
 
-bool UFlareSaveGameSystem::DeleteGame(const FString SaveName)
+bool UFlareSaveGameSystem::ReadSummaryFile(const FString SaveName, FFlareSaveSummary& Summary)
 {
-	return IFileManager::Get().Delete(*GetSaveGamePath(SaveName), true);
+	FString SummaryString;
+	if (!FFileHelper::LoadFileToString(SummaryString, *GetSummaryPath(SaveName), FILEREAD_Silent))
+	{
+		return false;
+	}
+
+	TSharedPtr< FJsonObject > Object;
+	TSharedRef< TJsonReader<> > Reader = TJsonReaderFactory<>::Create(SummaryString);
+	if (!FJsonSerializer::Deserialize(Reader, Object) || !Object.IsValid())
+	{
+		FLOGV("Fail to deserialize save summary '%s'", *GetSummaryPath(SaveName));
+		return false;
+	}
+
+	UFlareSaveReaderV1* SaveReader = NewObject<UFlareSaveReaderV1>(this, UFlareSaveReaderV1::StaticClass());
+	return SaveReader->LoadSummary(Object, &Summary);
 }
 
+bool UFlareSaveGameSystem::WriteSummaryFile(const FString SaveName, FFlareSaveSummary& Summary)
+{
+	UFlareSaveWriter* SaveWriter = NewObject<UFlareSaveWriter>(this, UFlareSaveWriter::StaticClass());
+	TSharedRef<FJsonObject> JsonObject = SaveWriter->SaveSummary(&Summary);
 
-void UFlareSaveGameSystem::PushSaveData(UFlareSaveGame* SaveData)
+	FString FileContents;
+	TSharedRef< TJsonWriter<> > JsonWriter = TJsonWriterFactory<>::Create(&FileContents);
+	if (FJsonSerializer::Serialize(JsonObject, JsonWriter))
+	{
+		JsonWriter->Close();
+		return FFileHelper::SaveStringToFile(FileContents, *GetSummaryPath(SaveName));
+	}
+
+	FLOGV("Fail to serialize save summary %s", *SaveName);
+	return false;
+}
+
+int64 UFlareSaveGameSystem::GetSaveFileSize(const FString SaveName)
 {
-	SaveListLock.Lock();
-	SaveList.Add(SaveData);
-	SaveListLock.Unlock();
+	int64 Size = IFileManager::Get().FileSize(*GetBinarySaveGamePath(SaveName));
+	if (Size < 0)
+	{
+		Size = IFileManager::Get().FileSize(*GetSaveGamePath(SaveName));
+	}
+	return Size;
+}
+
+int64 UFlareSaveGameSystem::GetSaveFileTimestamp(const FString SaveName)
+{
+	// Same precedence as GetSaveFileSize
+	FString SavePath = GetBinarySaveGamePath(SaveName);
+	if (IFileManager::Get().FileSize(*SavePath) < 0)
+	{
+		SavePath = GetSaveGamePath(SaveName);
+	}
+	return IFileManager::Get().GetTimeStamp(*SavePath).GetTicks();
+}
+
+bool UFlareSaveGameSystem::WriteSaveStream(const FString SaveName, UFlareSaveWriter* SaveWriter, UFlareSaveGame* SaveData)
+{
+	bool ret = false;
+	FString SavePath = GetSaveGamePath(SaveName);
+
+	// Start as ANSI, and write again as Unicode if a wide character is found
+	for (int32 Pass = 0; Pass < 2; Pass++)
+	{
+		FArchive* File = IFileManager::Get().CreateFileWriter(*SavePath);
+		if (!File)
+		{
+			break;
+		}
+
+		FFlareSaveStreamOutput StreamOutput(File, Pass > 0);
+		SaveWriter->SaveGame(SaveData, &StreamOutput);
+		ret = StreamOutput.Finish();
+		ret &= File->Close();
+		delete File;
+
+		if (!StreamOutput.NeedsUnicode())
+		{
+			break;
+		}
+	}
+
+	// Only keep one format on disk
+	if (ret)
+	{
+		IFileManager::Get().Delete(*GetBinarySaveGamePath(SaveName), true);
+	}
+	else
+	{
+		FLOGV("Fail to write save '%s'", *SavePath);
+	}
+
+	return ret;
+}
+
+bool UFlareSaveGameSystem::WriteBinarySave(const FString SaveName, UFlareSaveWriter* SaveWriter, UFlareSaveGame* SaveData)
+{
+	FString SavePath = GetBinarySaveGamePath(SaveName);
+
+	FFlareSaveBinaryOutput BinaryOutput;
+	SaveWriter->SaveGame(SaveData, &BinaryOutput);
+
+	TArray<uint8> FileData;
+	BinaryOutput.Finish(FileData);
+	bool ret = FFileHelper::SaveArrayToFile(FileData, *SavePath);
+
+	// Only keep one format on disk
+	if (ret)
+	{
+		IFileManager::Get().Delete(*GetSaveGamePath(SaveName), true);
+	}
+	else
+	{
+		FLOGV("Fail to write save '%s'", *SavePath);
+	}
+
+	return ret;
+}
+
+bool UFlareSaveGameSystem::WriteSaveObject(const FString SaveName, TSharedRef<FJsonObject> Object, bool Binary)
+{
+	bool ret = false;
+	FString SavePath = Binary ? GetBinarySaveGamePath(SaveName) : GetSaveGamePath(SaveName);
+	FString OtherSavePath = Binary ? GetSaveGamePath(SaveName) : GetBinarySaveGamePath(SaveName);
+
+	if (Binary)
+	{
+		TArray<uint8> SaveData;
+		FFlareSaveBinary::Write(Object, SaveData);
+		ret = FFileHelper::SaveArrayToFile(SaveData, *SavePath);
+	}
+	else
+	{
+		// Save the json object
+		FString FileContents;
+		//TSharedRef< TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>> > JsonWriter = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&FileContents);
+		TSharedRef< TJsonWriter<> > JsonWriter = TJsonWriterFactory<>::Create(&FileContents);
+
+		if (FJsonSerializer::Serialize(Object, JsonWriter))
+		{
+			JsonWriter->Close();
+			ret = FFileHelper::SaveStringToFile(FileContents, *SavePath);
+		}
+		else
+		{
+			FLOGV("Fail to serialize save %s", *SaveName);
+		}
+	}
+
+	// Only keep one format on disk
+	if (ret)
+	{
+		IFileManager::Get().Delete(*OtherSavePath, true);
+	}
+	else
+	{
+		FLOGV("Fail to write save '%s'", *SavePath);
+	}
+
+	return ret;
 }
 
 
@@ -116,3 +381,13 @@ FString UFlareSaveGameSystem::GetSaveGamePath(const FString SaveName)
 {
 	return FString::Printf(TEXT("%s/SaveGames/%s.json"), *FPaths::GameSavedDir(), *SaveName);
 }
+
+FString UFlareSaveGameSystem::GetBinarySaveGamePath(const FString SaveName)
+{
+	return FString::Printf(TEXT("%s/SaveGames/%s.sav"), *FPaths::GameSavedDir(), *SaveName);
+}
+
+FString UFlareSaveGameSystem::GetSummaryPath(const FString SaveName)
+{
+	return FString::Printf(TEXT("%s/SaveGames/%s.summary.json"), *FPaths::GameSavedDir(), *SaveName);
+}
@@ -5,6 +5,8 @@
 #include "FlareSaveGameSystem.generated.h"
 
 class UFlareSaveGame;
+class UFlareSaveWriter;
+struct FFlareSaveSummary;
 
 UCLASS()
 class HELIUMRAIN_API UFlareSaveGameSystem: public UObject
@@ -21,7 +23,8 @@ public:
 	virtual bool DoesSaveGameExist(const FString SaveName);
 
 
-	virtual bool SaveGame(const FString SaveName, UFlareSaveGame* SaveData);
+	/** Write a save in the binary or JSON format */
+	virtual bool SaveGame(const FString SaveName, UFlareSaveGame* SaveData, bool Binary);
 
 	virtual UFlareSaveGame* LoadGame(const FString SaveName);
 
@@ -31,8 +34,45 @@ public:
 	/* Keep Save data reference for the async save*/
 	virtual void PushSaveData(UFlareSaveGame* SaveData);
 
+	/** Convert an existing save to the binary or JSON format */
+	virtual bool ConvertGame(const FString SaveName, bool Binary);
+
+	/** Read the summary of a save, false if missing or out of date */
+	virtual bool LoadSummary(const FString SaveName, FFlareSaveSummary& Summary);
+
+	/** Write the summary of an existing save */
+	virtual bool SaveSummary(const FString SaveName, UFlareSaveGame* SaveData);
+
+	/** Fill a summary from loaded save data */
+	void ComputeSummary(UFlareSaveGame* SaveData, FFlareSaveSummary& Summary);
+
 protected:
 
+	/** Read the JSON tree of a save, from either format */
+	TSharedPtr<FJsonObject> LoadSaveObject(const FString SaveName);
+
+	/** Write a JSON save as it is generated, and remove the file in the other format */
+	bool WriteSaveStream(const FString SaveName, UFlareSaveWriter* SaveWriter, UFlareSaveGame* SaveData);
+
+	/** Write a binary save as it is generated, and remove the file in the other format */
+	bool WriteBinarySave(const FString SaveName, UFlareSaveWriter* SaveWriter, UFlareSaveGame* SaveData);
+
+	/** Write the JSON tree of a save, and remove the file in the other format */
+	bool WriteSaveObject(const FString SaveName, TSharedRef<FJsonObject> Object, bool Binary);
+
+	/** Read a summary file without checking it against the save */
+	bool ReadSummaryFile(const FString SaveName, FFlareSaveSummary& Summary);
+
+	/** Write a summary file */
+	bool WriteSummaryFile(const FString SaveName, FFlareSaveSummary& Summary);
+
+	/** Get the size of the save file, in either format */
+	int64 GetSaveFileSize(const FString SaveName);
+
+	/** Get the modification time of the save file, in either format, in ticks */
+	int64 GetSaveFileTimestamp(const FString SaveName);
+
+
 
 	/*----------------------------------------------------
 		Protected data
@@ -55,4 +95,10 @@ public:
    /** Get the path to save game file for the given name, a platform _may_ be able to simply override this and no other functions above */
    static FString GetSaveGamePath(const FString SaveName);
 
+   /** Get the path to the binary save game file for the given name */
+   static FString GetBinarySaveGamePath(const FString SaveName);
+
+   /** Get the path to the summary file for the given name */
+   static FString GetSummaryPath(const FString SaveName);
+
 };
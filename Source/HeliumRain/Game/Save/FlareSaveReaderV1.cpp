@@ -66,6 +66,35 @@ UFlareSaveGame* UFlareSaveReaderV1::LoadGame(TSharedPtr< FJsonObject > GameObjec
 	return SaveGame;
 }
 
+bool UFlareSaveReaderV1::LoadSummary(TSharedPtr< FJsonObject > SummaryObject, FFlareSaveSummary* Data)
+{
+	FString Game;
+	FString SaveFormat;
+	if (!SummaryObject->TryGetStringField(TEXT("Game"), Game)
+	 || !SummaryObject->TryGetStringField(TEXT("SaveFormat"), SaveFormat)
+	 || Game != "Helium Rain" || SaveFormat != UFlareSaveWriter::FormatInt32(1))
+	{
+		FLOG("WARNING: Invalid save summary");
+		return false;
+	}
+
+	LoadFName(SummaryObject, "UUID", &Data->UUID);
+	LoadInt32(SummaryObject, "PlayerEmblemIndex", &Data->PlayerEmblemIndex);
+
+	const TSharedPtr< FJsonObject >* PlayerCompanyDescription;
+	if(SummaryObject->TryGetObjectField(TEXT("PlayerCompanyDescription"), PlayerCompanyDescription))
+	{
+		LoadCompanyDescription(*PlayerCompanyDescription, &Data->PlayerCompanyDescription);
+	}
+
+	LoadInt32(SummaryObject, "CompanyShipCount", &Data->CompanyShipCount);
+	LoadInt64(SummaryObject, "CompanyValue", &Data->CompanyValue);
+	LoadInt64(SummaryObject, "SaveSize", &Data->SaveSize);
+	LoadInt64(SummaryObject, "SaveTimestamp", &Data->SaveTimestamp);
+
+	return true;
+}
+
 void UFlareSaveReaderV1::LoadPlayer(const TSharedPtr<FJsonObject> Object, FFlarePlayerSave* Data)
 {
 	LoadFName(Object, "UUID", &Data->UUID);
@@ -241,7 +270,7 @@ void UFlareSaveReaderV1::LoadWorld(const TSharedPtr<FJsonObject> Object, FFlareW
 		}
 	}
 
-	LoadFloatBuffer(Object, "FleetSupplyConsumptionStats", &Data->FleetSupplyConsumptionStats);
+	LoadTimeSeries(Object, "FleetSupplyConsumptionStats", &Data->FleetSupplyConsumptionStats);
 	LoadInt32(Object, "DailyFleetSupplyConsumption", &Data->DailyFleetSupplyConsumption);
 }
 
@@ -850,7 +879,7 @@ void UFlareSaveReaderV1::LoadResourcePrice(const TSharedPtr<FJsonObject> Object,
 {
 	LoadFName(Object, "ResourceIdentifier", &Data->ResourceIdentifier);
 	LoadFloat(Object, "Price", &Data->Price);
-	LoadFloatBuffer(Object, "Prices", &Data->Prices);
+	LoadTimeSeries(Object, "Prices", &Data->Prices);
 }
 
 
@@ -1079,15 +1108,15 @@ void UFlareSaveReaderV1::LoadRotator(TSharedPtr< FJsonObject > Object, FString K
 	}
 }
 
-void UFlareSaveReaderV1::LoadFloatBuffer(TSharedPtr< FJsonObject > Object, FString Key, FFlareFloatBuffer* Data)
+void UFlareSaveReaderV1::LoadTimeSeries(TSharedPtr< FJsonObject > Object, FString Key, FFlareTimeSeries* Data)
 {
-	const TSharedPtr< FJsonObject >* FloatBuffer;
-	if(Object->TryGetObjectField(Key, FloatBuffer))
+	const TSharedPtr< FJsonObject >* TimeSeries;
+	if(Object->TryGetObjectField(Key, TimeSeries))
 	{
-		LoadInt32(*FloatBuffer, "MaxSize", &Data->MaxSize);
-		LoadInt32(*FloatBuffer, "WriteIndex", &Data->WriteIndex);
+		LoadInt32(*TimeSeries, "MaxSize", &Data->MaxSize);
+		LoadInt32(*TimeSeries, "WriteIndex", &Data->WriteIndex);
 
-		LoadFloatArray(*FloatBuffer, "Values", &Data->Values);
+		LoadFloatArray(*TimeSeries, "Values", &Data->Values);
 	}
 	else
 	{
@@ -5,8 +5,9 @@
 #include "FlareSaveReaderV1.generated.h"
 
 class UFlareSaveGame;
+struct FFlareSaveSummary;
 struct FFlareTradeRouteSectorOperationSave;
-struct FFlareFloatBuffer;
+struct FFlareTimeSeries;
 
 UCLASS()
 class HELIUMRAIN_API UFlareSaveReaderV1: public UObject
@@ -16,6 +17,8 @@ class HELIUMRAIN_API UFlareSaveReaderV1: public UObject
 public:
 	UFlareSaveGame* LoadGame(TSharedPtr< FJsonObject > GameObject);
 
+	bool LoadSummary(TSharedPtr< FJsonObject > SummaryObject, FFlareSaveSummary* Data);
+
 protected:
 	/*----------------------------------------------------
 	  Loaders
@@ -82,7 +85,7 @@ public:
 	void LoadTransform(TSharedPtr< FJsonObject > Object, FString Key, FTransform* Data);
 	void LoadVector(TSharedPtr< FJsonObject > Object, FString Key, FVector* Data);
 	void LoadRotator(TSharedPtr< FJsonObject > Object, FString Key, FRotator* Data);
-	void LoadFloatBuffer(TSharedPtr< FJsonObject > Object, FString Key, FFlareFloatBuffer* Data);
+	void LoadTimeSeries(TSharedPtr< FJsonObject > Object, FString Key, FFlareTimeSeries* Data);
 	void LoadBundle(const TSharedPtr<FJsonObject> Object, FString Key, FFlareBundle* Data);
 
 
@@ -2,6 +2,7 @@
 #include "../../Flare.h"
 #include "../FlareSaveGame.h"
 #include "FlareSaveWriter.h"
+#include "FlareSaveWriterOutput.h"
 #include "Game/FlareGameTools.h"
 
 /*----------------------------------------------------
@@ -10,858 +11,897 @@
 
 UFlareSaveWriter::UFlareSaveWriter(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
+	, Output(NULL)
 {
 }
 
 TSharedRef<FJsonObject> UFlareSaveWriter::SaveGame(UFlareSaveGame* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
-
-	// General stuff
-	JsonObject->SetStringField("Game", "Helium Rain");
-	JsonObject->SetStringField("SaveFormat", FormatInt32(1));
+	FFlareSaveObjectOutput ObjectOutput;
+	SaveGame(Data, &ObjectOutput);
+	return ObjectOutput.GetObject();
+}
 
-	// Game data
-	JsonObject->SetObjectField("Player", SavePlayer(&Data->PlayerData));
-	JsonObject->SetObjectField("PlayerCompanyDescription", SaveCompanyDescription(&Data->PlayerCompanyDescription));
-	JsonObject->SetStringField("CurrentImmatriculationIndex", FormatInt32(Data->CurrentImmatriculationIndex));
-	JsonObject->SetStringField("CurrentIdentifierIndex", FormatInt32(Data->CurrentIdentifierIndex));
-	JsonObject->SetObjectField("World", SaveWorld(&Data->WorldData));
+void UFlareSaveWriter::SaveGame(UFlareSaveGame* Data, FFlareSaveWriterOutput* SaveOutput)
+{
+	Output = SaveOutput;
+	GenerateGame(FString(), Data);
+	Output = NULL;
+}
 
-	return JsonObject;
+TSharedRef<FJsonObject> UFlareSaveWriter::SaveSummary(FFlareSaveSummary* Data)
+{
+	FFlareSaveObjectOutput ObjectOutput;
+	Output = &ObjectOutput;
+	GenerateSummary(FString(), Data);
+	Output = NULL;
+	return ObjectOutput.GetObject();
 }
 
 /*----------------------------------------------------
 	Generator
 ----------------------------------------------------*/
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SavePlayer(FFlarePlayerSave* Data)
+void UFlareSaveWriter::GenerateGame(const FString& Key, UFlareSaveGame* Data)
+{
+	Output->WriteObjectStart(Key);
+
+	// General stuff
+	Output->WriteString("Game", "Helium Rain");
+	Output->WriteString("SaveFormat", FormatInt32(1));
+
+	// Game data
+	SavePlayer("Player", &Data->PlayerData);
+	SaveCompanyDescription("PlayerCompanyDescription", &Data->PlayerCompanyDescription);
+	Output->WriteString("CurrentImmatriculationIndex", FormatInt32(Data->CurrentImmatriculationIndex));
+	Output->WriteString("CurrentIdentifierIndex", FormatInt32(Data->CurrentIdentifierIndex));
+	SaveWorld("World", &Data->WorldData);
+
+	Output->WriteObjectEnd();
+}
+
+void UFlareSaveWriter::GenerateSummary(const FString& Key, FFlareSaveSummary* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("UUID", Data->UUID.ToString());
-	JsonObject->SetStringField("ScenarioId", FormatInt32(Data->ScenarioId));
-	JsonObject->SetStringField("PlayerEmblemIndex", FormatInt32(Data->PlayerEmblemIndex));
-	JsonObject->SetStringField("CompanyIdentifier", Data->CompanyIdentifier.ToString());
-	JsonObject->SetStringField("PlayerFleetIdentifier", Data->PlayerFleetIdentifier.ToString());
-	JsonObject->SetStringField("LastFlownShipIdentifier", Data->LastFlownShipIdentifier.ToString());
-	JsonObject->SetObjectField("Quest", SaveQuest(&Data->QuestData));
+	Output->WriteString("Game", "Helium Rain");
+	Output->WriteString("SaveFormat", FormatInt32(1));
+	Output->WriteString("UUID", Data->UUID.ToString());
+	Output->WriteString("PlayerEmblemIndex", FormatInt32(Data->PlayerEmblemIndex));
+	SaveCompanyDescription("PlayerCompanyDescription", &Data->PlayerCompanyDescription);
+	Output->WriteString("CompanyShipCount", FormatInt32(Data->CompanyShipCount));
+	Output->WriteString("CompanyValue", FormatInt64(Data->CompanyValue));
+	Output->WriteString("SaveSize", FormatInt64(Data->SaveSize));
+	Output->WriteString("SaveTimestamp", FormatInt64(Data->SaveTimestamp));
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveQuest(FFlareQuestSave* Data)
+void UFlareSaveWriter::SavePlayer(const FString& Key, FFlarePlayerSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("SelectedQuest", Data->SelectedQuest.ToString());
-	JsonObject->SetBoolField("PlayTutorial", Data->PlayTutorial);
-	JsonObject->SetStringField("NextGeneratedQuestIndex", FormatInt64(Data->NextGeneratedQuestIndex));
+	Output->WriteString("UUID", Data->UUID.ToString());
+	Output->WriteString("ScenarioId", FormatInt32(Data->ScenarioId));
+	Output->WriteString("PlayerEmblemIndex", FormatInt32(Data->PlayerEmblemIndex));
+	Output->WriteString("CompanyIdentifier", Data->CompanyIdentifier.ToString());
+	Output->WriteString("PlayerFleetIdentifier", Data->PlayerFleetIdentifier.ToString());
+	Output->WriteString("LastFlownShipIdentifier", Data->LastFlownShipIdentifier.ToString());
+	SaveQuest("Quest", &Data->QuestData);
 
+	Output->WriteObjectEnd();
+}
 
-	TArray< TSharedPtr<FJsonValue> > QuestProgresses;
+void UFlareSaveWriter::SaveQuest(const FString& Key, FFlareQuestSave* Data)
+{
+	Output->WriteObjectStart(Key);
+
+	Output->WriteString("SelectedQuest", Data->SelectedQuest.ToString());
+	Output->WriteBool("PlayTutorial", Data->PlayTutorial);
+	Output->WriteString("NextGeneratedQuestIndex", FormatInt64(Data->NextGeneratedQuestIndex));
+
+
+	Output->WriteArrayStart("QuestProgresses");
 	for(int i = 0; i < Data->QuestProgresses.Num(); i++)
 	{
-		QuestProgresses.Add(MakeShareable(new FJsonValueObject(SaveQuestProgress(&Data->QuestProgresses[i]))));
+		SaveQuestProgress(FString(), &Data->QuestProgresses[i]);
 	}
-	JsonObject->SetArrayField("QuestProgresses", QuestProgresses);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > SuccessfulQuests;
+	Output->WriteArrayStart("SuccessfulQuests");
 	for(int i = 0; i < Data->SuccessfulQuests.Num(); i++)
 	{
-		SuccessfulQuests.Add(MakeShareable(new FJsonValueString(Data->SuccessfulQuests[i].ToString())));
+		Output->WriteString(FString(), Data->SuccessfulQuests[i].ToString());
 	}
-	JsonObject->SetArrayField("SuccessfulQuests", SuccessfulQuests);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > AbandonedQuests;
+	Output->WriteArrayStart("AbandonedQuests");
 	for(int i = 0; i < Data->AbandonedQuests.Num(); i++)
 	{
-		AbandonedQuests.Add(MakeShareable(new FJsonValueString(Data->AbandonedQuests[i].ToString())));
+		Output->WriteString(FString(), Data->AbandonedQuests[i].ToString());
 	}
-	JsonObject->SetArrayField("AbandonedQuests", AbandonedQuests);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > FailedQuests;
+	Output->WriteArrayStart("FailedQuests");
 	for(int i = 0; i < Data->FailedQuests.Num(); i++)
 	{
-		FailedQuests.Add(MakeShareable(new FJsonValueString(Data->FailedQuests[i].ToString())));
+		Output->WriteString(FString(), Data->FailedQuests[i].ToString());
 	}
-	JsonObject->SetArrayField("FailedQuests", FailedQuests);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > GeneratedQuests;
+	Output->WriteArrayStart("GeneratedQuests");
 	for(int i = 0; i < Data->GeneratedQuests.Num(); i++)
 	{
-		GeneratedQuests.Add(MakeShareable(new FJsonValueObject(SaveGeneratedQuest(&Data->GeneratedQuests[i]))));
+		SaveGeneratedQuest(FString(), &Data->GeneratedQuests[i]);
 	}
-	JsonObject->SetArrayField("GeneratedQuests", GeneratedQuests);
+	Output->WriteArrayEnd();
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveQuestProgress(FFlareQuestProgressSave* Data)
+void UFlareSaveWriter::SaveQuestProgress(const FString& Key, FFlareQuestProgressSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("QuestIdentifier", Data->QuestIdentifier.ToString());
-	JsonObject->SetStringField("Status", FormatEnum<EFlareQuestStatus::Type>("EFlareQuestStatus",Data->Status));
+	Output->WriteString("QuestIdentifier", Data->QuestIdentifier.ToString());
+	Output->WriteString("Status", FormatEnum<EFlareQuestStatus::Type>("EFlareQuestStatus",Data->Status));
 
-	JsonObject->SetStringField("AvailableDate", FormatInt64(Data->AvailableDate));
-	JsonObject->SetStringField("AcceptationDate", FormatInt64(Data->AcceptationDate));
+	Output->WriteString("AvailableDate", FormatInt64(Data->AvailableDate));
+	Output->WriteString("AcceptationDate", FormatInt64(Data->AcceptationDate));
 
-	JsonObject->SetObjectField("Data", SaveBundle(&Data->Data));
+	SaveBundle("Data", &Data->Data);
 
-	TArray< TSharedPtr<FJsonValue> > SuccessfullSteps;
+	Output->WriteArrayStart("SuccessfullSteps");
 	for(int i = 0; i < Data->SuccessfullSteps.Num(); i++)
 	{
-		SuccessfullSteps.Add(MakeShareable(new FJsonValueString(Data->SuccessfullSteps[i].ToString())));
+		Output->WriteString(FString(), Data->SuccessfullSteps[i].ToString());
 	}
-	JsonObject->SetArrayField("SuccessfullSteps", SuccessfullSteps);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > CurrentStepProgress;
+	Output->WriteArrayStart("CurrentStepProgress");
 	for(int i = 0; i < Data->CurrentStepProgress.Num(); i++)
 	{
-		CurrentStepProgress.Add(MakeShareable(new FJsonValueObject(SaveQuestStepProgress(&Data->CurrentStepProgress[i]))));
+		SaveQuestStepProgress(FString(), &Data->CurrentStepProgress[i]);
 	}
-	JsonObject->SetArrayField("CurrentStepProgress", CurrentStepProgress);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > TriggerConditionsSave;
+	Output->WriteArrayStart("TriggerConditionsSave");
 	for(int i = 0; i < Data->TriggerConditionsSave.Num(); i++)
 	{
-		TriggerConditionsSave.Add(MakeShareable(new FJsonValueObject(SaveQuestStepProgress(&Data->TriggerConditionsSave[i]))));
+		SaveQuestStepProgress(FString(), &Data->TriggerConditionsSave[i]);
 	}
-	JsonObject->SetArrayField("TriggerConditionsSave", TriggerConditionsSave);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > ExpirationConditionsSave;
+	Output->WriteArrayStart("ExpirationConditionsSave");
 	for(int i = 0; i < Data->ExpirationConditionsSave.Num(); i++)
 	{
-		ExpirationConditionsSave.Add(MakeShareable(new FJsonValueObject(SaveQuestStepProgress(&Data->ExpirationConditionsSave[i]))));
+		SaveQuestStepProgress(FString(), &Data->ExpirationConditionsSave[i]);
 	}
-	JsonObject->SetArrayField("ExpirationConditionsSave", ExpirationConditionsSave);
+	Output->WriteArrayEnd();
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveGeneratedQuest(FFlareGeneratedQuestSave* Data)
+void UFlareSaveWriter::SaveGeneratedQuest(const FString& Key, FFlareGeneratedQuestSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("QuestClass", Data->QuestClass.ToString());
-	JsonObject->SetObjectField("Data", SaveBundle(&Data->Data));
+	Output->WriteString("QuestClass", Data->QuestClass.ToString());
+	SaveBundle("Data", &Data->Data);
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveQuestStepProgress(FFlareQuestConditionSave* Data)
+void UFlareSaveWriter::SaveQuestStepProgress(const FString& Key, FFlareQuestConditionSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("ConditionIdentifier", Data->ConditionIdentifier.ToString());
-	JsonObject->SetObjectField("Data", SaveBundle(&Data->Data));
+	Output->WriteString("ConditionIdentifier", Data->ConditionIdentifier.ToString());
+	SaveBundle("Data", &Data->Data);
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveCompanyDescription(FFlareCompanyDescription* Data)
+void UFlareSaveWriter::SaveCompanyDescription(const FString& Key, FFlareCompanyDescription* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("Name", Data->Name.ToString());
-	JsonObject->SetStringField("ShortName", Data->ShortName.ToString());
-	JsonObject->SetStringField("Description", Data->Description.ToString());
+	Output->WriteString("Name", Data->Name.ToString());
+	Output->WriteString("ShortName", Data->ShortName.ToString());
+	Output->WriteString("Description", Data->Description.ToString());
 
-	JsonObject->SetStringField("CustomizationBasePaintColor", FormatVector(UFlareGameTools::ColorToVector(Data->CustomizationBasePaintColor)));
-	JsonObject->SetStringField("CustomizationPaintColor", FormatVector(UFlareGameTools::ColorToVector(Data->CustomizationPaintColor)));
-	JsonObject->SetStringField("CustomizationOverlayColor", FormatVector(UFlareGameTools::ColorToVector(Data->CustomizationOverlayColor)));
-	JsonObject->SetStringField("CustomizationLightColor", FormatVector(UFlareGameTools::ColorToVector(Data->CustomizationLightColor)));
-	JsonObject->SetStringField("CustomizationPatternIndex", FormatInt32(Data->CustomizationPatternIndex));
+	Output->WriteString("CustomizationBasePaintColor", FormatVector(UFlareGameTools::ColorToVector(Data->CustomizationBasePaintColor)));
+	Output->WriteString("CustomizationPaintColor", FormatVector(UFlareGameTools::ColorToVector(Data->CustomizationPaintColor)));
+	Output->WriteString("CustomizationOverlayColor", FormatVector(UFlareGameTools::ColorToVector(Data->CustomizationOverlayColor)));
+	Output->WriteString("CustomizationLightColor", FormatVector(UFlareGameTools::ColorToVector(Data->CustomizationLightColor)));
+	Output->WriteString("CustomizationPatternIndex", FormatInt32(Data->CustomizationPatternIndex));
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveWorld(FFlareWorldSave* Data)
+void UFlareSaveWriter::SaveWorld(const FString& Key, FFlareWorldSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("Date", FormatInt64(Data->Date));
+	Output->WriteString("Date", FormatInt64(Data->Date));
 
-	TArray< TSharedPtr<FJsonValue> > Companies;
+	Output->WriteArrayStart("Companies");
 	for(int i = 0; i < Data->CompanyData.Num(); i++)
 	{
-		Companies.Add(MakeShareable(new FJsonValueObject(SaveCompany(&Data->CompanyData[i]))));
+		SaveCompany(FString(), &Data->CompanyData[i]);
 	}
-	JsonObject->SetArrayField("Companies", Companies);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > Sectors;
+	Output->WriteArrayStart("Sectors");
 	for(int i = 0; i < Data->SectorData.Num(); i++)
 	{
-		Sectors.Add(MakeShareable(new FJsonValueObject(SaveSector(&Data->SectorData[i]))));
+		SaveSector(FString(), &Data->SectorData[i]);
 	}
-	JsonObject->SetArrayField("Sectors", Sectors);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > Travels;
+	Output->WriteArrayStart("Travels");
 	for(int i = 0; i < Data->TravelData.Num(); i++)
 	{
-		Travels.Add(MakeShareable(new FJsonValueObject(SaveTravel(&Data->TravelData[i]))));
+		SaveTravel(FString(), &Data->TravelData[i]);
 	}
-	JsonObject->SetArrayField("Travels", Travels);
+	Output->WriteArrayEnd();
 
-	JsonObject->SetObjectField("FleetSupplyConsumptionStats", SaveFloatBuffer(&Data->FleetSupplyConsumptionStats));
-	JsonObject->SetStringField("DailyFleetSupplyConsumption", FormatInt32(Data->DailyFleetSupplyConsumption));
+	SaveTimeSeries("FleetSupplyConsumptionStats", &Data->FleetSupplyConsumptionStats);
+	Output->WriteString("DailyFleetSupplyConsumption", FormatInt32(Data->DailyFleetSupplyConsumption));
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveCompany(FFlareCompanySave* Data)
+void UFlareSaveWriter::SaveCompany(const FString& Key, FFlareCompanySave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("Identifier", Data->Identifier.ToString());
-	JsonObject->SetStringField("CatalogIdentifier", FormatInt32(Data->CatalogIdentifier));
-	JsonObject->SetStringField("Money", FormatInt64(Data->Money));
-	JsonObject->SetStringField("CompanyValue", FormatInt64(Data->CompanyValue));
-	JsonObject->SetStringField("PlayerLastPeaceDate", FormatInt64(Data->PlayerLastPeaceDate));
-	JsonObject->SetStringField("PlayerLastWarDate", FormatInt64(Data->PlayerLastWarDate));
-	JsonObject->SetStringField("PlayerLastTributeDate", FormatInt64(Data->PlayerLastTributeDate));
-	JsonObject->SetStringField("FleetImmatriculationIndex", FormatInt32(Data->FleetImmatriculationIndex));
-	JsonObject->SetStringField("TradeRouteImmatriculationIndex", FormatInt32(Data->TradeRouteImmatriculationIndex));
-	JsonObject->SetStringField("ResearchAmount", FormatInt32(Data->ResearchAmount));
-	JsonObject->SetStringField("ResearchSpent", FormatInt32(Data->ResearchSpent));
-	JsonObject->SetObjectField("AI", SaveCompanyAI(&Data->AI));
-	SaveFloat(JsonObject,"Shame", Data->Shame);
-	SaveFloat(JsonObject,"ResearchRatio", Data->ResearchRatio);
+	Output->WriteString("Identifier", Data->Identifier.ToString());
+	Output->WriteString("CatalogIdentifier", FormatInt32(Data->CatalogIdentifier));
+	Output->WriteString("Money", FormatInt64(Data->Money));
+	Output->WriteString("CompanyValue", FormatInt64(Data->CompanyValue));
+	Output->WriteString("PlayerLastPeaceDate", FormatInt64(Data->PlayerLastPeaceDate));
+	Output->WriteString("PlayerLastWarDate", FormatInt64(Data->PlayerLastWarDate));
+	Output->WriteString("PlayerLastTributeDate", FormatInt64(Data->PlayerLastTributeDate));
+	Output->WriteString("FleetImmatriculationIndex", FormatInt32(Data->FleetImmatriculationIndex));
+	Output->WriteString("TradeRouteImmatriculationIndex", FormatInt32(Data->TradeRouteImmatriculationIndex));
+	Output->WriteString("ResearchAmount", FormatInt32(Data->ResearchAmount));
+	Output->WriteString("ResearchSpent", FormatInt32(Data->ResearchSpent));
+	SaveCompanyAI("AI", &Data->AI);
+	SaveFloat("Shame", Data->Shame);
+	SaveFloat("ResearchRatio", Data->ResearchRatio);
 
-	TArray< TSharedPtr<FJsonValue> > UnlockedTechnologies;
+	Output->WriteArrayStart("UnlockedTechnologies");
 	for (int i = 0; i < Data->UnlockedTechnologies.Num(); i++)
 	{
-		UnlockedTechnologies.Add(MakeShareable(new FJsonValueString(Data->UnlockedTechnologies[i].ToString())));
+		Output->WriteString(FString(), Data->UnlockedTechnologies[i].ToString());
 	}
-	JsonObject->SetArrayField("UnlockedTechnologies", UnlockedTechnologies);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > HostileCompanies;
+	Output->WriteArrayStart("HostileCompanies");
 	for(int i = 0; i < Data->HostileCompanies.Num(); i++)
 	{
-		HostileCompanies.Add(MakeShareable(new FJsonValueString(Data->HostileCompanies[i].ToString())));
+		Output->WriteString(FString(), Data->HostileCompanies[i].ToString());
 	}
-	JsonObject->SetArrayField("HostileCompanies", HostileCompanies);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > Ships;
+	Output->WriteArrayStart("Ships");
 	for(int i = 0; i < Data->ShipData.Num(); i++)
 	{
-		Ships.Add(MakeShareable(new FJsonValueObject(SaveSpacecraft(&Data->ShipData[i]))));
+		SaveSpacecraft(FString(), &Data->ShipData[i]);
 	}
-	JsonObject->SetArrayField("Ships", Ships);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > Stations;
+	Output->WriteArrayStart("Stations");
 	for(int i = 0; i < Data->StationData.Num(); i++)
 	{
-		Stations.Add(MakeShareable(new FJsonValueObject(SaveSpacecraft(&Data->StationData[i]))));
+		SaveSpacecraft(FString(), &Data->StationData[i]);
 	}
-	JsonObject->SetArrayField("Stations", Stations);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > DestroyedSpacecrafts;
+	Output->WriteArrayStart("DestroyedSpacecrafts");
 	for(int i = 0; i < Data->DestroyedSpacecraftData.Num(); i++)
 	{
-		DestroyedSpacecrafts.Add(MakeShareable(new FJsonValueObject(SaveSpacecraft(&Data->DestroyedSpacecraftData[i]))));
+		SaveSpacecraft(FString(), &Data->DestroyedSpacecraftData[i]);
 	}
-	JsonObject->SetArrayField("DestroyedSpacecrafts", DestroyedSpacecrafts);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > Fleets;
+	Output->WriteArrayStart("Fleets");
 	for(int i = 0; i < Data->Fleets.Num(); i++)
 	{
-		Fleets.Add(MakeShareable(new FJsonValueObject(SaveFleet(&Data->Fleets[i]))));
+		SaveFleet(FString(), &Data->Fleets[i]);
 	}
-	JsonObject->SetArrayField("Fleets", Fleets);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > TradeRoutes;
+	Output->WriteArrayStart("TradeRoutes");
 	for(int i = 0; i < Data->TradeRoutes.Num(); i++)
 	{
-		TradeRoutes.Add(MakeShareable(new FJsonValueObject(SaveTradeRoute(&Data->TradeRoutes[i]))));
+		SaveTradeRoute(FString(), &Data->TradeRoutes[i]);
 	}
-	JsonObject->SetArrayField("TradeRoutes", TradeRoutes);
+	Output->WriteArrayEnd();
 
 
-	TArray< TSharedPtr<FJsonValue> > SectorsKnowledge;
+	Output->WriteArrayStart("SectorsKnowledge");
 	for(int i = 0; i < Data->SectorsKnowledge.Num(); i++)
 	{
-		SectorsKnowledge.Add(MakeShareable(new FJsonValueObject(SaveSectorKnowledge(&Data->SectorsKnowledge[i]))));
+		SaveSectorKnowledge(FString(), &Data->SectorsKnowledge[i]);
 	}
-	JsonObject->SetArrayField("SectorsKnowledge", SectorsKnowledge);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > CompaniesReputation;
+	Output->WriteArrayStart("CompaniesReputation");
 	for(int i = 0; i < Data->CompaniesReputation.Num(); i++)
 	{
-		CompaniesReputation.Add(MakeShareable(new FJsonValueObject(SaveCompanyReputation(&Data->CompaniesReputation[i]))));
+		SaveCompanyReputation(FString(), &Data->CompaniesReputation[i]);
 	}
-	JsonObject->SetArrayField("CompaniesReputation", CompaniesReputation);
+	Output->WriteArrayEnd();
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveSpacecraft(FFlareSpacecraftSave* Data)
+void UFlareSaveWriter::SaveSpacecraft(const FString& Key, FFlareSpacecraftSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
 	// TODO light save if destroyed
-	JsonObject->SetBoolField("IsDestroyed", Data->IsDestroyed);
-	JsonObject->SetBoolField("IsUnderConstruction", Data->IsUnderConstruction);
-	JsonObject->SetStringField("Immatriculation", Data->Immatriculation.ToString());
-	JsonObject->SetStringField("NickName", Data->NickName.ToString());
-	JsonObject->SetStringField("Identifier", Data->Identifier.ToString());
-	JsonObject->SetStringField("CompanyIdentifier", Data->CompanyIdentifier.ToString());
-	JsonObject->SetStringField("Location", FormatVector(Data->Location));
-	JsonObject->SetStringField("Rotation", FormatRotator(Data->Rotation));
-	JsonObject->SetStringField("SpawnMode", FormatEnum<EFlareSpawnMode::Type>("EFlareSpawnMode",Data->SpawnMode));
-	JsonObject->SetStringField("LinearVelocity", FormatVector(Data->LinearVelocity));
-	JsonObject->SetStringField("AngularVelocity", FormatVector(Data->AngularVelocity));
-	JsonObject->SetStringField("DockedTo", Data->DockedTo.ToString());
-	JsonObject->SetStringField("DockedAt", FormatInt32(Data->DockedAt));
-	SaveFloat(JsonObject,"Heat", Data->Heat);
-	SaveFloat(JsonObject,"PowerOutageDelay", Data->PowerOutageDelay);
-	SaveFloat(JsonObject,"PowerOutageAcculumator", Data->PowerOutageAcculumator);
-	JsonObject->SetStringField("DynamicComponentStateIdentifier", Data->DynamicComponentStateIdentifier.ToString());
-	SaveFloat(JsonObject,"DynamicComponentStateProgress", Data->DynamicComponentStateProgress);
-	JsonObject->SetStringField("Level", FormatInt32(Data->Level));
-	JsonObject->SetBoolField("IsTrading", Data->IsTrading);
-	JsonObject->SetBoolField("IsIntercepted", Data->IsIntercepted);
-	SaveFloat(JsonObject,"RefillStock", Data->RefillStock);
-	SaveFloat(JsonObject,"RepairStock", Data->RepairStock);
-	JsonObject->SetBoolField("IsReserve", Data->IsReserve);
-	JsonObject->SetObjectField("Pilot", SavePilot(&Data->Pilot));
-	JsonObject->SetObjectField("Asteroid", SaveAsteroid(&Data->AsteroidData));
-	JsonObject->SetStringField("HarpoonCompany", Data->HarpoonCompany.ToString());
-	JsonObject->SetStringField("AttachActorName", Data->AttachActorName.ToString());
-
-	TArray< TSharedPtr<FJsonValue> > Components;
+	Output->WriteBool("IsDestroyed", Data->IsDestroyed);
+	Output->WriteBool("IsUnderConstruction", Data->IsUnderConstruction);
+	Output->WriteString("Immatriculation", Data->Immatriculation.ToString());
+	Output->WriteString("NickName", Data->NickName.ToString());
+	Output->WriteString("Identifier", Data->Identifier.ToString());
+	Output->WriteString("CompanyIdentifier", Data->CompanyIdentifier.ToString());
+	Output->WriteString("Location", FormatVector(Data->Location));
+	Output->WriteString("Rotation", FormatRotator(Data->Rotation));
+	Output->WriteString("SpawnMode", FormatEnum<EFlareSpawnMode::Type>("EFlareSpawnMode",Data->SpawnMode));
+	Output->WriteString("LinearVelocity", FormatVector(Data->LinearVelocity));
+	Output->WriteString("AngularVelocity", FormatVector(Data->AngularVelocity));
+	Output->WriteString("DockedTo", Data->DockedTo.ToString());
+	Output->WriteString("DockedAt", FormatInt32(Data->DockedAt));
+	SaveFloat("Heat", Data->Heat);
+	SaveFloat("PowerOutageDelay", Data->PowerOutageDelay);
+	SaveFloat("PowerOutageAcculumator", Data->PowerOutageAcculumator);
+	Output->WriteString("DynamicComponentStateIdentifier", Data->DynamicComponentStateIdentifier.ToString());
+	SaveFloat("DynamicComponentStateProgress", Data->DynamicComponentStateProgress);
+	Output->WriteString("Level", FormatInt32(Data->Level));
+	Output->WriteBool("IsTrading", Data->IsTrading);
+	Output->WriteBool("IsIntercepted", Data->IsIntercepted);
+	SaveFloat("RefillStock", Data->RefillStock);
+	SaveFloat("RepairStock", Data->RepairStock);
+	Output->WriteBool("IsReserve", Data->IsReserve);
+	SavePilot("Pilot", &Data->Pilot);
+	SaveAsteroid("Asteroid", &Data->AsteroidData);
+	Output->WriteString("HarpoonCompany", Data->HarpoonCompany.ToString());
+	Output->WriteString("AttachActorName", Data->AttachActorName.ToString());
+
+	Output->WriteArrayStart("Components");
 	for(int i = 0; i < Data->Components.Num(); i++)
 	{
-		Components.Add(MakeShareable(new FJsonValueObject(SaveSpacecraftComponent(&Data->Components[i]))));
+		SaveSpacecraftComponent(FString(), &Data->Components[i]);
 	}
-	JsonObject->SetArrayField("Components", Components);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > Cargo;
+	Output->WriteArrayStart("Cargo");
 	for(int i = 0; i < Data->Cargo.Num(); i++)
 	{
-		Cargo.Add(MakeShareable(new FJsonValueObject(SaveCargo(&Data->Cargo[i]))));
+		SaveCargo(FString(), &Data->Cargo[i]);
 	}
-	JsonObject->SetArrayField("Cargo", Cargo);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > CargoBackup;
+	Output->WriteArrayStart("CargoBackup");
 	for(int i = 0; i < Data->CargoBackup.Num(); i++)
 	{
-		CargoBackup.Add(MakeShareable(new FJsonValueObject(SaveCargo(&Data->CargoBackup[i]))));
+		SaveCargo(FString(), &Data->CargoBackup[i]);
 	}
-	JsonObject->SetArrayField("CargoBackup", CargoBackup);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > FactoryStates;
+	Output->WriteArrayStart("FactoryStates");
 	for(int i = 0; i < Data->FactoryStates.Num(); i++)
 	{
-		FactoryStates.Add(MakeShareable(new FJsonValueObject(SaveFactory(&Data->FactoryStates[i]))));
+		SaveFactory(FString(), &Data->FactoryStates[i]);
 	}
-	JsonObject->SetArrayField("FactoryStates", FactoryStates);
+	Output->WriteArrayEnd();
 
 
-	TArray< TSharedPtr<FJsonValue> > SalesExcludedResources;
+	Output->WriteArrayStart("SalesExcludedResources");
 	for(int i = 0; i < Data->SalesExcludedResources.Num(); i++)
 	{
-		SalesExcludedResources.Add(MakeShareable(new FJsonValueString(Data->SalesExcludedResources[i].ToString())));
+		Output->WriteString(FString(), Data->SalesExcludedResources[i].ToString());
 	}
-	JsonObject->SetArrayField("SalesExcludedResources", SalesExcludedResources);
+	Output->WriteArrayEnd();
 
 
 	TArray<FName> CapturePointCompanies;
 	Data->CapturePoints.GetKeys(CapturePointCompanies);
-	TArray< TSharedPtr<FJsonValue> > CapturePoints;
+	Output->WriteArrayStart("CapturePoints");
 	for(int i = 0; i < Data->CapturePoints.Num(); i++)
 	{
 		FName Company = CapturePointCompanies[i];
 		int32 Points = Data->CapturePoints[Company];
 
-		TSharedRef<FJsonObject> JsonChildObject = MakeShareable(new FJsonObject());
+		Output->WriteObjectStart(FString());
 
-		JsonChildObject->SetStringField("Company", Company.ToString());
-		JsonChildObject->SetStringField("Points", FormatInt32(Points));
+		Output->WriteString("Company", Company.ToString());
+		Output->WriteString("Points", FormatInt32(Points));
 
-		CapturePoints.Add(MakeShareable(new FJsonValueObject(JsonChildObject)));
+		Output->WriteObjectEnd();
 	}
-	JsonObject->SetArrayField("CapturePoints", CapturePoints);
+	Output->WriteArrayEnd();
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SavePilot(FFlareShipPilotSave* Data)
+void UFlareSaveWriter::SavePilot(const FString& Key, FFlareShipPilotSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("Identifier", Data->Identifier.ToString());
-	JsonObject->SetStringField("Name", Data->Name);
+	Output->WriteString("Identifier", Data->Identifier.ToString());
+	Output->WriteString("Name", Data->Name);
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveAsteroid(FFlareAsteroidSave* Data)
+void UFlareSaveWriter::SaveAsteroid(const FString& Key, FFlareAsteroidSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("Identifier", Data->Identifier.ToString());
-	JsonObject->SetStringField("Location", FormatVector(Data->Location));
-	JsonObject->SetStringField("Rotation", FormatRotator(Data->Rotation));
-	JsonObject->SetStringField("LinearVelocity", FormatVector(Data->LinearVelocity));
-	JsonObject->SetStringField("AngularVelocity", FormatVector(Data->AngularVelocity));
-	JsonObject->SetStringField("Scale", FormatVector(Data->Scale));
-	JsonObject->SetStringField("AsteroidMeshID", FormatInt32(Data->AsteroidMeshID));
+	Output->WriteString("Identifier", Data->Identifier.ToString());
+	Output->WriteString("Location", FormatVector(Data->Location));
+	Output->WriteString("Rotation", FormatRotator(Data->Rotation));
+	Output->WriteString("LinearVelocity", FormatVector(Data->LinearVelocity));
+	Output->WriteString("AngularVelocity", FormatVector(Data->AngularVelocity));
+	Output->WriteString("Scale", FormatVector(Data->Scale));
+	Output->WriteString("AsteroidMeshID", FormatInt32(Data->AsteroidMeshID));
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveSpacecraftComponent(FFlareSpacecraftComponentSave* Data)
+void UFlareSaveWriter::SaveSpacecraftComponent(const FString& Key, FFlareSpacecraftComponentSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("ComponentIdentifier", Data->ComponentIdentifier.ToString());
-	JsonObject->SetStringField("ShipSlotIdentifier", Data->ShipSlotIdentifier.ToString());
-	SaveFloat(JsonObject,"Damage", Data->Damage);
-	JsonObject->SetObjectField("Turret", SaveSpacecraftComponentTurret(&Data->Turret));
-	JsonObject->SetObjectField("Weapon", SaveSpacecraftComponentWeapon(&Data->Weapon));
-	JsonObject->SetObjectField("Pilot", SaveTurretPilot(&Data->Pilot));
+	Output->WriteString("ComponentIdentifier", Data->ComponentIdentifier.ToString());
+	Output->WriteString("ShipSlotIdentifier", Data->ShipSlotIdentifier.ToString());
+	SaveFloat("Damage", Data->Damage);
+	SaveSpacecraftComponentTurret("Turret", &Data->Turret);
+	SaveSpacecraftComponentWeapon("Weapon", &Data->Weapon);
+	SaveTurretPilot("Pilot", &Data->Pilot);
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveSpacecraftComponentTurret(FFlareSpacecraftComponentTurretSave* Data)
+void UFlareSaveWriter::SaveSpacecraftComponentTurret(const FString& Key, FFlareSpacecraftComponentTurretSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	SaveFloat(JsonObject,"TurretAngle", Data->TurretAngle);
-	SaveFloat(JsonObject,"BarrelsAngle", Data->BarrelsAngle);
+	SaveFloat("TurretAngle", Data->TurretAngle);
+	SaveFloat("BarrelsAngle", Data->BarrelsAngle);
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveSpacecraftComponentWeapon(FFlareSpacecraftComponentWeaponSave* Data)
+void UFlareSaveWriter::SaveSpacecraftComponentWeapon(const FString& Key, FFlareSpacecraftComponentWeaponSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("FiredAmmo", FormatInt32(Data->FiredAmmo));
+	Output->WriteString("FiredAmmo", FormatInt32(Data->FiredAmmo));
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveTurretPilot(FFlareTurretPilotSave* Data)
+void UFlareSaveWriter::SaveTurretPilot(const FString& Key, FFlareTurretPilotSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("Identifier", Data->Identifier.ToString());
-	JsonObject->SetStringField("Name", Data->Name);
+	Output->WriteString("Identifier", Data->Identifier.ToString());
+	Output->WriteString("Name", Data->Name);
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveTradeOperation(FFlareTradeRouteSectorOperationSave* Data)
+void UFlareSaveWriter::SaveTradeOperation(const FString& Key, FFlareTradeRouteSectorOperationSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("ResourceIdentifier", Data->ResourceIdentifier.ToString());
-	JsonObject->SetStringField("MaxQuantity", FormatInt32(Data->MaxQuantity));
-	JsonObject->SetStringField("MaxWait", FormatInt32(Data->MaxWait));
-	JsonObject->SetStringField("Type", FormatEnum<EFlareTradeRouteOperation::Type>("EFlareTradeRouteOperation",Data->Type));
+	Output->WriteString("ResourceIdentifier", Data->ResourceIdentifier.ToString());
+	Output->WriteString("MaxQuantity", FormatInt32(Data->MaxQuantity));
+	Output->WriteString("MaxWait", FormatInt32(Data->MaxWait));
+	Output->WriteString("Type", FormatEnum<EFlareTradeRouteOperation::Type>("EFlareTradeRouteOperation",Data->Type));
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveCargo(FFlareCargoSave* Data)
+void UFlareSaveWriter::SaveCargo(const FString& Key, FFlareCargoSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("ResourceIdentifier", Data->ResourceIdentifier.ToString());
-	JsonObject->SetStringField("Quantity", FormatInt32(Data->Quantity));
-	JsonObject->SetStringField("Lock", FormatEnum<EFlareResourceLock::Type>("EFlareResourceLock",Data->Lock));
-	JsonObject->SetStringField("Restriction", FormatEnum<EFlareResourceRestriction::Type>("EFlareResourceRestriction",Data->Restriction));
+	Output->WriteString("ResourceIdentifier", Data->ResourceIdentifier.ToString());
+	Output->WriteString("Quantity", FormatInt32(Data->Quantity));
+	Output->WriteString("Lock", FormatEnum<EFlareResourceLock::Type>("EFlareResourceLock",Data->Lock));
+	Output->WriteString("Restriction", FormatEnum<EFlareResourceRestriction::Type>("EFlareResourceRestriction",Data->Restriction));
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveFactory(FFlareFactorySave* Data)
+void UFlareSaveWriter::SaveFactory(const FString& Key, FFlareFactorySave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetBoolField("Active", Data->Active);
-	JsonObject->SetStringField("CostReserved", FormatInt32(Data->CostReserved));
-	JsonObject->SetStringField("ProductedDuration", FormatInt64(Data->ProductedDuration));
-	JsonObject->SetBoolField("InfiniteCycle", Data->InfiniteCycle);
-	JsonObject->SetStringField("CycleCount", FormatInt32(Data->CycleCount));
-	JsonObject->SetStringField("TargetShipClass", Data->TargetShipClass.ToString());
-	JsonObject->SetStringField("TargetShipCompany", Data->TargetShipCompany.ToString());
-	JsonObject->SetStringField("OrderShipClass", Data->OrderShipClass.ToString());
-	JsonObject->SetStringField("OrderShipCompany", Data->OrderShipCompany.ToString());
-	JsonObject->SetStringField("OrderShipAdvancePayment", FormatInt32(Data->OrderShipAdvancePayment));
+	Output->WriteBool("Active", Data->Active);
+	Output->WriteString("CostReserved", FormatInt32(Data->CostReserved));
+	Output->WriteString("ProductedDuration", FormatInt64(Data->ProductedDuration));
+	Output->WriteBool("InfiniteCycle", Data->InfiniteCycle);
+	Output->WriteString("CycleCount", FormatInt32(Data->CycleCount));
+	Output->WriteString("TargetShipClass", Data->TargetShipClass.ToString());
+	Output->WriteString("TargetShipCompany", Data->TargetShipCompany.ToString());
+	Output->WriteString("OrderShipClass", Data->OrderShipClass.ToString());
+	Output->WriteString("OrderShipCompany", Data->OrderShipCompany.ToString());
+	Output->WriteString("OrderShipAdvancePayment", FormatInt32(Data->OrderShipAdvancePayment));
 
-	TArray< TSharedPtr<FJsonValue> > ResourceReserved;
+	Output->WriteArrayStart("ResourceReserved");
 	for(int i = 0; i < Data->ResourceReserved.Num(); i++)
 	{
-		ResourceReserved.Add(MakeShareable(new FJsonValueObject(SaveCargo(&Data->ResourceReserved[i]))));
+		SaveCargo(FString(), &Data->ResourceReserved[i]);
 	}
-	JsonObject->SetArrayField("ResourceReserved", ResourceReserved);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > OutputCargoLimit;
+	Output->WriteArrayStart("OutputCargoLimit");
 	for(int i = 0; i < Data->OutputCargoLimit.Num(); i++)
 	{
-		OutputCargoLimit.Add(MakeShareable(new FJsonValueObject(SaveCargo(&Data->OutputCargoLimit[i]))));
+		SaveCargo(FString(), &Data->OutputCargoLimit[i]);
 	}
-	JsonObject->SetArrayField("OutputCargoLimit", OutputCargoLimit);
+	Output->WriteArrayEnd();
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
 //////////////////
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveFleet(FFlareFleetSave* Data)
+void UFlareSaveWriter::SaveFleet(const FString& Key, FFlareFleetSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("Name", Data->Name.ToString());
-	JsonObject->SetStringField("Identifier", Data->Identifier.ToString());
+	Output->WriteString("Name", Data->Name.ToString());
+	Output->WriteString("Identifier", Data->Identifier.ToString());
 
-	TArray< TSharedPtr<FJsonValue> > ShipImmatriculations;
+	Output->WriteArrayStart("ShipImmatriculations");
 	for(int i = 0; i < Data->ShipImmatriculations.Num(); i++)
 	{
-		ShipImmatriculations.Add(MakeShareable(new FJsonValueString(Data->ShipImmatriculations[i].ToString())));
+		Output->WriteString(FString(), Data->ShipImmatriculations[i].ToString());
 	}
-	JsonObject->SetArrayField("ShipImmatriculations", ShipImmatriculations);
+	Output->WriteArrayEnd();
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveTradeRoute(FFlareTradeRouteSave* Data)
+void UFlareSaveWriter::SaveTradeRoute(const FString& Key, FFlareTradeRouteSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("Name", Data->Name.ToString());
-	JsonObject->SetStringField("Identifier", Data->Identifier.ToString());
-	JsonObject->SetStringField("FleetIdentifier", Data->FleetIdentifier.ToString());
-	JsonObject->SetStringField("TargetSectorIdentifier", Data->TargetSectorIdentifier.ToString());
-	JsonObject->SetStringField("CurrentOperationIndex", FormatInt32(Data->CurrentOperationIndex));
-	JsonObject->SetStringField("CurrentOperationProgress", FormatInt32(Data->CurrentOperationProgress));
-	JsonObject->SetStringField("CurrentOperationDuration", FormatInt32(Data->CurrentOperationDuration));
-	JsonObject->SetBoolField("IsPaused", Data->IsPaused);
+	Output->WriteString("Name", Data->Name.ToString());
+	Output->WriteString("Identifier", Data->Identifier.ToString());
+	Output->WriteString("FleetIdentifier", Data->FleetIdentifier.ToString());
+	Output->WriteString("TargetSectorIdentifier", Data->TargetSectorIdentifier.ToString());
+	Output->WriteString("CurrentOperationIndex", FormatInt32(Data->CurrentOperationIndex));
+	Output->WriteString("CurrentOperationProgress", FormatInt32(Data->CurrentOperationProgress));
+	Output->WriteString("CurrentOperationDuration", FormatInt32(Data->CurrentOperationDuration));
+	Output->WriteBool("IsPaused", Data->IsPaused);
 
-	TArray< TSharedPtr<FJsonValue> > Sectors;
+	Output->WriteArrayStart("Sectors");
 	for(int i = 0; i < Data->Sectors.Num(); i++)
 	{
-		Sectors.Add(MakeShareable(new FJsonValueObject(SaveTradeRouteSector(&Data->Sectors[i]))));
+		SaveTradeRouteSector(FString(), &Data->Sectors[i]);
 	}
-	JsonObject->SetArrayField("Sectors", Sectors);
+	Output->WriteArrayEnd();
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveTradeRouteSector(FFlareTradeRouteSectorSave* Data)
+void UFlareSaveWriter::SaveTradeRouteSector(const FString& Key, FFlareTradeRouteSectorSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("SectorIdentifier", Data->SectorIdentifier.ToString());
+	Output->WriteString("SectorIdentifier", Data->SectorIdentifier.ToString());
 
 
-	TArray< TSharedPtr<FJsonValue> > Operations;
+	Output->WriteArrayStart("Operations");
 	for(int i = 0; i < Data->Operations.Num(); i++)
 	{
-		Operations.Add(MakeShareable(new FJsonValueObject(SaveTradeOperation(&Data->Operations[i]))));
+		SaveTradeOperation(FString(), &Data->Operations[i]);
 	}
-	JsonObject->SetArrayField("Operations", Operations);
+	Output->WriteArrayEnd();
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveSectorKnowledge(FFlareCompanySectorKnowledge* Data)
+void UFlareSaveWriter::SaveSectorKnowledge(const FString& Key, FFlareCompanySectorKnowledge* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("SectorIdentifier", Data->SectorIdentifier.ToString());
-	JsonObject->SetStringField("Knowledge", FormatEnum<EFlareSectorKnowledge::Type>("EFlareSectorKnowledge",Data->Knowledge));
+	Output->WriteString("SectorIdentifier", Data->SectorIdentifier.ToString());
+	Output->WriteString("Knowledge", FormatEnum<EFlareSectorKnowledge::Type>("EFlareSectorKnowledge",Data->Knowledge));
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveCompanyAI(FFlareCompanyAISave* Data)
+void UFlareSaveWriter::SaveCompanyAI(const FString& Key, FFlareCompanyAISave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("BudgetMilitary", FormatInt64(Data->BudgetMilitary));
-	JsonObject->SetStringField("BudgetStation", FormatInt64(Data->BudgetStation));
-	JsonObject->SetStringField("BudgetTechnology", FormatInt64(Data->BudgetTechnology));
-	JsonObject->SetStringField("BudgetTrade", FormatInt64(Data->BudgetTrade));
-	SaveFloat(JsonObject,"Caution", Data->Caution);
-	SaveFloat(JsonObject,"Pacifism", Data->Pacifism);
-	JsonObject->SetStringField("ResearchProject", Data->ResearchProject.ToString());
+	Output->WriteString("BudgetMilitary", FormatInt64(Data->BudgetMilitary));
+	Output->WriteString("BudgetStation", FormatInt64(Data->BudgetStation));
+	Output->WriteString("BudgetTechnology", FormatInt64(Data->BudgetTechnology));
+	Output->WriteString("BudgetTrade", FormatInt64(Data->BudgetTrade));
+	SaveFloat("Caution", Data->Caution);
+	SaveFloat("Pacifism", Data->Pacifism);
+	Output->WriteString("ResearchProject", Data->ResearchProject.ToString());
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveCompanyReputation(FFlareCompanyReputationSave* Data)
+void UFlareSaveWriter::SaveCompanyReputation(const FString& Key, FFlareCompanyReputationSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("CompanyIdentifier", Data->CompanyIdentifier.ToString());
-	SaveFloat(JsonObject,"Reputation", Data->Reputation);
+	Output->WriteString("CompanyIdentifier", Data->CompanyIdentifier.ToString());
+	SaveFloat("Reputation", Data->Reputation);
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveSector(FFlareSectorSave* Data)
+void UFlareSaveWriter::SaveSector(const FString& Key, FFlareSectorSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("GivenName", Data->GivenName.ToString());
-	JsonObject->SetStringField("Identifier", Data->Identifier.ToString());
-	JsonObject->SetStringField("LocalTime", FormatInt64(Data->LocalTime));
-	JsonObject->SetObjectField("People", SavePeople(&Data->PeopleData));
+	Output->WriteString("GivenName", Data->GivenName.ToString());
+	Output->WriteString("Identifier", Data->Identifier.ToString());
+	Output->WriteString("LocalTime", FormatInt64(Data->LocalTime));
+	SavePeople("People", &Data->PeopleData);
 
 
-	TArray< TSharedPtr<FJsonValue> > Bombs;
+	Output->WriteArrayStart("Bombs");
 	for(int i = 0; i < Data->BombData.Num(); i++)
 	{
-		Bombs.Add(MakeShareable(new FJsonValueObject(SaveBomb(&Data->BombData[i]))));
+		SaveBomb(FString(), &Data->BombData[i]);
 	}
-	JsonObject->SetArrayField("Bombs", Bombs);
+	Output->WriteArrayEnd();
 
 
-	TArray< TSharedPtr<FJsonValue> > Asteroids;
+	Output->WriteArrayStart("Asteroids");
 	for(int i = 0; i < Data->AsteroidData.Num(); i++)
 	{
-		Asteroids.Add(MakeShareable(new FJsonValueObject(SaveAsteroid(&Data->AsteroidData[i]))));
+		SaveAsteroid(FString(), &Data->AsteroidData[i]);
 	}
-	JsonObject->SetArrayField("Asteroids", Asteroids);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > FleetIdentifiers;
+	Output->WriteArrayStart("FleetIdentifiers");
 	for(int i = 0; i < Data->FleetIdentifiers.Num(); i++)
 	{
-		FleetIdentifiers.Add(MakeShareable(new FJsonValueString(Data->FleetIdentifiers[i].ToString())));
+		Output->WriteString(FString(), Data->FleetIdentifiers[i].ToString());
 	}
-	JsonObject->SetArrayField("FleetIdentifiers", FleetIdentifiers);
+	Output->WriteArrayEnd();
 
-	TArray< TSharedPtr<FJsonValue> > SpacecraftIdentifiers;
+	Output->WriteArrayStart("SpacecraftIdentifiers");
 	for(int i = 0; i < Data->SpacecraftIdentifiers.Num(); i++)
 	{
-		SpacecraftIdentifiers.Add(MakeShareable(new FJsonValueString(Data->SpacecraftIdentifiers[i].ToString())));
+		Output->WriteString(FString(), Data->SpacecraftIdentifiers[i].ToString());
 	}
-	JsonObject->SetArrayField("SpacecraftIdentifiers", SpacecraftIdentifiers);
+	Output->WriteArrayEnd();
 
 
-	TArray< TSharedPtr<FJsonValue> > ResourcePrices;
+	Output->WriteArrayStart("ResourcePrices");
 	for(int i = 0; i < Data->ResourcePrices.Num(); i++)
 	{
-		ResourcePrices.Add(MakeShareable(new FJsonValueObject(SaveResourcePrice(&Data->ResourcePrices[i]))));
+		SaveResourcePrice(FString(), &Data->ResourcePrices[i]);
 	}
-	JsonObject->SetArrayField("ResourcePrices", ResourcePrices);
+	Output->WriteArrayEnd();
 
-	JsonObject->SetBoolField("IsTravelSector", Data->IsTravelSector);
+	Output->WriteBool("IsTravelSector", Data->IsTravelSector);
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SavePeople(FFlarePeopleSave* Data)
+void UFlareSaveWriter::SavePeople(const FString& Key, FFlarePeopleSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("Population", FormatInt32(Data->Population));
-	JsonObject->SetStringField("FoodStock", FormatInt32(Data->FoodStock));
-	JsonObject->SetStringField("FuelStock", FormatInt32(Data->FuelStock));
-	JsonObject->SetStringField("ToolStock", FormatInt32(Data->ToolStock));
-	JsonObject->SetStringField("TechStock", FormatInt32(Data->TechStock));
-	SaveFloat(JsonObject,"FoodConsumption", Data->FoodConsumption);
-	SaveFloat(JsonObject,"FuelConsumption", Data->FuelConsumption);
-	SaveFloat(JsonObject,"ToolConsumption", Data->ToolConsumption);
-	SaveFloat(JsonObject,"TechConsumption", Data->TechConsumption);
-	JsonObject->SetStringField("Money", FormatInt32(Data->Money));
-	JsonObject->SetStringField("Dept", FormatInt32(Data->Dept));
-	JsonObject->SetStringField("BirthPoint", FormatInt32(Data->BirthPoint));
-	JsonObject->SetStringField("DeathPoint", FormatInt32(Data->DeathPoint));
-	JsonObject->SetStringField("HungerPoint", FormatInt32(Data->HungerPoint));
-	JsonObject->SetStringField("HappinessPoint", FormatInt32(Data->HappinessPoint));
+	Output->WriteString("Population", FormatInt32(Data->Population));
+	Output->WriteString("FoodStock", FormatInt32(Data->FoodStock));
+	Output->WriteString("FuelStock", FormatInt32(Data->FuelStock));
+	Output->WriteString("ToolStock", FormatInt32(Data->ToolStock));
+	Output->WriteString("TechStock", FormatInt32(Data->TechStock));
+	SaveFloat("FoodConsumption", Data->FoodConsumption);
+	SaveFloat("FuelConsumption", Data->FuelConsumption);
+	SaveFloat("ToolConsumption", Data->ToolConsumption);
+	SaveFloat("TechConsumption", Data->TechConsumption);
+	Output->WriteString("Money", FormatInt32(Data->Money));
+	Output->WriteString("Dept", FormatInt32(Data->Dept));
+	Output->WriteString("BirthPoint", FormatInt32(Data->BirthPoint));
+	Output->WriteString("DeathPoint", FormatInt32(Data->DeathPoint));
+	Output->WriteString("HungerPoint", FormatInt32(Data->HungerPoint));
+	Output->WriteString("HappinessPoint", FormatInt32(Data->HappinessPoint));
 
-	TArray< TSharedPtr<FJsonValue> > CompanyReputations;
+	Output->WriteArrayStart("CompanyReputations");
 	for(int i = 0; i < Data->CompanyReputations.Num(); i++)
 	{
-		CompanyReputations.Add(MakeShareable(new FJsonValueObject(SaveCompanyReputation(&Data->CompanyReputations[i]))));
+		SaveCompanyReputation(FString(), &Data->CompanyReputations[i]);
 	}
-	JsonObject->SetArrayField("CompanyReputations", CompanyReputations);
+	Output->WriteArrayEnd();
 
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveBomb(FFlareBombSave* Data)
+void UFlareSaveWriter::SaveBomb(const FString& Key, FFlareBombSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("Identifier", Data->Identifier.ToString());
-	JsonObject->SetStringField("Location", FormatVector(Data->Location));
-	JsonObject->SetStringField("Rotation", FormatRotator(Data->Rotation));
-	JsonObject->SetStringField("LinearVelocity", FormatVector(Data->LinearVelocity));
-	JsonObject->SetStringField("AngularVelocity", FormatVector(Data->AngularVelocity));
-	JsonObject->SetStringField("WeaponSlotIdentifier", Data->WeaponSlotIdentifier.ToString());
-	JsonObject->SetStringField("AimTargetSpacecraft", Data->AimTargetSpacecraft.ToString());
-	JsonObject->SetStringField("ParentSpacecraft", Data->ParentSpacecraft.ToString());
-	JsonObject->SetStringField("AttachTarget", Data->AttachTarget.ToString());
-	JsonObject->SetBoolField("Activated", Data->Activated);
-	JsonObject->SetBoolField("Dropped", Data->Dropped);
-	JsonObject->SetBoolField("Locked", Data->Locked);
-	SaveFloat(JsonObject,"DropParentDistance", Data->DropParentDistance);
-	SaveFloat(JsonObject,"LifeTime", Data->LifeTime);
-	SaveFloat(JsonObject,"BurnDuration", Data->BurnDuration);
+	Output->WriteString("Identifier", Data->Identifier.ToString());
+	Output->WriteString("Location", FormatVector(Data->Location));
+	Output->WriteString("Rotation", FormatRotator(Data->Rotation));
+	Output->WriteString("LinearVelocity", FormatVector(Data->LinearVelocity));
+	Output->WriteString("AngularVelocity", FormatVector(Data->AngularVelocity));
+	Output->WriteString("WeaponSlotIdentifier", Data->WeaponSlotIdentifier.ToString());
+	Output->WriteString("AimTargetSpacecraft", Data->AimTargetSpacecraft.ToString());
+	Output->WriteString("ParentSpacecraft", Data->ParentSpacecraft.ToString());
+	Output->WriteString("AttachTarget", Data->AttachTarget.ToString());
+	Output->WriteBool("Activated", Data->Activated);
+	Output->WriteBool("Dropped", Data->Dropped);
+	Output->WriteBool("Locked", Data->Locked);
+	SaveFloat("DropParentDistance", Data->DropParentDistance);
+	SaveFloat("LifeTime", Data->LifeTime);
+	SaveFloat("BurnDuration", Data->BurnDuration);
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveResourcePrice(FFFlareResourcePrice* Data)
+void UFlareSaveWriter::SaveResourcePrice(const FString& Key, FFFlareResourcePrice* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("ResourceIdentifier", Data->ResourceIdentifier.ToString());
-	SaveFloat(JsonObject,"Price", Data->Price);
-	JsonObject->SetObjectField("Prices", SaveFloatBuffer(&Data->Prices));
+	Output->WriteString("ResourceIdentifier", Data->ResourceIdentifier.ToString());
+	SaveFloat("Price", Data->Price);
+	SaveTimeSeries("Prices", &Data->Prices);
 
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveFloatBuffer(FFlareFloatBuffer* Data)
+void UFlareSaveWriter::SaveTimeSeries(const FString& Key, FFlareTimeSeries* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("MaxSize", FormatInt32(Data->MaxSize));
-	JsonObject->SetStringField("WriteIndex", FormatInt32(Data->WriteIndex));
+	Output->WriteString("MaxSize", FormatInt32(Data->MaxSize));
+	Output->WriteString("WriteIndex", FormatInt32(Data->WriteIndex));
 
 
 
-	TArray< TSharedPtr<FJsonValue> > Values;
+	Output->WriteArrayStart("Values");
 	for(int i = 0; i < Data->Values.Num(); i++)
 	{
-		Values.Add(MakeShareable(new FJsonValueNumber(Data->Values[i])));
+		Output->WriteNumber(FString(), Data->Values[i]);
 	}
-	JsonObject->SetArrayField("Values", Values);
+	Output->WriteArrayEnd();
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveBundle(FFlareBundle* Data)
+void UFlareSaveWriter::SaveBundle(const FString& Key, FFlareBundle* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
 	if(Data->FloatValues.Num() > 0)
 	{
-		TSharedRef<FJsonObject> FloatObject = MakeShareable(new FJsonObject());
+		Output->WriteObjectStart("FloatValues");
 		for (auto& Pair : Data->FloatValues)
 		{
-			FloatObject->SetNumberField(Pair.Key.ToString(), FixFloat(Pair.Value));
+			Output->WriteNumber(Pair.Key.ToString(), FixFloat(Pair.Value));
 		}
-		JsonObject->SetObjectField("FloatValues", FloatObject);
+		Output->WriteObjectEnd();
 	}
 
 	if(Data->Int32Values.Num() > 0)
 	{
-		TSharedRef<FJsonObject> Int32Object = MakeShareable(new FJsonObject());
+		Output->WriteObjectStart("Int32Values");
 		for (auto& Pair : Data->Int32Values)
 		{
-			Int32Object->SetStringField(Pair.Key.ToString(), FormatInt32(Pair.Value));
+			Output->WriteString(Pair.Key.ToString(), FormatInt32(Pair.Value));
 		}
-		JsonObject->SetObjectField("Int32Values", Int32Object);
+		Output->WriteObjectEnd();
 	}
 
 	if(Data->TransformValues.Num() > 0)
 	{
-		TSharedRef<FJsonObject> TransformObject = MakeShareable(new FJsonObject());
+		Output->WriteObjectStart("TransformValues");
 		for (auto& Pair : Data->TransformValues)
 		{
-			TransformObject->SetStringField(Pair.Key.ToString(), FormatTransform(Pair.Value));
+			Output->WriteString(Pair.Key.ToString(), FormatTransform(Pair.Value));
 		}
-		JsonObject->SetObjectField("TransformValues", TransformObject);
+		Output->WriteObjectEnd();
 	}
 
 	if(Data->VectorArrayValues.Num() > 0)
 	{
-		TSharedRef<FJsonObject> TransformObject = MakeShareable(new FJsonObject());
+		Output->WriteObjectStart("VectorArrayValues");
 		for (auto& Pair : Data->VectorArrayValues)
 		{
-			TArray< TSharedPtr<FJsonValue> > VectorArray;
+			Output->WriteArrayStart(Pair.Key.ToString());
 			for(FVector Vector: Pair.Value.Entries)
 			{
-				VectorArray.Add(MakeShareable(new FJsonValueString(FormatVector(Vector))));
+				Output->WriteString(FString(), FormatVector(Vector));
 			}
-
-			TransformObject->SetArrayField(Pair.Key.ToString(), VectorArray);
+			Output->WriteArrayEnd();
 		}
-		JsonObject->SetObjectField("VectorArrayValues", TransformObject);
+		Output->WriteObjectEnd();
 	}
 
 	if(Data->NameValues.Num() > 0)
 	{
-		TSharedRef<FJsonObject> Int32Object = MakeShareable(new FJsonObject());
+		Output->WriteObjectStart("NameValues");
 		for (auto& Pair : Data->NameValues)
 		{
-			Int32Object->SetStringField(Pair.Key.ToString(), Pair.Value.ToString());
+			Output->WriteString(Pair.Key.ToString(), Pair.Value.ToString());
 		}
-		JsonObject->SetObjectField("NameValues", Int32Object);
+		Output->WriteObjectEnd();
 	}
 	
 	if(Data->NameArrayValues.Num() > 0)
 	{
-		TSharedRef<FJsonObject> TransformObject = MakeShareable(new FJsonObject());
+		Output->WriteObjectStart("NameArrayValues");
 		for (auto& Pair : Data->NameArrayValues)
 		{
-			TArray< TSharedPtr<FJsonValue> > NameArray;
+			Output->WriteArrayStart(Pair.Key.ToString());
 			for(FName Name: Pair.Value.Entries)
 			{
-				NameArray.Add(MakeShareable(new FJsonValueString(Name.ToString())));
+				Output->WriteString(FString(), Name.ToString());
 			}
-
-			TransformObject->SetArrayField(Pair.Key.ToString(), NameArray);
+			Output->WriteArrayEnd();
 		}
-		JsonObject->SetObjectField("NameArrayValues", TransformObject);
+		Output->WriteObjectEnd();
 	}
 
 	if (Data->StringValues.Num() > 0)
 	{
-		TSharedRef<FJsonObject> StringObject = MakeShareable(new FJsonObject());
+		Output->WriteObjectStart("StringValues");
 		for (auto& Pair : Data->StringValues)
 		{
-			StringObject->SetStringField(Pair.Key.ToString(), Pair.Value);
+			Output->WriteString(Pair.Key.ToString(), Pair.Value);
 		}
-		JsonObject->SetObjectField("StringValues", StringObject);
+		Output->WriteObjectEnd();
 	}
 
 	if (Data->Tags.Num() > 0)
 	{
-		TArray< TSharedPtr<FJsonValue> > Tags;
+		Output->WriteArrayStart("Tags");
 		for(int i = 0; i < Data->Tags.Num(); i++)
 		{
-			Tags.Add(MakeShareable(new FJsonValueString(Data->Tags[i].ToString())));
+			Output->WriteString(FString(), Data->Tags[i].ToString());
 		}
-		JsonObject->SetArrayField("Tags", Tags);
+		Output->WriteArrayEnd();
 	}
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-TSharedRef<FJsonObject> UFlareSaveWriter::SaveTravel(FFlareTravelSave* Data)
+void UFlareSaveWriter::SaveTravel(const FString& Key, FFlareTravelSave* Data)
 {
-	TSharedRef<FJsonObject> JsonObject = MakeShareable(new FJsonObject());
+	Output->WriteObjectStart(Key);
 
-	JsonObject->SetStringField("FleetIdentifier", Data->FleetIdentifier.ToString());
-	JsonObject->SetStringField("OriginSectorIdentifier", Data->OriginSectorIdentifier.ToString());
-	JsonObject->SetStringField("DestinationSectorIdentifier", Data->DestinationSectorIdentifier.ToString());
-	JsonObject->SetStringField("DepartureDate", FormatInt64(Data->DepartureDate));
+	Output->WriteString("FleetIdentifier", Data->FleetIdentifier.ToString());
+	Output->WriteString("OriginSectorIdentifier", Data->OriginSectorIdentifier.ToString());
+	Output->WriteString("DestinationSectorIdentifier", Data->DestinationSectorIdentifier.ToString());
+	Output->WriteString("DepartureDate", FormatInt64(Data->DepartureDate));
 
-	JsonObject->SetObjectField("SectorData", SaveSector(&Data->SectorData));
+	SaveSector("SectorData", &Data->SectorData);
 
-	return JsonObject;
+	Output->WriteObjectEnd();
 }
 
-void UFlareSaveWriter::SaveFloat(TSharedPtr< FJsonObject > Object, FString Key, float Data)
+void UFlareSaveWriter::SaveFloat(const FString& Key, float Data)
 {
-	Object->SetNumberField(Key, FixFloat(Data));
+	Output->WriteNumber(Key, FixFloat(Data));
 }
@@ -6,6 +6,8 @@
 
 
 struct FFlarePlayerSave;
+struct FFlareSaveSummary;
+class FFlareSaveWriterOutput;
 struct FFlareQuestSave;
 struct FFlareQuestProgressSave;
 struct FFlareGeneratedQuestSave;
@@ -40,7 +42,7 @@ struct FFlarePeopleSave;
 struct FFlareBombSave;
 struct FFFlareResourcePrice;
 struct FFlareTravelSave;
-struct FFlareFloatBuffer;
+struct FFlareTimeSeries;
 
 
 
@@ -51,55 +53,64 @@ class HELIUMRAIN_API UFlareSaveWriter: public UObject
 
 public:
 
+	/** Build the save tree in memory */
 	TSharedRef<FJsonObject> SaveGame(UFlareSaveGame* Data);
 
+	/** Send the save tree to an output as it is generated */
+	void SaveGame(UFlareSaveGame* Data, FFlareSaveWriterOutput* SaveOutput);
+
+	TSharedRef<FJsonObject> SaveSummary(FFlareSaveSummary* Data);
+
 protected:
 	/*----------------------------------------------------
 	  Generator
 	----------------------------------------------------*/
 
-	TSharedRef<FJsonObject> SavePlayer(FFlarePlayerSave* Data);
-	TSharedRef<FJsonObject> SaveQuest(FFlareQuestSave* Data);
-	TSharedRef<FJsonObject> SaveQuestProgress(FFlareQuestProgressSave* Data);
-	TSharedRef<FJsonObject> SaveGeneratedQuest(FFlareGeneratedQuestSave* Data);
-	TSharedRef<FJsonObject> SaveQuestStepProgress(FFlareQuestConditionSave* Data);
+	void GenerateGame(const FString& Key, UFlareSaveGame* Data);
+	void GenerateSummary(const FString& Key, FFlareSaveSummary* Data);
+
+	void SavePlayer(const FString& Key, FFlarePlayerSave* Data);
+	void SaveQuest(const FString& Key, FFlareQuestSave* Data);
+	void SaveQuestProgress(const FString& Key, FFlareQuestProgressSave* Data);
+	void SaveGeneratedQuest(const FString& Key, FFlareGeneratedQuestSave* Data);
+	void SaveQuestStepProgress(const FString& Key, FFlareQuestConditionSave* Data);
 
-	TSharedRef<FJsonObject> SaveCompanyDescription(FFlareCompanyDescription* Data);
-	TSharedRef<FJsonObject> SaveWorld(FFlareWorldSave* Data);
+	void SaveCompanyDescription(const FString& Key, FFlareCompanyDescription* Data);
+	void SaveWorld(const FString& Key, FFlareWorldSave* Data);
 
 
-	TSharedRef<FJsonObject> SaveCompany(FFlareCompanySave* Data);
+	void SaveCompany(const FString& Key, FFlareCompanySave* Data);
 
-	TSharedRef<FJsonObject> SaveSpacecraft(FFlareSpacecraftSave* Data);
-	TSharedRef<FJsonObject> SavePilot(FFlareShipPilotSave* Data);
-	TSharedRef<FJsonObject> SaveAsteroid(FFlareAsteroidSave* Data);
-	TSharedRef<FJsonObject> SaveSpacecraftComponent(FFlareSpacecraftComponentSave* Data);
-	TSharedRef<FJsonObject> SaveSpacecraftComponentTurret(FFlareSpacecraftComponentTurretSave* Data);
-	TSharedRef<FJsonObject> SaveSpacecraftComponentWeapon(FFlareSpacecraftComponentWeaponSave* Data);
-	TSharedRef<FJsonObject> SaveTurretPilot(FFlareTurretPilotSave* Data);
+	void SaveSpacecraft(const FString& Key, FFlareSpacecraftSave* Data);
+	void SavePilot(const FString& Key, FFlareShipPilotSave* Data);
+	void SaveAsteroid(const FString& Key, FFlareAsteroidSave* Data);
+	void SaveSpacecraftComponent(const FString& Key, FFlareSpacecraftComponentSave* Data);
+	void SaveSpacecraftComponentTurret(const FString& Key, FFlareSpacecraftComponentTurretSave* Data);
+	void SaveSpacecraftComponentWeapon(const FString& Key, FFlareSpacecraftComponentWeaponSave* Data);
+	void SaveTurretPilot(const FString& Key, FFlareTurretPilotSave* Data);
 
-	TSharedRef<FJsonObject> SaveTradeOperation(FFlareTradeRouteSectorOperationSave* Data);
-	TSharedRef<FJsonObject> SaveCargo(FFlareCargoSave* Data);
-	TSharedRef<FJsonObject> SaveFactory(FFlareFactorySave* Data);
+	void SaveTradeOperation(const FString& Key, FFlareTradeRouteSectorOperationSave* Data);
+	void SaveCargo(const FString& Key, FFlareCargoSave* Data);
+	void SaveFactory(const FString& Key, FFlareFactorySave* Data);
 
-	TSharedRef<FJsonObject> SaveFleet(FFlareFleetSave* Data);
-	TSharedRef<FJsonObject> SaveTradeRoute(FFlareTradeRouteSave* Data);
-	TSharedRef<FJsonObject> SaveTradeRouteSector(FFlareTradeRouteSectorSave* Data);
-	TSharedRef<FJsonObject> SaveSectorKnowledge(FFlareCompanySectorKnowledge* Data);
-	TSharedRef<FJsonObject> SaveCompanyAI(FFlareCompanyAISave* Data);
-	TSharedRef<FJsonObject> SaveCompanyReputation(FFlareCompanyReputationSave* Data);
+	void SaveFleet(const FString& Key, FFlareFleetSave* Data);
+	void SaveTradeRoute(const FString& Key, FFlareTradeRouteSave* Data);
+	void SaveTradeRouteSector(const FString& Key, FFlareTradeRouteSectorSave* Data);
+	void SaveSectorKnowledge(const FString& Key, FFlareCompanySectorKnowledge* Data);
+	void SaveCompanyAI(const FString& Key, FFlareCompanyAISave* Data);
+	void SaveCompanyReputation(const FString& Key, FFlareCompanyReputationSave* Data);
 
 
-	TSharedRef<FJsonObject> SaveSector(FFlareSectorSave* Data);
-	TSharedRef<FJsonObject> SavePeople(FFlarePeopleSave* Data);
-	TSharedRef<FJsonObject> SaveBomb(FFlareBombSave* Data);
-	TSharedRef<FJsonObject> SaveResourcePrice(FFFlareResourcePrice* Data);
-	TSharedRef<FJsonObject> SaveFloatBuffer(FFlareFloatBuffer* Data);
-	TSharedRef<FJsonObject> SaveBundle(FFlareBundle* Data);
+	void SaveSector(const FString& Key, FFlareSectorSave* Data);
+	void SavePeople(const FString& Key, FFlarePeopleSave* Data);
+	void SaveBomb(const FString& Key, FFlareBombSave* Data);
+	void SaveResourcePrice(const FString& Key, FFFlareResourcePrice* Data);
+	void SaveTimeSeries(const FString& Key, FFlareTimeSeries* Data);
+	void SaveBundle(const FString& Key, FFlareBundle* Data);
 
-	TSharedRef<FJsonObject> SaveTravel(FFlareTravelSave* Data);
+	void SaveTravel(const FString& Key, FFlareTravelSave* Data);
 
-	void SaveFloat(TSharedPtr< FJsonObject > Object, FString Key, float Data);
+	void SaveFloat(const FString& Key, float Data);
 
 
 
@@ -107,6 +118,8 @@ protected:
 		Protected data
 	----------------------------------------------------*/
 
+	/** Destination of the generated events, during a save */
+	FFlareSaveWriterOutput*                  Output;
 
 
 public:
@@ -0,0 +1,217 @@
+
+#include "../../Flare.h"
+#include "FlareSaveWriterOutput.h"
+
+#define FLARE_SAVE_STREAM_BUFFER_SIZE 65536
+
+
+/*----------------------------------------------------
+	Object output
+----------------------------------------------------*/
+
+void FFlareSaveObjectOutput::WriteObjectStart(const FString& Key)
+{
+	FScope Scope;
+	Scope.Key = Key;
+	Scope.Object = MakeShareable(new FJsonObject());
+	Stack.Push(Scope);
+}
+
+void FFlareSaveObjectOutput::WriteObjectEnd()
+{
+	FScope Scope = Stack.Pop();
+
+	if (Stack.Num())
+	{
+		AddValue(Scope.Key, MakeShareable(new FJsonValueObject(Scope.Object)));
+	}
+	else
+	{
+		Root = Scope.Object;
+	}
+}
+
+void FFlareSaveObjectOutput::WriteArrayStart(const FString& Key)
+{
+	FScope Scope;
+	Scope.Key = Key;
+	Stack.Push(Scope);
+}
+
+void FFlareSaveObjectOutput::WriteArrayEnd()
+{
+	FScope Scope = Stack.Pop();
+	AddValue(Scope.Key, MakeShareable(new FJsonValueArray(Scope.Array)));
+}
+
+void FFlareSaveObjectOutput::WriteString(const FString& Key, const FString& Value)
+{
+	AddValue(Key, MakeShareable(new FJsonValueString(Value)));
+}
+
+void FFlareSaveObjectOutput::WriteNumber(const FString& Key, double Value)
+{
+	AddValue(Key, MakeShareable(new FJsonValueNumber(Value)));
+}
+
+void FFlareSaveObjectOutput::WriteBool(const FString& Key, bool Value)
+{
+	AddValue(Key, MakeShareable(new FJsonValueBoolean(Value)));
+}
+
+void FFlareSaveObjectOutput::AddValue(const FString& Key, TSharedPtr<FJsonValue> Value)
+{
+	FScope& Scope = Stack.Last();
+
+	if (Scope.Object.IsValid())
+	{
+		Scope.Object->SetField(Key, Value);
+	}
+	else
+	{
+		Scope.Array.Add(Value);
+	}
+}
+
+
+/*----------------------------------------------------
+	Stream output
+----------------------------------------------------*/
+
+FFlareSaveStreamOutput::FFlareSaveStreamOutput(FArchive* OutputFile, bool ForceUnicode)
+	: File(OutputFile)
+	, JsonWriter(TJsonWriterFactory<>::Create(this))
+	, Unicode(ForceUnicode)
+	, UnicodeRequired(false)
+{
+	ArIsSaving = true;
+	Buffer.Reserve(FLARE_SAVE_STREAM_BUFFER_SIZE + 4 * sizeof(UCS2CHAR));
+
+	if (Unicode)
+	{
+		UTF16CHAR BOM = UNICODE_BOM;
+		Buffer.Append((uint8*)&BOM, sizeof(UTF16CHAR));
+	}
+}
+
+void FFlareSaveStreamOutput::WriteObjectStart(const FString& Key)
+{
+	if (Key.IsEmpty())
+	{
+		JsonWriter->WriteObjectStart();
+	}
+	else
+	{
+		JsonWriter->WriteObjectStart(Key);
+	}
+}
+
+void FFlareSaveStreamOutput::WriteObjectEnd()
+{
+	JsonWriter->WriteObjectEnd();
+}
+
+void FFlareSaveStreamOutput::WriteArrayStart(const FString& Key)
+{
+	if (Key.IsEmpty())
+	{
+		JsonWriter->WriteArrayStart();
+	}
+	else
+	{
+		JsonWriter->WriteArrayStart(Key);
+	}
+}
+
+void FFlareSaveStreamOutput::WriteArrayEnd()
+{
+	JsonWriter->WriteArrayEnd();
+}
+
+void FFlareSaveStreamOutput::WriteString(const FString& Key, const FString& Value)
+{
+	if (Key.IsEmpty())
+	{
+		JsonWriter->WriteValue(Value);
+	}
+	else
+	{
+		JsonWriter->WriteValue(Key, Value);
+	}
+}
+
+void FFlareSaveStreamOutput::WriteNumber(const FString& Key, double Value)
+{
+	if (Key.IsEmpty())
+	{
+		JsonWriter->WriteValue(Value);
+	}
+	else
+	{
+		JsonWriter->WriteValue(Key, Value);
+	}
+}
+
+void FFlareSaveStreamOutput::WriteBool(const FString& Key, bool Value)
+{
+	if (Key.IsEmpty())
+	{
+		JsonWriter->WriteValue(Value);
+	}
+	else
+	{
+		JsonWriter->WriteValue(Key, Value);
+	}
+}
+
+bool FFlareSaveStreamOutput::Finish()
+{
+	JsonWriter->Close();
+	Flush();
+	return !UnicodeRequired;
+}
+
+void FFlareSaveStreamOutput::Serialize(void* Data, int64 Length)
+{
+	if (UnicodeRequired)
+	{
+		return;
+	}
+
+	const TCHAR* Chars = (const TCHAR*) Data;
+	int64 CharCount = Length / sizeof(TCHAR);
+
+	for (int64 Index = 0; Index < CharCount; Index++)
+	{
+		TCHAR Char = Chars[Index];
+
+		if (Unicode)
+		{
+			UCS2CHAR WideChar = (UCS2CHAR) Char;
+			Buffer.Append((uint8*)&WideChar, sizeof(UCS2CHAR));
+		}
+		else if (Char > 0x7f)
+		{
+			UnicodeRequired = true;
+			return;
+		}
+		else
+		{
+			Buffer.Add((uint8) Char);
+		}
+	}
+
+	if (Buffer.Num() >= FLARE_SAVE_STREAM_BUFFER_SIZE)
+	{
+		Flush();
+	}
+}
+
+void FFlareSaveStreamOutput::Flush()
+{
+	if (Buffer.Num() && !UnicodeRequired)
+	{
+		File->Serialize(Buffer.GetData(), Buffer.Num());
+	}
+	Buffer.Reset();
+}
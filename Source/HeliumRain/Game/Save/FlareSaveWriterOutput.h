@@ -0,0 +1,120 @@
+
+#pragma once
+
+#include "../../Flare.h"
+
+
+/** Receives the save tree written by UFlareSaveWriter as a sequence of JSON events. An empty key is used inside arrays. */
+class FFlareSaveWriterOutput
+{
+public:
+
+	virtual ~FFlareSaveWriterOutput()
+	{}
+
+	virtual void WriteObjectStart(const FString& Key) = 0;
+
+	virtual void WriteObjectEnd() = 0;
+
+	virtual void WriteArrayStart(const FString& Key) = 0;
+
+	virtual void WriteArrayEnd() = 0;
+
+	virtual void WriteString(const FString& Key, const FString& Value) = 0;
+
+	virtual void WriteNumber(const FString& Key, double Value) = 0;
+
+	virtual void WriteBool(const FString& Key, bool Value) = 0;
+
+};
+
+
+/** Builds a JSON object tree in memory */
+class FFlareSaveObjectOutput : public FFlareSaveWriterOutput
+{
+public:
+
+	virtual void WriteObjectStart(const FString& Key) override;
+
+	virtual void WriteObjectEnd() override;
+
+	virtual void WriteArrayStart(const FString& Key) override;
+
+	virtual void WriteArrayEnd() override;
+
+	virtual void WriteString(const FString& Key, const FString& Value) override;
+
+	virtual void WriteNumber(const FString& Key, double Value) override;
+
+	virtual void WriteBool(const FString& Key, bool Value) override;
+
+	/** Get the root object, once it has been closed */
+	TSharedRef<FJsonObject> GetObject() const
+	{
+		check(Root.IsValid());
+		return Root.ToSharedRef();
+	}
+
+protected:
+
+	struct FScope
+	{
+		FString                           Key;
+		TSharedPtr<FJsonObject>           Object;
+		TArray<TSharedPtr<FJsonValue>>    Array;
+	};
+
+	void AddValue(const FString& Key, TSharedPtr<FJsonValue> Value);
+
+	TArray<FScope>                        Stack;
+	TSharedPtr<FJsonObject>               Root;
+
+};
+
+
+/** Writes pretty-printed JSON to a file as it is generated, with the same output as FFileHelper::SaveStringToFile */
+class FFlareSaveStreamOutput : public FFlareSaveWriterOutput, protected FArchive
+{
+public:
+
+	/** Start writing. A file is ANSI unless a character needs UTF-16, in which case Unicode must be forced and the save restarted. */
+	FFlareSaveStreamOutput(FArchive* File, bool ForceUnicode);
+
+	virtual void WriteObjectStart(const FString& Key) override;
+
+	virtual void WriteObjectEnd() override;
+
+	virtual void WriteArrayStart(const FString& Key) override;
+
+	virtual void WriteArrayEnd() override;
+
+	virtual void WriteString(const FString& Key, const FString& Value) override;
+
+	virtual void WriteNumber(const FString& Key, double Value) override;
+
+	virtual void WriteBool(const FString& Key, bool Value) override;
+
+	/** Finish writing, false if the output must be restarted in Unicode */
+	bool Finish();
+
+	/** Check if a non-ANSI character was found */
+	bool NeedsUnicode() const
+	{
+		return UnicodeRequired;
+	}
+
+protected:
+
+	/** Encode the characters from the JSON writer */
+	virtual void Serialize(void* Data, int64 Length) override;
+
+	/** Write the buffered characters to the file */
+	virtual void Flush() override;
+
+	FArchive*                             File;
+	TSharedRef<TJsonWriter<>>             JsonWriter;
+	TArray<uint8>                         Buffer;
+	bool                                  Unicode;
+	bool                                  UnicodeRequired;
+
+};
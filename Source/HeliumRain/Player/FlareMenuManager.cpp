@@ -331,10 +331,7 @@ void AFlareMenuManager::Notify(FText Text, FText Info, FName Tag, EFlareNotifica
 {
 	if (MainOverlay.IsValid())
 	{
-		if (!UFlareGameTools::FastFastForward)
-		{
-			OrbitMenu->RequestStopFastForward();
-		}
+		OrbitMenu->RequestStopFastForward();
 		Notifier->Notify(Text, Info, Tag, Type, Pinned, TargetMenu, TargetInfo);
 	}
 }
@@ -108,6 +108,11 @@ float UFlareEngine::GetMaxThrust() const
 	}
 }
 
+float UFlareEngine::GetMaxThrustWithoutHeat() const
+{
+	return MaxThrust * UFlareSpacecraftComponent::GetUsableRatio();
+}
+
 float UFlareEngine::GetUsableRatio() const
 {
 	float BaseUsableRatio = UFlareSpacecraftComponent::GetUsableRatio();
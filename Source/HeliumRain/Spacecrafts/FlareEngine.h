@@ -30,6 +30,9 @@ public:
 	/** Get engine current max thrust ; Ccurrent max thrust can change with damages */
 	float GetMaxThrust() const;
 
+	/** Get engine max thrust with damages, ignoring overheating */
+	float GetMaxThrustWithoutHeat() const;
+
 	/** Get engine max thrust from specification ; Initial max thrust doesn't change with damages */
 	float GetInitialMaxThrust() const;
 
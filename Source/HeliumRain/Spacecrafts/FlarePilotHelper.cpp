@@ -22,10 +22,16 @@ bool PilotHelper::CheckFriendlyFire(UFlareSector* Sector, UFlareCompany* MyCompa
 {
 	SCOPE_CYCLE_COUNTER(STAT_PilotHelper_CheckFriendlyFire);
 
+	// A ship can only be hit before MaxDelay if it is closer than the ammo, shooter and ship speeds allow
+	FFlareSpatialIndex& SpatialIndex = Sector->GetSpatialIndex();
+	float MaxRange = (AmmoVelocity + FireBaseVelocity.Size() + 2 * SpatialIndex.GetMaxSpeed()) * MaxDelay;
+	TArray<const FFlareSpatialIndexEntry*> Candidates;
+	SpatialIndex.GetInRadius(FireBaseLocation, FMath::Max(MaxRange, 0.f), EFlareSpatialBody::Spacecraft, Candidates);
+
 	//FLOG("CheckFriendlyFire");
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Sector->GetSpacecrafts().Num(); SpacecraftIndex++)
+	for (const FFlareSpatialIndexEntry* Candidate : Candidates)
 	{
-		AFlareSpacecraft* SpacecraftCandidate = Sector->GetSpacecrafts()[SpacecraftIndex];
+		AFlareSpacecraft* SpacecraftCandidate = Candidate->Spacecraft;
 
 		if (SpacecraftCandidate)
 		{
@@ -81,49 +87,7 @@ bool PilotHelper::FindMostDangerousCollision(AFlareSpacecraft* Ship, AFlareSpace
 {
 	SCOPE_CYCLE_COUNTER(STAT_PilotHelper_AnticollisionCorrection);
 
-	typedef TPair<AActor*, FVector> TFlareCollisionCandidate;
-
 	UFlareSector* ActiveSector = Ship->GetGame()->GetActiveSector();
-	TArray<TFlareCollisionCandidate> Candidates;
-	TFlareCollisionCandidate Candidate;
-
-	// Select dangerous ships
-	for (auto SpacecraftCandidate : ActiveSector->GetSpacecrafts())
-	{
-		if (SpacecraftCandidate != Ship
-		 && SpacecraftCandidate != SpacecraftToIgnore
-		 && !Ship->GetDockingSystem()->IsGrantedShip(SpacecraftCandidate)
-		 && !Ship->GetDockingSystem()->IsDockedShip(SpacecraftCandidate))
-		{
-			Candidate.Key = SpacecraftCandidate;
-			Candidate.Value = SpacecraftCandidate->Airframe->GetPhysicsLinearVelocity();
-			Candidates.Add(Candidate);
-		}
-	}
-
-	// Select dangerous asteroids
-	for (auto AsteroidCandidate : ActiveSector->GetAsteroids())
-	{
-		Candidate.Key = AsteroidCandidate;
-		Candidate.Value = AsteroidCandidate->GetAsteroidComponent()->GetPhysicsLinearVelocity();
-		Candidates.Add(Candidate);
-	}
-
-	// Select dangerous colliders
-	TArray<AActor*> ColliderActorList;
-	UGameplayStatics::GetAllActorsOfClass(Ship->GetWorld(), AFlareCollider::StaticClass(), ColliderActorList);
-	for (auto ColliderCandidate : ColliderActorList)
-	{
-		Candidate.Key = Cast<AFlareCollider>(ColliderCandidate);
-		Candidate.Value = FVector::ZeroVector;
-		Candidates.Add(Candidate);
-	}
-
-	// No candidate found, return
-	if (Candidates.Num() == 0)
-	{
-		return false;
-	}
 
 	// Input data for danger processing
 	FBox ShipBox = Ship->GetComponentsBoundingBox();
@@ -132,17 +96,42 @@ bool PilotHelper::FindMostDangerousCollision(AFlareSpacecraft* Ship, AFlareSpace
 	float CurrentSize = FMath::Max(ShipBox.GetExtent().Size(), 1.0f);
 	float MaxRelevanceDistance = 200 * CurrentSize;
 
+	// Select ships, asteroids and colliders in range
+	TArray<const FFlareSpatialIndexEntry*> Candidates;
+	ActiveSector->GetSpatialIndex().GetInRadius(CurrentLocation, MaxRelevanceDistance, EFlareSpatialBody::All, Candidates);
+
 	// Output data
 	*MostDangerousCandidateActor = NULL;
 	*MostDangerousHitTime = 0;
 	*MostDangerousInterCollisionTravelTime = 0;
 
 	// Process all candidates
-	for (auto SelectedCandidate : Candidates)
+	for (const FFlareSpatialIndexEntry* Candidate : Candidates)
 	{
-		if ((SelectedCandidate.Key->GetActorLocation() - CurrentLocation).Size() < MaxRelevanceDistance)
+		AActor* CandidateActor = Candidate->Actor;
+		FVector CandidateVelocity = FVector::ZeroVector;
+
+		if (Candidate->BodyType == EFlareSpatialBody::Spacecraft)
 		{
-			CheckRelativeDangerosity(SelectedCandidate.Key, CurrentLocation, CurrentSize, SelectedCandidate.Value, CurrentVelocity,
+			AFlareSpacecraft* SpacecraftCandidate = Candidate->Spacecraft;
+			if (SpacecraftCandidate == Ship
+			 || SpacecraftCandidate == SpacecraftToIgnore
+			 || Ship->GetDockingSystem()->IsGrantedShip(SpacecraftCandidate)
+			 || Ship->GetDockingSystem()->IsDockedShip(SpacecraftCandidate))
+			{
+				continue;
+			}
+
+			CandidateVelocity = SpacecraftCandidate->Airframe->GetPhysicsLinearVelocity();
+		}
+		else if (Candidate->BodyType == EFlareSpatialBody::Asteroid)
+		{
+			CandidateVelocity = Cast<AFlareAsteroid>(CandidateActor)->GetAsteroidComponent()->GetPhysicsLinearVelocity();
+		}
+
+		if ((CandidateActor->GetActorLocation() - CurrentLocation).Size() < MaxRelevanceDistance)
+		{
+			CheckRelativeDangerosity(CandidateActor, CurrentLocation, CurrentSize, CandidateVelocity, CurrentVelocity,
 				MostDangerousCandidateActor, MostDangerousLocation, MostDangerousHitTime, MostDangerousInterCollisionTravelTime);
 		}
 	}
@@ -284,7 +273,15 @@ bool PilotHelper::IsSectorExitImminent(AFlareSpacecraft* Ship, float PreventionD
 	return ExitImminent;
 }
 
-AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct TargetPreferences Preferences)
+AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, const struct TargetPreferences& Preferences)
+{
+	return GetBestTarget(Ship, Preferences, [](const FFlareThreatEntry& Candidate)
+	{
+		return true;
+	});
+}
+
+AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, const struct TargetPreferences& Preferences, TFunctionRef<bool(const FFlareThreatEntry&)> Filter)
 {
 	SCOPE_CYCLE_COUNTER(STAT_PilotHelper_GetBestTarget);
 
@@ -298,33 +295,18 @@ AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct Targ
 
 	//FLOGV("GetBestTarget for %s", *Ship->GetImmatriculation().ToString());
 
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Ship->GetGame()->GetActiveSector()->GetSpacecrafts().Num(); SpacecraftIndex++)
+	// Alive, in limits, hostile ships only
+	const TArray<const FFlareThreatEntry*>& Threats = Ship->GetGame()->GetActiveSector()->GetThreatTable().GetHostileThreats(Ship->GetParent()->GetCompany());
+
+	for (const FFlareThreatEntry* Candidate : Threats)
 	{
-		AFlareSpacecraft* ShipCandidate = Ship->GetGame()->GetActiveSector()->GetSpacecrafts()[SpacecraftIndex];
+		AFlareSpacecraft* ShipCandidate = Candidate->Spacecraft;
 
 		if (Preferences.IgnoreList.Contains(ShipCandidate))
 		{
 			continue;
 		}
 
-		if (Ship->GetParent()->GetCompany()->GetWarState(ShipCandidate->GetCompany()) != EFlareHostility::Hostile)
-		{
-			// Ignore not hostile ships
-			continue;
-		}
-
-		if (!ShipCandidate->GetParent()->GetDamageSystem()->IsAlive())
-		{
-			// Ignore destroyed ships
-			continue;
-		}
-
-		if (ShipCandidate->GetActorLocation().Size() > ShipCandidate->GetGame()->GetActiveSector()->GetSectorLimits())
-		{
-			// Ignore out limit ships
-			continue;
-		}
-
 		float Score;
 		float StateScore;
 		float AttackTargetScore;
@@ -333,17 +315,17 @@ AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct Targ
 
 		StateScore = Preferences.TargetStateWeight;
 
-		if (ShipCandidate->GetParent()->GetSize() == EFlarePartSize::L)
+		if (Candidate->PartSize == EFlarePartSize::L)
 		{
 			StateScore *= Preferences.IsLarge;
 		}
 
-		if (ShipCandidate->GetParent()->GetSize() == EFlarePartSize::S)
+		if (Candidate->PartSize == EFlarePartSize::S)
 		{
 			StateScore *= Preferences.IsSmall;
 		}
 
-		if (ShipCandidate->GetParent()->IsStation())
+		if (Candidate->IsStation)
 		{
 			StateScore *= Preferences.IsStation;
 		}
@@ -352,7 +334,7 @@ AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct Targ
 			StateScore *= Preferences.IsNotStation;
 		}
 
-		if (ShipCandidate->GetParent()->IsMilitary())
+		if (Candidate->IsMilitary)
 		{
 			StateScore *= Preferences.IsMilitary;
 		}
@@ -361,7 +343,7 @@ AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct Targ
 			StateScore *= Preferences.IsNotMilitary;
 		}
 
-		if (IsShipDangerous(ShipCandidate))
+		if (Candidate->IsDangerous)
 		{
 			StateScore *= Preferences.IsDangerous;
 		}
@@ -370,7 +352,7 @@ AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct Targ
 			StateScore *= Preferences.IsNotDangerous;
 		}
 
-		if (ShipCandidate->GetParent()->GetDamageSystem()->IsStranded())
+		if (Candidate->IsStranded)
 		{
 			StateScore *= Preferences.IsStranded;
 		}
@@ -379,9 +361,9 @@ AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct Targ
 			StateScore *= Preferences.IsNotStranded;
 		}
 
-		if (ShipCandidate->GetParent()->GetDamageSystem()->IsUncontrollable() && ShipCandidate->GetParent()->GetDamageSystem()->IsDisarmed())
+		if (Candidate->IsUncontrollable && Candidate->IsDisarmed)
 		{
-			if (ShipCandidate->IsMilitary())
+			if (Candidate->IsMilitary)
 			{
 				StateScore *= Preferences.IsUncontrollableMilitary;
 			}
@@ -395,35 +377,30 @@ AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct Targ
 			StateScore *= Preferences.IsNotUncontrollable;
 		}
 
-		int BombCount = 0;
 		// Divise by 25 the stateScore per current incoming missile
-		for (AFlareBomb* Bomb : Ship->GetGame()->GetActiveSector()->GetBombs())
+		for (int32 BombIndex = 0; BombIndex < Candidate->IncomingBombCount; BombIndex++)
 		{
-			if (Bomb->GetTargetSpacecraft() == ShipCandidate && Bomb->IsActive())
-			{
-				BombCount++;
-				StateScore /= 25;
-			}
+			StateScore /= 25;
 		}
 
-		if (IsShipDangerous(ShipCandidate))
+		if (Candidate->IsDangerous)
 		{
-			if(BombCount > 1)
+			if (Candidate->IncomingBombCount > 1)
 			{
 				continue;
 			}
 		}
 		else
 		{
-			if(BombCount > 0)
+			if (Candidate->IncomingBombCount > 0)
 			{
 				continue;
 			}
 		}
 
 
-		if(ShipCandidate->GetParent()->IsHarpooned()) {
-			if(ShipCandidate->GetParent()->GetDamageSystem()->IsUncontrollable())
+		if(Candidate->IsHarpooned) {
+			if(Candidate->IsUncontrollable)
 			{
 				// Never target harponned uncontrollable ships
 				continue;
@@ -436,7 +413,7 @@ AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct Targ
 			StateScore *=  Preferences.LastTargetWeight;
 		}
 
-		float Distance = (Preferences.BaseLocation - ShipCandidate->GetActorLocation()).Size();
+		float Distance = (Preferences.BaseLocation - Candidate->Location).Size();
 		if (Distance >= Preferences.MaxDistance)
 		{
 			DistanceScore = 0.f;
@@ -446,7 +423,7 @@ AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct Targ
 			DistanceScore = Preferences.DistanceWeight * (1.f - (Distance / Preferences.MaxDistance));
 		}
 
-		if (Preferences.AttackTarget && IsShipDangerous(ShipCandidate) && ShipCandidate->GetPilot()->GetTargetShip() == Preferences.AttackTarget)
+		if (Preferences.AttackTarget && Candidate->IsDangerous && Candidate->PilotTarget == Preferences.AttackTarget)
 		{
 			AttackTargetScore = Preferences.AttackTargetWeight;
 		}
@@ -455,7 +432,7 @@ AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct Targ
 			AttackTargetScore = 0.0f;
 		}
 
-		FVector Direction = (ShipCandidate->GetActorLocation() - Preferences.BaseLocation).GetUnsafeNormal();
+		FVector Direction = (Candidate->Location - Preferences.BaseLocation).GetUnsafeNormal();
 
 
 		float Alignement = FVector::DotProduct(Preferences.PreferredDirection, Direction);
@@ -480,7 +457,7 @@ AFlareSpacecraft* PilotHelper::GetBestTarget(AFlareSpacecraft* Ship, struct Targ
 
 		if (Score > 0)
 		{
-			if (BestTarget == NULL || Score > BestScore)
+			if ((BestTarget == NULL || Score > BestScore) && Filter(*Candidate))
 			{
 				BestTarget = ShipCandidate;
 				BestScore = Score;
@@ -535,10 +512,10 @@ UFlareSpacecraftComponent* PilotHelper::GetBestTargetComponent(AFlareSpacecraft*
 
 	TArray<UFlareSpacecraftComponent*> ComponentSelection;
 
-	TArray<UActorComponent*> Components = TargetSpacecraft->GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
+	const TArray<UFlareSpacecraftComponent*>& Components = TargetSpacecraft->GetSpacecraftComponents();
 	for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
 	{
-		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(Components[ComponentIndex]);
+		UFlareSpacecraftComponent* Component = Components[ComponentIndex];
 
 		if (Component->GetDescription() && !Component->IsBroken() )
 		{
@@ -6,6 +6,7 @@ class UFlareCompany;
 class UFlareSector;
 class UFlareSpacecraftComponent;
 class AFlareSpacecraft;
+struct FFlareThreatEntry;
 
 struct PilotHelper
 {
@@ -53,7 +54,10 @@ struct PilotHelper
 	static bool IsAnticollisionImminent(AFlareSpacecraft* Ship, float PreventionDuration);
 	static bool IsSectorExitImminent(AFlareSpacecraft* Ship, float PreventionDuration);
 
-	static AFlareSpacecraft* GetBestTarget(AFlareSpacecraft* Ship, struct TargetPreferences Preferences);
+	static AFlareSpacecraft* GetBestTarget(AFlareSpacecraft* Ship, const struct TargetPreferences& Preferences);
+
+	/** Get the best target accepted by Filter, which is only checked for candidates that would be the best so far */
+	static AFlareSpacecraft* GetBestTarget(AFlareSpacecraft* Ship, const struct TargetPreferences& Preferences, TFunctionRef<bool(const FFlareThreatEntry&)> Filter);
 
 	static UFlareSpacecraftComponent* GetBestTargetComponent(AFlareSpacecraft* TargetSpacecraft);
 
@@ -0,0 +1,684 @@
+
+#include "../Flare.h"
+#include "FlareSpacecraft.h"
+#include "FlareShellManager.h"
+#include "../Game/FlareGame.h"
+#include "../Player/FlarePlayerController.h"
+
+DECLARE_CYCLE_STAT(TEXT("FlareShellManager Tick"), STAT_FlareShellManager_Tick, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareShellManager Move"), STAT_FlareShellManager_Move, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareShellManager Sweep"), STAT_FlareShellManager_Sweep, STATGROUP_Flare);
+
+
+/*----------------------------------------------------
+	Constructor
+----------------------------------------------------*/
+
+AFlareShellManager::AFlareShellManager(const class FObjectInitializer& PCIP) : Super(PCIP)
+{
+	// Root
+	ManagerComp = PCIP.CreateDefaultSubobject<USceneComponent>(this, TEXT("Root"));
+	RootComponent = ManagerComp;
+
+	// Settings
+	Sector = NULL;
+	PC = NULL;
+	TraceSpacecraft = NULL;
+	NextShellId = 0;
+	Paused = false;
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
+}
+
+
+/*----------------------------------------------------
+	Gameplay
+----------------------------------------------------*/
+
+void AFlareShellManager::Initialize(UFlareSector* ParentSector)
+{
+	Sector = ParentSector;
+	PC = Sector->GetGame()->GetPC();
+}
+
+void AFlareShellManager::FireShell(UFlareWeapon* Weapon, const FFlareSpacecraftComponentDescription* Description, FVector Location,
+	FVector ShootDirection, FVector ParentVelocity, bool Tracer, float SecureTime, float ActiveTime)
+{
+	// Can't exist without description, can't return
+	FCHECK(Description);
+
+	float AmmoVelocity = Description->WeaponCharacteristics.GunCharacteristics.AmmoVelocity;
+	float KineticEnergy = Description->WeaponCharacteristics.GunCharacteristics.KineticEnergy;
+
+	FVector ShellVelocity = ParentVelocity + ShootDirection * AmmoVelocity * 100;
+	float LifeSpan = Description->WeaponCharacteristics.GunCharacteristics.AmmoRange * 100 / ShellVelocity.Size(); // 10km
+
+	Weapons.Add(Weapon);
+	Descriptions.Add(Description);
+	Locations.Add(Location);
+	Velocities.Add(ShellVelocity);
+	LifeSpans.Add(LifeSpan);
+	InitialLifeSpans.Add(LifeSpan);
+	Masses.Add(2 * KineticEnergy * 1000 / FMath::Square(AmmoVelocity)); // ShellPower is in Kilo-Joule, reverse kinetic energy equation
+	SecureTimes.Add(SecureTime);
+	ActiveTimes.Add(ActiveTime);
+	MinEffectiveDistances.Add(0.f);
+	Armed.Add(false);
+	Alive.Add(true);
+	ShellIds.Add(NextShellId++);
+
+	// Spawn the flight effects
+	UParticleSystemComponent* Effects = NULL;
+	if (Tracer)
+	{
+		Effects = GetTracer(Description->WeaponCharacteristics.GunCharacteristics.TracerEffect, Location, ShellVelocity.Rotation());
+	}
+	FlightEffects.Add(Effects);
+}
+
+void AFlareShellManager::Tick(float DeltaSeconds)
+{
+	SCOPE_CYCLE_COUNTER(STAT_FlareShellManager_Tick);
+	Super::Tick(DeltaSeconds);
+
+	int32 ShellCount = Locations.Num();
+	if (Paused || ShellCount == 0)
+	{
+		return;
+	}
+
+	// Move all shells
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareShellManager_Move);
+
+		NextLocations.SetNumUninitialized(ShellCount, false);
+		for (int32 ShellIndex = 0; ShellIndex < ShellCount; ShellIndex++)
+		{
+			NextLocations[ShellIndex] = Locations[ShellIndex] + Velocities[ShellIndex] * DeltaSeconds;
+			LifeSpans[ShellIndex] -= DeltaSeconds;
+		}
+
+		// Update tracers : 1 at 100m or less
+		AFlareSpacecraft* ShipPawn = PC->GetShipPawn();
+		FVector ViewLocation = ShipPawn ? ShipPawn->GetActorLocation() : FVector::ZeroVector;
+		float BaseDistance = 10000.f;
+		float MinScale = 0.1f;
+
+		for (int32 ShellIndex = 0; ShellIndex < ShellCount; ShellIndex++)
+		{
+			UParticleSystemComponent* Effects = FlightEffects[ShellIndex];
+			if (!Effects)
+			{
+				continue;
+			}
+
+			float Scale = 1;
+			if (ShipPawn)
+			{
+				float LifeRatio = LifeSpans[ShellIndex] / InitialLifeSpans[ShellIndex];
+
+				float LifeRatioScale = 1.f;
+
+				if (LifeRatio < 0.1f)
+				{
+					LifeRatioScale = LifeRatio * 10.f;
+				}
+
+				float Distance = (NextLocations[ShellIndex] - ViewLocation).Size();
+				if (Distance > BaseDistance)
+				{
+					Scale = (Distance / BaseDistance) * ((1.f - MinScale) * BaseDistance / Distance + MinScale) * LifeRatioScale;
+				}
+			}
+
+			Effects->SetWorldLocationAndRotation(NextLocations[ShellIndex], Velocities[ShellIndex].Rotation());
+			Effects->SetWorldScale3D(FVector(0.6 + Scale * 0.4, Scale, Scale));
+		}
+	}
+
+	// Sweep all shells, in the same order as movement
+	{
+		SCOPE_CYCLE_COUNTER(STAT_FlareShellManager_Sweep);
+
+		TraceSpacecraft = NULL;
+		for (int32 ShellIndex = 0; ShellIndex < ShellCount; ShellIndex++)
+		{
+			FVector ActorLocation = Locations[ShellIndex];
+			FVector NextActorLocation = NextLocations[ShellIndex];
+			Locations[ShellIndex] = NextActorLocation;
+
+			FHitResult HitResult(ForceInit);
+			if (Trace(ShellIndex, ActorLocation, NextActorLocation, HitResult))
+			{
+				OnImpact(ShellIndex, HitResult, Velocities[ShellIndex]);
+			}
+
+			if (Descriptions[ShellIndex]->WeaponCharacteristics.FuzeType == EFlareShellFuzeType::Proximity)
+			{
+				if (SecureTimes[ShellIndex] > 0)
+				{
+					SecureTimes[ShellIndex] -= DeltaSeconds;
+				}
+				else if (ActiveTimes[ShellIndex] > 0)
+				{
+					CheckFuze(ShellIndex, ActorLocation, NextActorLocation);
+					ActiveTimes[ShellIndex] -= DeltaSeconds;
+				}
+			}
+		}
+	}
+
+	// Remove destroyed and expired shells
+	for (int32 ShellIndex = ShellCount - 1; ShellIndex >= 0; ShellIndex--)
+	{
+		if (!Alive[ShellIndex] || LifeSpans[ShellIndex] <= 0)
+		{
+			RemoveShell(ShellIndex);
+		}
+	}
+}
+
+void AFlareShellManager::CheckFuze(int32 ShellIndex, FVector ActorLocation, FVector NextActorLocation)
+{
+	UFlareWeapon* ParentWeapon = Weapons[ShellIndex];
+	const FFlareSpacecraftComponentDescription* ShellDescription = Descriptions[ShellIndex];
+	FVector Center = (NextActorLocation + ActorLocation) / 2;
+	float NearThresoldSquared = FMath::Square(100000); // 1km
+
+	TArray<const FFlareSpatialIndexEntry*> Candidates;
+	Sector->GetSpatialIndex().GetInRadius(Center, 100000, EFlareSpatialBody::Spacecraft, Candidates);
+
+	for (const FFlareSpatialIndexEntry* Candidate : Candidates)
+	{
+		AFlareSpacecraft* ShipCandidate = Candidate->Spacecraft;
+
+		if (ShipCandidate == ParentWeapon->GetSpacecraft())
+		{
+			// Ignore parent spacecraft
+			continue;
+		}
+
+		// First check if near to filter distant ship
+		if ((Center - ShipCandidate->GetActorLocation()).SizeSquared() > NearThresoldSquared)
+		{
+			continue;
+		}
+
+		FVector ShellDirection = Velocities[ShellIndex].GetUnsafeNormal();
+		FVector CandidateOffset = ShipCandidate->GetActorLocation() - ActorLocation;
+		FVector NextCandidateOffset = ShipCandidate->GetActorLocation() - NextActorLocation;
+
+		// Min distance
+		float MinDistance = FVector::CrossProduct(CandidateOffset, ShellDirection).Size() / ShellDirection.Size();
+
+		// Check if the min distance is not in the past
+		if (FVector::DotProduct(CandidateOffset, ShellDirection) < 0)
+		{
+			// The target is behind the shell
+			MinDistance = CandidateOffset.Size();
+		}
+
+		bool MinInFuture = false;
+		// Check if the min distance is not in the future
+		if (FVector::DotProduct(NextCandidateOffset, ShellDirection) > 0)
+		{
+			// The target is before the shell
+			MinDistance = NextCandidateOffset.Size();
+			MinInFuture = true;
+		}
+
+		float DistanceToMinDistancePoint;
+		if (CandidateOffset.Size() == MinDistance)
+		{
+			DistanceToMinDistancePoint = 0;
+		}
+		else if (NextCandidateOffset.Size() == MinDistance)
+		{
+			DistanceToMinDistancePoint = (NextActorLocation - ActorLocation).Size();
+		}
+		else
+		{
+			DistanceToMinDistancePoint = FMath::Sqrt(CandidateOffset.SizeSquared() - FMath::Square(MinDistance));
+		}
+
+		// Check if need to detonnate
+		float EffectiveDistance = MinDistance - ShipCandidate->GetMeshScale();
+
+		if (EffectiveDistance < ShellDescription->WeaponCharacteristics.FuzeMinDistanceThresold *100)
+		{
+			// Detonate because of too near. Find the detonate point.
+			float MinThresoldDistance = ShellDescription->WeaponCharacteristics.FuzeMinDistanceThresold *100 + ShipCandidate->GetMeshScale();
+			float DistanceToMinThresoldDistancePoint = FMath::Sqrt(FMath::Square(MinThresoldDistance) - FMath::Square(MinDistance));
+			float DistanceToDetonatePoint = DistanceToMinDistancePoint - DistanceToMinThresoldDistancePoint;
+			FVector DetonatePoint = ActorLocation + ShellDirection * DistanceToDetonatePoint;
+
+			DetonateAt(ShellIndex, DetonatePoint);
+		}
+		else if (Armed[ShellIndex] && EffectiveDistance > MinEffectiveDistances[ShellIndex])
+		{
+			// We are armed and the distance as increase, detonate at nearest point
+			FVector DetonatePoint = ActorLocation + ShellDirection * DistanceToMinDistancePoint;
+			DetonateAt(ShellIndex, DetonatePoint);
+		}
+		else if (EffectiveDistance < ShellDescription->WeaponCharacteristics.FuzeMaxDistanceThresold *100)
+		{
+			if (MinInFuture)
+			{
+				// In activation zone but we will be near in future, arm the fuze
+				Armed[ShellIndex] = true;
+				MinEffectiveDistances[ShellIndex] = EffectiveDistance;
+			}
+			else
+			{
+				// In activation zone and the min distance is reach in this step, detonate
+				FVector DetonatePoint = ActorLocation + ShellDirection * DistanceToMinDistancePoint;
+				DetonateAt(ShellIndex, DetonatePoint);
+			}
+		}
+	}
+}
+
+void AFlareShellManager::OnImpact(int32 ShellIndex, const FHitResult& HitResult, const FVector& HitVelocity)
+{
+	UFlareWeapon* ParentWeapon = Weapons[ShellIndex];
+	const FFlareSpacecraftComponentDescription* ShellDescription = Descriptions[ShellIndex];
+	float ShellMass = Masses[ShellIndex];
+	bool DestroyProjectile = true;
+
+	if (HitResult.Actor.IsValid() && HitResult.Component.IsValid())
+	{
+		// Compute projectile energy.
+		FVector ProjectileVelocity = HitVelocity / 100;
+		FVector TargetVelocity = HitResult.Component->GetPhysicsLinearVelocity() / 100;
+		FVector ImpactVelocity = ProjectileVelocity - TargetVelocity;
+		FVector ImpactVelocityAxis = ImpactVelocity.GetUnsafeNormal();
+
+		// Compute parameters
+		float ShellEnergy = 0.5f * ShellMass * ImpactVelocity.SizeSquared() / 1000; // Damage in KJ
+
+		float AbsorbedEnergy = ApplyDamage(ShellIndex, HitResult.Actor.Get(), HitResult.GetComponent(), HitResult.Location, ImpactVelocityAxis, HitResult.ImpactNormal, ShellEnergy, ShellDescription->WeaponCharacteristics.AmmoDamageRadius, EFlareDamage::DAM_ArmorPiercing);
+		bool Richochet = (AbsorbedEnergy < ShellEnergy);
+
+		if (Richochet)
+		{
+			DestroyProjectile = false;
+			float RemainingEnergy = ShellEnergy - AbsorbedEnergy;
+			float RemainingVelocity = FMath::Sqrt(2 * RemainingEnergy * 1000 / ShellMass);
+			FVector BounceDirection = Velocities[ShellIndex].GetUnsafeNormal().MirrorByVector(HitResult.ImpactNormal);
+			Velocities[ShellIndex] = BounceDirection * RemainingVelocity * 100;
+			Locations[ShellIndex] = HitResult.Location;
+		}
+		else
+		{
+			AFlareSpacecraft* Spacecraft = Cast<AFlareSpacecraft>(HitResult.Actor.Get());
+			if (ShellDescription->WeaponCharacteristics.DamageType == EFlareShellDamageType::HEAT)
+			{
+				AFlareAsteroid* Asteroid = Cast<AFlareAsteroid>(HitResult.Actor.Get());
+				if (Spacecraft)
+				{
+					Spacecraft->GetDamageSystem()->ApplyDamage(ShellDescription->WeaponCharacteristics.ExplosionPower,
+						ShellDescription->WeaponCharacteristics.AmmoDamageRadius, HitResult.Location, EFlareDamage::DAM_HEAT, ParentWeapon->GetSpacecraft()->GetParent(), GetShellName(ShellIndex));
+
+					// Physics impulse
+					Spacecraft->Airframe->AddImpulseAtLocation(Velocities[ShellIndex].GetUnsafeNormal(), HitResult.Location);
+				}
+				else if (Asteroid)
+				{
+					Asteroid->GetAsteroidComponent()->AddImpulseAtLocation(Velocities[ShellIndex].GetUnsafeNormal(), HitResult.Location);
+				}
+			}
+
+			// Spawn penetration effect
+			if (!(Spacecraft && Spacecraft->IsInImmersiveMode()))
+			{
+				UParticleSystemComponent* PSC = UGameplayStatics::SpawnEmitterAttached(
+					ShellDescription->WeaponCharacteristics.ExplosionEffect,
+					HitResult.GetComponent(),
+					NAME_None,
+					HitResult.Location,
+					HitResult.ImpactNormal.Rotation(),
+					EAttachLocation::KeepWorldPosition,
+					true);
+				if (PSC)
+				{
+					PSC->SetWorldScale3D(ShellDescription->WeaponCharacteristics.ExplosionEffectScale * FVector(1, 1, 1));
+				}
+			}
+
+			// Spawn hull damage effect
+			UFlareSpacecraftComponent* HullComp = Cast<UFlareSpacecraftComponent>(HitResult.GetComponent());
+			if (HullComp)
+			{
+				HullComp->StartDamagedEffect(HitResult.Location, HitResult.ImpactNormal.Rotation(), ParentWeapon->GetDescription()->Size);
+			}
+		}
+	}
+
+	if (DestroyProjectile)
+	{
+		DestroyShell(ShellIndex);
+	}
+}
+
+void AFlareShellManager::DetonateAt(int32 ShellIndex, FVector DetonatePoint)
+{
+	const FFlareSpacecraftComponentDescription* ShellDescription = Descriptions[ShellIndex];
+
+	UGameplayStatics::SpawnEmitterAtLocation(this,
+		ShellDescription->WeaponCharacteristics.ExplosionEffect,
+		DetonatePoint);
+
+	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Sector->GetSpacecrafts().Num(); SpacecraftIndex++)
+	{
+		AFlareSpacecraft* ShipCandidate = Sector->GetSpacecrafts()[SpacecraftIndex];
+
+		// First check if in radius area
+		FVector CandidateOffset = ShipCandidate->GetActorLocation() - DetonatePoint;
+		float CandidateDistance = CandidateOffset.Size();
+		float CandidateSize = ShipCandidate->GetMeshScale();
+
+		if (CandidateDistance > ShellDescription->WeaponCharacteristics.AmmoExplosionRadius * 100 + CandidateSize)
+		{
+			continue;
+		}
+
+		// Find exposed surface
+		// Apparent radius
+		float ApparentRadius = FMath::Sqrt(FMath::Square(CandidateDistance) + FMath::Square(CandidateSize));
+
+		float Angle = FMath::Acos(CandidateDistance/ApparentRadius);
+
+		float ExposedSurface = 2 * PI * ApparentRadius * (ApparentRadius - CandidateDistance);
+		float TotalSurface = 4 * PI * FMath::Square(ApparentRadius);
+
+		float ExposedSurfaceRatio = ExposedSurface / TotalSurface;
+
+		int FragmentCount =  FMath::RandRange(0,2) + ShellDescription->WeaponCharacteristics.AmmoFragmentCount * ExposedSurfaceRatio;
+
+		TArray<UActorComponent*> Components = ShipCandidate->GetComponentsByClass(UStaticMeshComponent::StaticClass());
+
+		for (int i = 0; i < FragmentCount; i ++)
+		{
+			FVector HitDirection = FMath::VRandCone(CandidateOffset, Angle);
+
+			bool HasHit = false;
+			FHitResult BestHitResult;
+			float BestHitDistance = 0;
+
+			for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
+			{
+				UStaticMeshComponent* Component = Cast<UStaticMeshComponent>(Components[ComponentIndex]);
+				if (Component)
+				{
+					FHitResult HitResult(ForceInit);
+					FCollisionQueryParams FragmentTraceParams(FName(TEXT("Fragment Trace")), true, this);
+					FragmentTraceParams.bTraceComplex = true;
+					FragmentTraceParams.bReturnPhysicalMaterial = false;
+					Component->LineTraceComponent(HitResult, DetonatePoint, DetonatePoint + HitDirection * 2* CandidateDistance, FragmentTraceParams);
+
+					if (HitResult.Actor.IsValid())
+					{
+						float HitDistance = (HitResult.Location - DetonatePoint).Size();
+						if (!HasHit || HitDistance < BestHitDistance)
+						{
+							BestHitDistance = HitDistance;
+							BestHitResult = HitResult;
+						}
+
+						HasHit = true;
+					}
+				}
+			}
+
+			if (HasHit)
+			{
+				AFlareSpacecraft* Spacecraft = Cast<AFlareSpacecraft>(BestHitResult.Actor.Get());
+				if (Spacecraft)
+				{
+					float FragmentPowerEffet = FMath::FRandRange(0.f, 2.f);
+					float FragmentRangeEffet = FMath::FRandRange(0.5f, 1.5f);
+					ApplyDamage(ShellIndex, Spacecraft, BestHitResult.GetComponent()
+								, BestHitResult.Location
+								, HitDirection
+								, BestHitResult.ImpactNormal
+								, FragmentPowerEffet * ShellDescription->WeaponCharacteristics.ExplosionPower
+								, FragmentRangeEffet  * ShellDescription->WeaponCharacteristics.AmmoDamageRadius
+								, EFlareDamage::DAM_HighExplosive);
+
+					// Play sound
+					AFlareSpacecraftPawn* SpacecraftPawn = Cast<AFlareSpacecraftPawn>(Spacecraft);
+					if (SpacecraftPawn->IsPlayerShip())
+					{
+						SpacecraftPawn->GetPC()->PlayLocalizedSound(ShellDescription->WeaponCharacteristics.ImpactSound, BestHitResult.Location);
+					}
+				}
+			}
+		}
+	}
+
+	DestroyShell(ShellIndex);
+}
+
+float AFlareShellManager::ApplyDamage(int32 ShellIndex, AActor *ActorToDamage, UPrimitiveComponent* HitComponent, FVector ImpactLocation, FVector ImpactAxis, FVector ImpactNormal, float ImpactPower, float ImpactRadius, EFlareDamage::Type DamageType)
+{
+	UFlareWeapon* ParentWeapon = Weapons[ShellIndex];
+	const FFlareSpacecraftComponentDescription* ShellDescription = Descriptions[ShellIndex];
+	float Incidence = FVector::DotProduct(ImpactNormal, -ImpactAxis);
+	float Armor = 1; // Full armored
+
+	if (Incidence < 0)
+	{
+		// Parasite hit after rebound, ignore
+		return 0;
+	}
+
+	// Hit a component
+	UFlareSpacecraftComponent* ShipComponent = Cast<UFlareSpacecraftComponent>(HitComponent);
+	if (ShipComponent)
+	{
+		 Armor = ShipComponent->GetArmorAtLocation(ImpactLocation);
+	}
+
+	// Check armor peneration
+	int32 PenetrateArmor = false;
+	float PenerationIncidenceLimit = 0.7f;
+	if (Incidence > PenerationIncidenceLimit)
+	{
+		PenetrateArmor = true; // No ricochet
+	}
+	else if (Armor == 0)
+	{
+		PenetrateArmor = true; // Armor destruction
+	}
+
+	// Hit a component : damage in KJ
+	float AbsorbedEnergy = (PenetrateArmor ? ImpactPower : FMath::Square(Incidence) * ImpactPower);
+	AFlareSpacecraft* Spacecraft = Cast<AFlareSpacecraft>(ActorToDamage);
+	AFlareAsteroid* Asteroid = Cast<AFlareAsteroid>(ActorToDamage);
+	if (Spacecraft)
+	{
+		Spacecraft->GetDamageSystem()->SetLastDamageCauser(Cast<AFlareSpacecraft>(ParentWeapon->GetOwner()));
+		Spacecraft->GetDamageSystem()->ApplyDamage(AbsorbedEnergy, ImpactRadius, ImpactLocation, DamageType, ParentWeapon->GetSpacecraft()->GetParent(), GetShellName(ShellIndex));
+
+		// Physics impulse
+		Spacecraft->Airframe->AddImpulseAtLocation( 5000	 * ImpactRadius * AbsorbedEnergy * (PenetrateArmor ? ImpactAxis : -ImpactNormal), ImpactLocation);
+
+		// Play sound
+		AFlareSpacecraftPawn* SpacecraftPawn = Cast<AFlareSpacecraftPawn>(Spacecraft);
+		if (SpacecraftPawn->IsPlayerShip())
+		{
+			SpacecraftPawn->GetPC()->PlayLocalizedSound(PenetrateArmor ? ShellDescription->WeaponCharacteristics.DamageSound : ShellDescription->WeaponCharacteristics.ImpactSound, ImpactLocation);
+		}
+	}
+	else if (Asteroid)
+	{
+		// Physics impulse
+		Asteroid->GetAsteroidComponent()->AddImpulseAtLocation( 5000	 * ImpactRadius * AbsorbedEnergy * (PenetrateArmor ? ImpactAxis : -ImpactNormal), ImpactLocation);
+	}
+
+	// Spawn impact decal
+	if (HitComponent)
+	{
+		float DecalSize = FMath::FRandRange(20, 30);
+		UDecalComponent* Decal = UGameplayStatics::SpawnDecalAttached(
+			ShellDescription->WeaponCharacteristics.GunCharacteristics.ExplosionMaterial,
+			DecalSize * FVector(1, 1, 1),
+			HitComponent,
+			NAME_None,
+			ImpactLocation,
+			ImpactNormal.Rotation(),
+			EAttachLocation::KeepWorldPosition,
+			120);
+
+		// Instanciate and configure the decal material
+		UMaterialInterface* DecalMaterial = Decal->GetMaterial(0);
+		UMaterialInstanceDynamic* DecalMaterialInst = UMaterialInstanceDynamic::Create(DecalMaterial, GetWorld());
+		if (DecalMaterialInst)
+		{
+			DecalMaterialInst->SetScalarParameterValue("RandomParameter", FMath::FRandRange(1, 0));
+			DecalMaterialInst->SetScalarParameterValue("RandomParameter2", FMath::FRandRange(1, 0));
+			DecalMaterialInst->SetScalarParameterValue("IsShipHull", HitComponent->IsA(UFlareSpacecraftComponent::StaticClass()));
+			Decal->SetMaterial(0, DecalMaterialInst);
+		}
+	}
+
+	// Apply FX
+	if (HitComponent && !(Spacecraft && Spacecraft->IsInImmersiveMode()))
+	{
+		UParticleSystemComponent* PSC = UGameplayStatics::SpawnEmitterAttached(
+			ShellDescription->WeaponCharacteristics.ImpactEffect,
+			HitComponent,
+			NAME_None,
+			ImpactLocation,
+			ImpactNormal.Rotation(),
+			EAttachLocation::KeepWorldPosition,
+			true);
+		if (PSC)
+		{
+			PSC->SetWorldScale3D(ShellDescription->WeaponCharacteristics.ImpactEffectScale * FVector(1, 1, 1));
+		}
+	}
+
+	return AbsorbedEnergy;
+}
+
+bool AFlareShellManager::Trace(int32 ShellIndex, const FVector& Start, const FVector& End, FHitResult& HitOut)
+{
+	// Ignore the manager and the parent spacecraft, reusing the parameters between shells of the same spacecraft
+	AFlareSpacecraft* ParentSpacecraft = Weapons[ShellIndex]->GetSpacecraft();
+	if (ParentSpacecraft != TraceSpacecraft || TraceSpacecraft == NULL)
+	{
+		TraceParams = FCollisionQueryParams(FName(TEXT("Shell Trace")), true, this);
+		TraceParams.bTraceComplex = true;
+		TraceParams.bReturnPhysicalMaterial = false;
+		TraceParams.AddIgnoredActor(ParentSpacecraft);
+		TraceSpacecraft = ParentSpacecraft;
+	}
+
+	// Re-initialize hit info
+	HitOut = FHitResult(ForceInit);
+
+	ECollisionChannel CollisionChannel = (ECollisionChannel) (ECC_WorldStatic | ECC_WorldDynamic | ECC_Pawn);
+
+	// Trace!
+	GetWorld()->LineTraceSingleByChannel(
+		HitOut,		// result
+		Start,	// start
+		End , // end
+		CollisionChannel, // collision channel
+		TraceParams
+	);
+
+	// Hit any Actor?
+	return (HitOut.GetActor() != NULL) ;
+}
+
+void AFlareShellManager::DestroyShell(int32 ShellIndex)
+{
+	Alive[ShellIndex] = false;
+}
+
+void AFlareShellManager::RemoveShell(int32 ShellIndex)
+{
+	if (FlightEffects[ShellIndex])
+	{
+		ReleaseTracer(FlightEffects[ShellIndex]);
+	}
+
+	Weapons.RemoveAtSwap(ShellIndex, 1, false);
+	Descriptions.RemoveAtSwap(ShellIndex, 1, false);
+	Locations.RemoveAtSwap(ShellIndex, 1, false);
+	Velocities.RemoveAtSwap(ShellIndex, 1, false);
+	LifeSpans.RemoveAtSwap(ShellIndex, 1, false);
+	InitialLifeSpans.RemoveAtSwap(ShellIndex, 1, false);
+	Masses.RemoveAtSwap(ShellIndex, 1, false);
+	SecureTimes.RemoveAtSwap(ShellIndex, 1, false);
+	ActiveTimes.RemoveAtSwap(ShellIndex, 1, false);
+	MinEffectiveDistances.RemoveAtSwap(ShellIndex, 1, false);
+	Armed.RemoveAtSwap(ShellIndex, 1, false);
+	Alive.RemoveAtSwap(ShellIndex, 1, false);
+	ShellIds.RemoveAtSwap(ShellIndex, 1, false);
+	FlightEffects.RemoveAtSwap(ShellIndex, 1, false);
+}
+
+FString AFlareShellManager::GetShellName(int32 ShellIndex) const
+{
+	return FString::Printf(TEXT("FlareShell_%u"), ShellIds[ShellIndex]);
+}
+
+void AFlareShellManager::SetPause(bool Pause)
+{
+	Paused = Pause;
+	SetActorHiddenInGame(Pause);
+	CustomTimeDilation = (Pause ? 0.f : 1.0);
+}
+
+
+/*----------------------------------------------------
+	Tracer pool
+----------------------------------------------------*/
+
+UParticleSystemComponent* AFlareShellManager::GetTracer(UParticleSystem* Template, FVector Location, FRotator Rotation)
+{
+	if (!Template)
+	{
+		return NULL;
+	}
+
+	// Reuse a tracer of the same kind
+	for (int32 TracerIndex = 0; TracerIndex < FreeTracers.Num(); TracerIndex++)
+	{
+		UParticleSystemComponent* Tracer = FreeTracers[TracerIndex];
+		if (Tracer->Template == Template)
+		{
+			FreeTracers.RemoveAtSwap(TracerIndex);
+			Tracer->SetWorldLocationAndRotation(Location, Rotation);
+			Tracer->SetWorldScale3D(FVector(1, 1, 1));
+			Tracer->Activate(true);
+			return Tracer;
+		}
+	}
+
+	// Create a new one
+	UParticleSystemComponent* Tracer = UGameplayStatics::SpawnEmitterAttached(
+		Template,
+		RootComponent,
+		NAME_None,
+		Location,
+		Rotation,
+		EAttachLocation::KeepWorldPosition,
+		false);
+
+	if (Tracer)
+	{
+		AllTracers.Add(Tracer);
+	}
+	return Tracer;
+}
+
+void AFlareShellManager::ReleaseTracer(UParticleSystemComponent* Tracer)
+{
+	Tracer->DeactivateSystem();
+	Tracer->KillParticlesForced();
+	FreeTracers.Add(Tracer);
+}
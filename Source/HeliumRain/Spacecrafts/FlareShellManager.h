@@ -0,0 +1,122 @@
+#pragma once
+
+#include "FlareWeapon.h"
+#include "FlareShellManager.generated.h"
+
+class UFlareSector;
+class AFlareSpacecraft;
+
+
+/** Gun shells of the active sector, simulated together as arrays instead of one actor per shell */
+UCLASS()
+class AFlareShellManager : public AActor
+{
+public:
+
+	GENERATED_UCLASS_BODY()
+
+public:
+
+	/*----------------------------------------------------
+		Public methods
+	----------------------------------------------------*/
+
+	/** Setup the manager for a sector */
+	void Initialize(UFlareSector* ParentSector);
+
+	/** Fire a new shell from Location */
+	void FireShell(UFlareWeapon* Weapon, const FFlareSpacecraftComponentDescription* Description, FVector Location,
+		FVector ShootDirection, FVector ParentVelocity, bool Tracer, float SecureTime, float ActiveTime);
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	virtual void SetPause(bool Pause);
+
+	int32 GetShellCount() const
+	{
+		return Locations.Num();
+	}
+
+
+protected:
+
+	/*----------------------------------------------------
+		Shell simulation
+	----------------------------------------------------*/
+
+	/** Impact happened */
+	void OnImpact(int32 ShellIndex, const FHitResult& HitResult, const FVector& ImpactVelocity);
+
+	void DetonateAt(int32 ShellIndex, FVector DetonatePoint);
+
+	bool Trace(int32 ShellIndex, const FVector& Start, const FVector& End, FHitResult& HitOut);
+
+	float ApplyDamage(int32 ShellIndex, AActor *ActorToDamage, UPrimitiveComponent* ImpactComponent, FVector ImpactLocation, FVector ImpactAxis, FVector ImpactNormal, float ImpactPower, float ImpactRadius, EFlareDamage::Type DamageType);
+
+	void CheckFuze(int32 ShellIndex, FVector ActorLocation, FVector NextActorLocation);
+
+	/** Remove a shell once the current update is done with it */
+	void DestroyShell(int32 ShellIndex);
+
+	/** Remove a shell from the arrays */
+	void RemoveShell(int32 ShellIndex);
+
+	/** Name reported as the damage causer for a shell */
+	FString GetShellName(int32 ShellIndex) const;
+
+
+	/*----------------------------------------------------
+		Tracer pool
+	----------------------------------------------------*/
+
+	UParticleSystemComponent* GetTracer(UParticleSystem* Template, FVector Location, FRotator Rotation);
+
+	void ReleaseTracer(UParticleSystemComponent* Tracer);
+
+
+	/*----------------------------------------------------
+		Protected data
+	----------------------------------------------------*/
+
+	/** Root component */
+	UPROPERTY()
+	USceneComponent*                         ManagerComp;
+
+	/** Every tracer created so far */
+	UPROPERTY()
+	TArray<UParticleSystemComponent*>        AllTracers;
+
+	/** Tracers ready to be reused */
+	UPROPERTY()
+	TArray<UParticleSystemComponent*>        FreeTracers;
+
+	/** Parent weapons */
+	UPROPERTY()
+	TArray<UFlareWeapon*>                    Weapons;
+
+	UFlareSector*                            Sector;
+	AFlarePlayerController*                  PC;
+	FCollisionQueryParams                    TraceParams;
+	AFlareSpacecraft*                        TraceSpacecraft;
+	uint32                                   NextShellId;
+	bool                                     Paused;
+
+	// Shell data
+	TArray<FVector>                          Locations;
+	TArray<FVector>                          Velocities;
+	TArray<float>                            LifeSpans;
+	TArray<float>                            InitialLifeSpans;
+	TArray<float>                            Masses;
+	TArray<float>                            SecureTimes;
+	TArray<float>                            ActiveTimes;
+	TArray<float>                            MinEffectiveDistances;
+	TArray<bool>                             Armed;
+	TArray<bool>                             Alive;
+	TArray<uint32>                           ShellIds;
+	TArray<const FFlareSpacecraftComponentDescription*> Descriptions;
+	TArray<UParticleSystemComponent*>        FlightEffects;
+
+	// Temporary data
+	TArray<FVector>                          NextLocations;
+
+};
@@ -7,6 +7,7 @@
 
 #include "../Game/FlareCompany.h"
 #include "../Game/FlareGame.h"
+#include "../Game/FlareSector.h"
 #include "../Game/AI/FlareCompanyAI.h"
 
 #include "../Player/FlarePlayerController.h"
@@ -35,6 +36,9 @@ UFlareShipPilot::UFlareShipPilot(const class FObjectInitializer& PCIP)
 {
 	ReactionTime = FMath::FRandRange(0.4, 0.7);
 	TimeUntilNextReaction = 0;
+	TimeSinceLastTick = 0;
+	TickIntervalJitter = FMath::FRandRange(0.75, 1.25);
+	TimeSinceLastRetarget = 0;
 	CurrentWaitTime = 0;
 	DockWaitTime = FMath::FRandRange(30, 45);
 	PilotTargetLocation = FVector::ZeroVector;
@@ -67,6 +71,18 @@ void UFlareShipPilot::TickPilot(float DeltaSeconds)
 		return;
 	}
 
+	// Think less often when far from the player or docked, the current controls are kept meanwhile
+	TimeSinceLastTick += DeltaSeconds;
+	float TickInterval = Ship->GetGame()->GetActiveSector()->GetPilotScheduler().GetPilotTickInterval(Ship, PilotTargetShip != NULL);
+	if (TimeSinceLastTick < TickInterval * TickIntervalJitter)
+	{
+		return;
+	}
+
+	DeltaSeconds = TimeSinceLastTick;
+	TimeSinceLastTick = 0;
+	TickIntervalJitter = FMath::FRandRange(0.75, 1.25);
+
 	TimeUntilNextReaction -= DeltaSeconds;
 
 
@@ -134,7 +150,25 @@ void UFlareShipPilot::MilitaryPilot(float DeltaSeconds)
 	}
 
 	CurrentTactic = Ship->GetCompany()->GetTacticManager()->GetCurrentTacticForShipGroup(CombatGroup);
-	FindBestHostileTarget(CurrentTactic);
+
+	// Look for a better target from time to time, within the sector budget
+	FFlarePilotScheduler& Scheduler = Ship->GetGame()->GetActiveSector()->GetPilotScheduler();
+	bool HasValidTarget = PilotTargetShip && !PilotTargetShip->IsPendingKill() && PilotTargetShip->GetParent()->GetDamageSystem()->IsAlive();
+	float RetargetDelay = (HasValidTarget ? 0.5 : 0);
+	TimeSinceLastRetarget += DeltaSeconds;
+
+	if (TimeSinceLastRetarget >= RetargetDelay && Scheduler.CanRetarget(TimeSinceLastRetarget - RetargetDelay))
+	{
+		double StartTime = FPlatformTime::Seconds();
+		FindBestHostileTarget(CurrentTactic);
+		Scheduler.AddRetargetTime(FPlatformTime::Seconds() - StartTime);
+		TimeSinceLastRetarget = 0;
+	}
+	else if (!HasValidTarget)
+	{
+		PilotTargetShip = NULL;
+		SelectedWeaponGroupIndex = -1;
+	}
 
 	bool Idle = true;
 
@@ -1269,11 +1303,7 @@ FVector UFlareShipPilot::ExitAvoidance(AFlareSpacecraft* TargetShip, FVector Ini
 
 		FVector CurrentVelocityAxis = CurrentVelocity.GetUnsafeNormal();
 
-		// TODO Cache
-		TArray<UActorComponent*> Engines = Ship->GetComponentsByClass(UFlareEngine::StaticClass());
-
-
-		FVector Acceleration = Ship->GetNavigationSystem()->GetTotalMaxThrustInAxis(Engines, CurrentVelocityAxis, false) / Ship->GetSpacecraftMass();
+		FVector Acceleration = Ship->GetNavigationSystem()->GetTotalMaxThrustInAxis(CurrentVelocityAxis, false) / Ship->GetSpacecraftMass();
 		float AccelerationInAngleAxis =  FMath::Abs(FVector::DotProduct(Acceleration, CurrentVelocityAxis));
 
 		TimeToStop= (CurrentVelocity.Size() / (AccelerationInAngleAxis));
@@ -1371,43 +1401,20 @@ AFlareSpacecraft* UFlareShipPilot::GetNearestHostileShip(bool DangerousOnly, EFl
 		return NULL;
 	}
 
-	FVector PilotLocation = Ship->GetActorLocation();
-	float MinDistanceSquared = -1;
-	AFlareSpacecraft* NearestHostileShip = NULL;
-
-	for (int32 SpacecraftIndex = 0; SpacecraftIndex < Ship->GetGame()->GetActiveSector()->GetSpacecrafts().Num(); SpacecraftIndex++)
+	auto IsHostileShip = [=](const FFlareSpatialIndexEntry& Entry)
 	{
-		AFlareSpacecraft* ShipCandidate = Ship->GetGame()->GetActiveSector()->GetSpacecrafts()[SpacecraftIndex];
+		AFlareSpacecraft* ShipCandidate = Entry.Spacecraft;
 
-		if (!ShipCandidate->GetParent()->GetDamageSystem()->IsAlive())
-		{
-			continue;
-		}
-
-		if (ShipCandidate->GetSize() != Size)
-		{
-			continue;
-		}
-
-		if (DangerousOnly && ! PilotHelper::IsShipDangerous(ShipCandidate))
-		{
-			continue;
-		}
+		return ShipCandidate->GetParent()->GetDamageSystem()->IsAlive()
+			&& ShipCandidate->GetSize() == Size
+			&& (!DangerousOnly || PilotHelper::IsShipDangerous(ShipCandidate))
+			&& Ship->GetCompany()->GetWarState(ShipCandidate->GetCompany()) == EFlareHostility::Hostile;
+	};
 
-		if (Ship->GetCompany()->GetWarState(ShipCandidate->GetCompany()) != EFlareHostility::Hostile)
-		{
-			continue;
-		}
-
-		float DistanceSquared = (PilotLocation - ShipCandidate->GetActorLocation()).SizeSquared();
-		if (NearestHostileShip == NULL || DistanceSquared < MinDistanceSquared)
-		{
-			MinDistanceSquared = DistanceSquared;
-			NearestHostileShip = ShipCandidate;
-		}
+	const FFlareSpatialIndexEntry* NearestHostileShip = Ship->GetGame()->GetActiveSector()->GetSpatialIndex().GetNearest(
+		Ship->GetActorLocation(), EFlareSpatialBody::Spacecraft, false, IsHostileShip);
 
-	}
-	return NearestHostileShip;
+	return NearestHostileShip ? NearestHostileShip->Spacecraft : NULL;
 }
 
 AFlareSpacecraft* UFlareShipPilot::GetNearestShip(bool IgnoreDockingShip) const
@@ -1455,8 +1462,6 @@ AFlareSpacecraft* UFlareShipPilot::GetNearestShip(bool IgnoreDockingShip) const
 
 FVector UFlareShipPilot::GetAngularVelocityToAlignAxis(FVector LocalShipAxis, FVector TargetAxis, FVector TargetAngularVelocity, float DeltaSeconds) const
 {
-	TArray<UActorComponent*> Engines = Ship->GetComponentsByClass(UFlareEngine::StaticClass());
-
 	FVector AngularVelocity = Ship->Airframe->GetPhysicsAngularVelocity();
 	FVector WorldShipAxis = Ship->Airframe->GetComponentToWorld().GetRotation().RotateVector(LocalShipAxis);
 
@@ -1481,7 +1486,7 @@ FVector UFlareShipPilot::GetAngularVelocityToAlignAxis(FVector LocalShipAxis, FV
 	else {
 		FVector SimpleAcceleration = DeltaVelocityAxis * Ship->GetNavigationSystem()->GetAngularAccelerationRate();
 	    // Scale with damages
-		float DamageRatio = Ship->GetNavigationSystem()->GetTotalMaxTorqueInAxis(Engines, DeltaVelocityAxis, true) / Ship->GetNavigationSystem()->GetTotalMaxTorqueInAxis(Engines, DeltaVelocityAxis, false);
+		float DamageRatio = Ship->GetNavigationSystem()->GetTotalMaxTorqueInAxis(DeltaVelocityAxis, true) / Ship->GetNavigationSystem()->GetTotalMaxTorqueInAxis(DeltaVelocityAxis, false);
 	    FVector DamagedSimpleAcceleration = SimpleAcceleration * DamageRatio;
 
 	    FVector Acceleration = DamagedSimpleAcceleration;
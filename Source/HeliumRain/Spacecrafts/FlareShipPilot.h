@@ -130,6 +130,9 @@ protected:
 	// Pilot brain TODO save in save
 	float                                        ReactionTime;
 	float                                        TimeUntilNextReaction;
+	float                                        TimeSinceLastTick;
+	float                                        TickIntervalJitter;
+	float                                        TimeSinceLastRetarget;
 	FVector                                      PilotTargetLocation;
 	float								         DockWaitTime;
 	float								         CurrentWaitTime;
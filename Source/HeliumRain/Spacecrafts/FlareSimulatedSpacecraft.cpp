@@ -134,6 +134,12 @@ void UFlareSimulatedSpacecraft::Load(const FFlareSpacecraftSave& Data)
 	// Lock resources
 	LockResources();
 
+	// Factories were rebuilt
+	if (CurrentSector && IsStation())
+	{
+		CurrentSector->InvalidateMarketIndex();
+	}
+
 	if(ActiveSpacecraft)
 	{
 		ActiveSpacecraft->Load(this);
@@ -493,6 +499,11 @@ void UFlareSimulatedSpacecraft::SetIntercepted(bool Intercepted)
 
 void UFlareSimulatedSpacecraft::SetReserve(bool InReserve)
 {
+	if (SpacecraftData.IsReserve != InReserve && CurrentSector)
+	{
+		CurrentSector->InvalidateBattleStates();
+	}
+
 	SpacecraftData.IsReserve = InReserve;
 }
 
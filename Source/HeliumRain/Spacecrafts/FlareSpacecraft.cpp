@@ -151,14 +151,10 @@ void AFlareSpacecraft::Tick(float DeltaSeconds)
 		}
 
 		// Lights
-		TArray<UActorComponent*> LightComponents = GetComponentsByClass(USpotLightComponent::StaticClass());
-		for (int32 ComponentIndex = 0; ComponentIndex < LightComponents.Num(); ComponentIndex++)
+		bool HasPowerOutage = Parent->GetDamageSystem()->HasPowerOutage();
+		for (int32 ComponentIndex = 0; ComponentIndex < Lights.Num(); ComponentIndex++)
 		{
-			USpotLightComponent* Component = Cast<USpotLightComponent>(LightComponents[ComponentIndex]);
-			if (Component)
-			{
-				Component->SetActive(!Parent->GetDamageSystem()->HasPowerOutage());
-			}
+			Lights[ComponentIndex]->SetActive(!HasPowerOutage);
 		}
 
 		// Player ship updates
@@ -667,6 +663,9 @@ void AFlareSpacecraft::Load(UFlareSimulatedSpacecraft* ParentSpacecraft)
 		}
 	}
 
+	// Turrets recreate their subcomponents when initialized
+	UpdateComponentRegistry();
+
 	// Look for an asteroid component
 	ApplyAsteroidData();
 
@@ -925,15 +924,59 @@ void AFlareSpacecraft::UpdateDynamicComponents()
 	}
 }
 
+void AFlareSpacecraft::UpdateComponentRegistry()
+{
+	SpacecraftComponents.Empty();
+	Engines.Empty();
+	RCSs.Empty();
+	Weapons.Empty();
+	InternalComponents.Empty();
+	Lights.Empty();
+	Decals.Empty();
+
+	for (UActorComponent* Component : GetComponents())
+	{
+		if (UFlareSpacecraftComponent* SpacecraftComponent = Cast<UFlareSpacecraftComponent>(Component))
+		{
+			SpacecraftComponents.Add(SpacecraftComponent);
+
+			if (UFlareEngine* Engine = Cast<UFlareEngine>(Component))
+			{
+				Engines.Add(Engine);
+
+				if (UFlareRCS* RCS = Cast<UFlareRCS>(Component))
+				{
+					RCSs.Add(RCS);
+				}
+			}
+			else if (UFlareWeapon* Weapon = Cast<UFlareWeapon>(Component))
+			{
+				Weapons.Add(Weapon);
+			}
+			else if (UFlareInternalComponent* InternalComponent = Cast<UFlareInternalComponent>(Component))
+			{
+				InternalComponents.Add(InternalComponent);
+			}
+		}
+		else if (USpotLightComponent* Light = Cast<USpotLightComponent>(Component))
+		{
+			Lights.Add(Light);
+		}
+		else if (UDecalComponent* Decal = Cast<UDecalComponent>(Component))
+		{
+			Decals.Add(Decal);
+		}
+	}
+}
+
 UFlareInternalComponent* AFlareSpacecraft::GetInternalComponentAtLocation(FVector Location) const
 {
 	float MinDistance = 100000; // 1km
 	UFlareInternalComponent* ClosestComponent = NULL;
 
-	TArray<UActorComponent*> Components = GetComponentsByClass(UFlareInternalComponent::StaticClass());
-	for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
+	for (int32 ComponentIndex = 0; ComponentIndex < InternalComponents.Num(); ComponentIndex++)
 	{
-		UFlareInternalComponent* InternalComponent = Cast<UFlareInternalComponent>(Components[ComponentIndex]);
+		UFlareInternalComponent* InternalComponent = InternalComponents[ComponentIndex];
 
 		FVector ComponentLocation;
 		float ComponentSize;
@@ -979,6 +1022,9 @@ void AFlareSpacecraft::UpdateCustomization()
 	// Send the update event to subsystems
 	Super::UpdateCustomization();
 	Airframe->UpdateCustomization();
+
+	// Parts that were not initialized yet may have created subcomponents
+	UpdateComponentRegistry();
 	if (ShipNameTexture)
 	{
 		ShipNameTexture->UpdateResource();
@@ -1087,27 +1133,18 @@ void AFlareSpacecraft::DrawShipName(UCanvas* TargetCanvas, int32 Width, int32 He
 
 void AFlareSpacecraft::OnRepaired()
 {
-	TArray<UActorComponent*> Components = GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
-	for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
+	for (int32 ComponentIndex = 0; ComponentIndex < SpacecraftComponents.Num(); ComponentIndex++)
 	{
-		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(Components[ComponentIndex]);
-		Component->OnRepaired();
+		SpacecraftComponents[ComponentIndex]->OnRepaired();
 	}
 }
 
 void AFlareSpacecraft::OnRefilled()
 {
 	// Reload and repair
-	TArray<UActorComponent*> Components = GetComponentsByClass(UFlareSpacecraftComponent::StaticClass());
-	for (int32 ComponentIndex = 0; ComponentIndex < Components.Num(); ComponentIndex++)
+	for (int32 WeaponIndex = 0; WeaponIndex < Weapons.Num(); WeaponIndex++)
 	{
-		UFlareSpacecraftComponent* Component = Cast<UFlareSpacecraftComponent>(Components[ComponentIndex]);
-
-		UFlareWeapon* Weapon = Cast<UFlareWeapon>(Components[ComponentIndex]);
-		if (Weapon)
-		{
-			Weapon->OnRefilled();
-		}
+		Weapons[WeaponIndex]->OnRefilled();
 	}
 }
 
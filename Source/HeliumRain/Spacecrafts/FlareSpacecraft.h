@@ -13,6 +13,8 @@
 
 class UFlareShipPilot;
 class AFlareSpacecraft;
+class UFlareEngine;
+class UFlareRCS;
 
 /** Target info */
 USTRUCT()
@@ -121,6 +123,9 @@ public:
 	void ApplyAsteroidData();
 
 	void UpdateDynamicComponents();
+
+	/** Sort the components of this spacecraft by type, so that ticks don't need to look for them */
+	void UpdateComponentRegistry();
 	
 	UFlareSimulatedSector* GetOwnerSector();
 	
@@ -293,6 +298,22 @@ protected:
 	UPROPERTY()
 	UFlareSpacecraftStateManager*				   StateManager;
 
+	// Component registry, rebuilt whenever components are created
+	UPROPERTY()
+	TArray<UFlareSpacecraftComponent*>             SpacecraftComponents;
+	UPROPERTY()
+	TArray<UFlareEngine*>                          Engines;
+	UPROPERTY()
+	TArray<UFlareRCS*>                             RCSs;
+	UPROPERTY()
+	TArray<UFlareWeapon*>                          Weapons;
+	UPROPERTY()
+	TArray<UFlareInternalComponent*>               InternalComponents;
+	UPROPERTY()
+	TArray<USpotLightComponent*>                   Lights;
+	UPROPERTY()
+	TArray<UDecalComponent*>                       Decals;
+
 	bool                                           HasExitedSector;
 	bool                                           Paused;
 	bool                                           LoadedAndReady;
@@ -403,6 +424,42 @@ public:
 		return ShipCockit;
 	}
 
+	inline const TArray<UFlareSpacecraftComponent*>& GetSpacecraftComponents() const
+	{
+		return SpacecraftComponents;
+	}
+
+	/** Get all engines, including RCS and orbital engines */
+	inline const TArray<UFlareEngine*>& GetEngines() const
+	{
+		return Engines;
+	}
+
+	inline const TArray<UFlareRCS*>& GetRCSs() const
+	{
+		return RCSs;
+	}
+
+	inline const TArray<UFlareWeapon*>& GetWeapons() const
+	{
+		return Weapons;
+	}
+
+	inline const TArray<UFlareInternalComponent*>& GetInternalComponents() const
+	{
+		return InternalComponents;
+	}
+
+	inline const TArray<USpotLightComponent*>& GetLights() const
+	{
+		return Lights;
+	}
+
+	inline const TArray<UDecalComponent*>& GetDecals() const
+	{
+		return Decals;
+	}
+
 	virtual UCameraComponent* GetCamera() const
 	{
 		return Cast<UCameraComponent>(Camera);
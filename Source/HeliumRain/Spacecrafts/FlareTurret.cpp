@@ -2,7 +2,6 @@
 #include "../Flare.h"
 #include "FlareTurret.h"
 #include "FlareSpacecraft.h"
-#include "FlareShell.h"
 #include "FlareSpacecraftSubComponent.h"
 
 DECLARE_CYCLE_STAT(TEXT("FlareTurret Tick"), STAT_FlareTurret_Tick, STATGROUP_Flare);
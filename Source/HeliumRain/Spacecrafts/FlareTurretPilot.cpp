@@ -10,6 +10,7 @@
 
 #include "../Player/FlarePlayerController.h"
 #include "../Game/FlareGame.h"
+#include "../Game/FlareThreatTable.h"
 #include "../Game/AI/FlareCompanyAI.h"
 
 DECLARE_CYCLE_STAT(TEXT("FlareTurretPilot Tick"), STAT_FlareTurretPilot_Tick, STATGROUP_Flare);
@@ -318,8 +319,6 @@ AFlareSpacecraft* UFlareTurretPilot::GetNearestHostileShip(bool ReachableOnly, E
 	}
 
 	FVector PilotLocation = Turret->GetTurretBaseLocation();
-	float MaxDot = 0;
-	AFlareSpacecraft* NearestHostileShip = NULL;
 	FVector FireAxis = Turret->GetFireAxis();
 
 
@@ -381,35 +380,20 @@ AFlareSpacecraft* UFlareTurretPilot::GetNearestHostileShip(bool ReachableOnly, E
 	}
 
 
-	while (NearestHostileShip == NULL)
+	// Skip targets too close for the fuze, or out of reach
+	auto IsValidTarget = [&](const FFlareThreatEntry& Candidate)
 	{
-		NearestHostileShip = PilotHelper::GetBestTarget(Turret->GetSpacecraft(), TargetPreferences);
-
-		if(NearestHostileShip == NULL)
-		{
-			// No target
-			return NULL;
-		}
-
-
-		float Distance = (PilotLocation - NearestHostileShip->GetActorLocation()).Size();
+		float Distance = (PilotLocation - Candidate.Location).Size();
 		if (Distance < SecurityRadius * 100)
 		{
-			TargetPreferences.IgnoreList.Add(NearestHostileShip);
-			NearestHostileShip = NULL;
-			continue;
+			return false;
 		}
 
-		FVector TargetAxis = (NearestHostileShip->GetActorLocation()- PilotLocation).GetUnsafeNormal();
+		FVector TargetAxis = (Candidate.Location - PilotLocation).GetUnsafeNormal();
+		return !ReachableOnly || Turret->IsReacheableAxis(TargetAxis);
+	};
 
-		if (ReachableOnly && !Turret->IsReacheableAxis(TargetAxis))
-		{
-			TargetPreferences.IgnoreList.Add(NearestHostileShip);
-			NearestHostileShip = NULL;
-			continue;
-		}
-	}
-	return NearestHostileShip;
+	return PilotHelper::GetBestTarget(Turret->GetSpacecraft(), TargetPreferences, IsValidTarget);
 }
 
 bool UFlareTurretPilot::IsShipDangerous(AFlareSpacecraft* ShipCandidate) const
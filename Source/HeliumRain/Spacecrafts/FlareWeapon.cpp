@@ -3,8 +3,9 @@
 #include "FlareSpacecraftTypes.h"
 #include "FlareWeapon.h"
 #include "FlareSpacecraft.h"
-#include "FlareShell.h"
+#include "FlareShellManager.h"
 #include "FlareBomb.h"
+#include "../Game/FlareGame.h"
 #include "../Player/FlarePlayerController.h"
 
 DECLARE_CYCLE_STAT(TEXT("FlareWeapon Firing"), STAT_Weapon_Firing, STATGROUP_Flare);
@@ -72,11 +73,6 @@ void UFlareWeapon::Initialize(FFlareSpacecraftComponentSave* Data, UFlareCompany
 		}
 	}
 
-	// Spawn properties
-	ProjectileSpawnParams.Instigator = SpacecraftPawn;
-	ProjectileSpawnParams.bNoFail = true;
-	ProjectileSpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-
 	// Additional properties
 	LastFiredGun = -1;
 	SetupFiringEffects();
@@ -229,16 +225,12 @@ bool UFlareWeapon::FireGun(int GunIndex)
 	FVector FiringDirection = FMath::VRandCone(FiringAxis, Imprecision);
 	FVector FiringVelocity = Spacecraft->Airframe->GetPhysicsLinearVelocity();
 
-	// Create a shell
-	AFlareShell* Shell = GetWorld()->SpawnActor<AFlareShell>(
-		AFlareShell::StaticClass(),
-		FiringLocation,
-		FRotator::ZeroRotator,
-		ProjectileSpawnParams);
-
-	// Fire it. Tracer ammo every bullets
-	Shell->Initialize(this, ComponentDescription, FiringDirection, FiringVelocity, true);
-	ConfigureShellFuze(Shell);
+	// Fire a shell. Tracer ammo every bullets
+	float SecureTime = 0;
+	float ActiveTime = 0;
+	ConfigureShellFuze(SecureTime, ActiveTime);
+	Spacecraft->GetGame()->GetActiveSector()->GetShellManager()->FireShell(this, ComponentDescription, FiringLocation,
+		FiringDirection, FiringVelocity, true, SecureTime, ActiveTime);
 	ShowFiringEffects(GunIndex);
 
 	// Play sound
@@ -278,7 +270,7 @@ bool UFlareWeapon::FireBomb()
 	return true;
 }
 
-void UFlareWeapon::ConfigureShellFuze(AFlareShell* Shell)
+void UFlareWeapon::ConfigureShellFuze(float& SecureTime, float& ActiveTime)
 {
 	SCOPE_CYCLE_COUNTER(STAT_Weapon_ConfigureShellFuze);
 
@@ -286,7 +278,7 @@ void UFlareWeapon::ConfigureShellFuze(AFlareShell* Shell)
 	{
 		float SecurityRadius = 	ComponentDescription->WeaponCharacteristics.AmmoExplosionRadius + Spacecraft->GetMeshScale() / 100;
 		float SecurityDelay = SecurityRadius / ComponentDescription->WeaponCharacteristics.GunCharacteristics.AmmoVelocity;
-		float ActiveTime = 10;
+		ActiveTime = 10;
 
 		FVector RelativeFiringVelocity = Spacecraft->GetLinearVelocity() - TargetVelocity;
 		FVector TargetOffset = TargetLocation - Spacecraft->GetActorLocation();
@@ -300,7 +292,7 @@ void UFlareWeapon::ConfigureShellFuze(AFlareShell* Shell)
 		SecurityDelay = FMath::Max(SecurityDelay, NeededSecurityDelay);
 		ActiveTime = EstimatedFlightTime * 1.5 - SecurityDelay;
 
-		Shell->SetFuzeTimer(SecurityDelay, ActiveTime);
+		SecureTime = SecurityDelay;
 	}
 }
 
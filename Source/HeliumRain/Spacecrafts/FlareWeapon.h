@@ -3,7 +3,6 @@
 #include "FlareSpacecraftComponent.h"
 #include "FlareWeapon.generated.h"
 
-class AFlareShell;
 class AFlareBomb;
 struct FFlareWeaponGroup;
 
@@ -69,7 +68,8 @@ public:
 
 	virtual bool FireBomb();
 
-	virtual void ConfigureShellFuze(AFlareShell* Shell);
+	/** Get the proximity fuze timers of a new shell */
+	virtual void ConfigureShellFuze(float& SecureTime, float& ActiveTime);
 
 	/** Set the target data */
 	virtual void SetTarget(FVector TargetLocation, FVector TargetVelocity);
@@ -128,7 +128,6 @@ protected:
 	float                       FiringRate;
 	float                       FiringPeriod;
 	float                       AmmoVelocity;
-	FActorSpawnParameters       ProjectileSpawnParams;
 
 	UPROPERTY()
 	TArray<AFlareBomb*>         Bombs;
@@ -4,6 +4,7 @@
 #include "../FlareSimulatedSpacecraft.h"
 #include "../FlareSpacecraftComponent.h"
 #include "../../Game/FlareGame.h"
+#include "../../Game/FlareSimulatedSector.h"
 #include "FlareSimulatedSpacecraftDamageSystem.h"
 
 DECLARE_CYCLE_STAT(TEXT("FlareSimulatedDamageSystem UpdateSubsystemHealth"), STAT_FlareSimulatedDamageSystem_UpdateSubsystemHealth, STATGROUP_Flare);
@@ -37,6 +38,7 @@ void UFlareSimulatedSpacecraftDamageSystem::Initialize(UFlareSimulatedSpacecraft
 	DamageDirty = true;
 	AmmoDirty = true;
 	IsPoweredCacheIndex = 0;
+	ComponentStateIndex = 0;
 
 	for (int32 Index = EFlareSubsystem::SYS_None; Index <= EFlareSubsystem::SYS_WeaponAndAmmo; Index++)
 	{
@@ -606,20 +608,33 @@ float UFlareSimulatedSpacecraftDamageSystem::GetSubsystemHealthInternal(EFlareSu
 void UFlareSimulatedSpacecraftDamageSystem::SetPowerDirty()
 {
 	IsPoweredCacheIndex++;
+	ComponentStateIndex++;
 }
 
 void UFlareSimulatedSpacecraftDamageSystem::SetDamageDirty(FFlareSpacecraftComponentDescription* ComponentDescription)
 {
 	DamageDirty = true;
+	ComponentStateIndex++;
 	if(ComponentDescription->GeneralCharacteristics.ElectricSystem)
 	{
 		SetPowerDirty();
 	}
+
+	if (Spacecraft->GetCurrentSector())
+	{
+		Spacecraft->GetCurrentSector()->InvalidateBattleStates();
+	}
 }
 
 void UFlareSimulatedSpacecraftDamageSystem::SetAmmoDirty()
 {
 	AmmoDirty = true;
+
+	// Running out of ammo disarms the ship
+	if (Spacecraft->GetCurrentSector())
+	{
+		Spacecraft->GetCurrentSector()->InvalidateBattleStates();
+	}
 }
 
 bool UFlareSimulatedSpacecraftDamageSystem::IsPowered(FFlareSpacecraftComponentSave* ComponentToPowerData) const
@@ -114,6 +114,12 @@ public:
 	void SetDamageDirty(FFlareSpacecraftComponentDescription* ComponentDescription);
 	void SetAmmoDirty();
 
+	/** Incremented every time the damage or the power of a component changes */
+	int64 GetComponentStateIndex() const
+	{
+		return ComponentStateIndex;
+	}
+
 	void NotifyDamage();
 
 protected:
@@ -145,6 +151,7 @@ protected:
 
 	TArray<float>                                   SubsystemHealth;
 	int64                                           IsPoweredCacheIndex;
+	int64                                           ComponentStateIndex;
 
 	bool                                            DamageDirty;
 	bool                                            AmmoDirty;
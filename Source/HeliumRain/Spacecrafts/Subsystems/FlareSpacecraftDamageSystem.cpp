@@ -7,7 +7,6 @@
 #include "../../Player/FlarePlayerController.h"
 #include "../FlareEngine.h"
 #include "../FlareOrbitalEngine.h"
-#include "../FlareShell.h"
 
 DECLARE_CYCLE_STAT(TEXT("FlareDamageSystem Tick"), STAT_FlareDamageSystem_Tick, STATGROUP_Flare);
 
@@ -416,12 +415,6 @@ void UFlareSpacecraftDamageSystem::OnCollision(class AActor* Other, FVector HitL
 
 	// If the other actor is a projectile, specific weapon damage code is done in the projectile hit
 	// handler: in this case we ignore the collision
-	AFlareShell* OtherProjectile = Cast<AFlareShell>(Other);
-	if (OtherProjectile)
-	{
-		return;
-	}
-
 	AFlareBomb* OtherBomb = Cast<AFlareBomb>(Other);
 	if (OtherBomb)
 	{
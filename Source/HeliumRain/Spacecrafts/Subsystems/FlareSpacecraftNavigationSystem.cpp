@@ -23,6 +23,7 @@ DECLARE_CYCLE_STAT(TEXT("FlareNavigationSystem UpdateAngularAttitudeAuto"), STAT
 DECLARE_CYCLE_STAT(TEXT("FlareNavigationSystem GetAngularVelocityToAlignAxis"), STAT_NavigationSystem_GetAngularVelocityToAlignAxis, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareNavigationSystem GetTotalMaxThrustInAxis"), STAT_NavigationSystem_GetTotalMaxThrustInAxis, STATGROUP_Flare);
 DECLARE_CYCLE_STAT(TEXT("FlareNavigationSystem GetTotalMaxTorqueInAxis"), STAT_NavigationSystem_GetTotalMaxTorqueInAxis, STATGROUP_Flare);
+DECLARE_CYCLE_STAT(TEXT("FlareNavigationSystem UpdateEngineEnvelope"), STAT_NavigationSystem_UpdateEngineEnvelope, STATGROUP_Flare);
 
 #define LOCTEXT_NAMESPACE "FlareSpacecraftNavigationSystem"
 
@@ -43,6 +44,9 @@ UFlareSpacecraftNavigationSystem::UFlareSpacecraftNavigationSystem(const class F
 {
 	AnticollisionAngle = FMath::FRandRange(0, 360);
 	DockConstraint = NULL;
+	LocalCOM = FVector::ZeroVector;
+	EngineEnvelopeStateIndex = -1;
+	EngineEnvelopePowerOutage = false;
 }
 
 
@@ -55,6 +59,7 @@ void UFlareSpacecraftNavigationSystem::TickSystem(float DeltaSeconds)
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_Tick);
 
 	UpdateCOM();
+	UpdateEngineEnvelope();
 
 	// Manual pilot
 	if (IsManualPilot() && Spacecraft->GetParent()->GetDamageSystem()->IsAlive())
@@ -737,10 +742,10 @@ void UFlareSpacecraftNavigationSystem::ConfirmDock(AFlareSpacecraft* DockStation
 	DockConstraint->SetConstrainedComponents(Spacecraft->Airframe, NAME_None, DockStation->Airframe,NAME_None);
 
 	// Cut engines
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UFlareEngine*>& Engines = Spacecraft->GetEngines();
 	for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
+		UFlareEngine* Engine = Engines[EngineIndex];
 		Engine->SetAlpha(0.0f);
 	}
 
@@ -930,8 +935,6 @@ bool UFlareSpacecraftNavigationSystem::UpdateLinearAttitudeAuto(float DeltaSecon
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_UpdateLinearAttitudeAuto);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
-
 	FVector DeltaPosition = (TargetLocation - Spacecraft->GetActorLocation()) / 100; // Distance in meters
 	FVector DeltaPositionDirection = DeltaPosition;
 	DeltaPositionDirection.Normalize();
@@ -950,7 +953,7 @@ bool UFlareSpacecraftNavigationSystem::UpdateLinearAttitudeAuto(float DeltaSecon
 	else
 	{
 
-		FVector Acceleration = GetTotalMaxThrustInAxis(Engines, DeltaVelocityAxis, false) / Spacecraft->GetSpacecraftMass();
+		FVector Acceleration = GetTotalMaxThrustInAxis(DeltaVelocityAxis, false) / Spacecraft->GetSpacecraftMass();
 		float AccelerationInAngleAxis =  FMath::Abs(FVector::DotProduct(Acceleration, DeltaPositionDirection));
 
 		// TODO: Fix security ratio engine flickering
@@ -1017,8 +1020,6 @@ void UFlareSpacecraftNavigationSystem::UpdateAngularAttitudeAuto(float DeltaSeco
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_UpdateAngularAttitudeAuto);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
-
 	// Rotation data
 	FFlareShipCommandData Command;
 	CommandData.Peek(Command);
@@ -1054,7 +1055,7 @@ void UFlareSpacecraftNavigationSystem::UpdateAngularAttitudeAuto(float DeltaSeco
 	else {
 		FVector SimpleAcceleration = DeltaVelocityAxis * AngularAccelerationRate;
 		// Scale with damages
-		float DamageRatio = GetTotalMaxTorqueInAxis(Engines, DeltaVelocityAxis, true) / GetTotalMaxTorqueInAxis(Engines, DeltaVelocityAxis, false);
+		float DamageRatio = GetTotalMaxTorqueInAxis(DeltaVelocityAxis, true) / GetTotalMaxTorqueInAxis(DeltaVelocityAxis, false);
 		FVector DamagedSimpleAcceleration = SimpleAcceleration * DamageRatio;
 
 		FVector Acceleration = DamagedSimpleAcceleration;
@@ -1095,8 +1096,6 @@ FVector UFlareSpacecraftNavigationSystem::GetAngularVelocityToAlignAxis(FVector
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetAngularVelocityToAlignAxis);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
-
 	FVector AngularVelocity = Spacecraft->Airframe->GetPhysicsAngularVelocity();
 	FVector WorldShipAxis = Spacecraft->Airframe->GetComponentToWorld().GetRotation().RotateVector(LocalShipAxis);
 
@@ -1121,7 +1120,7 @@ FVector UFlareSpacecraftNavigationSystem::GetAngularVelocityToAlignAxis(FVector
 	else {
 		FVector SimpleAcceleration = DeltaVelocityAxis * GetAngularAccelerationRate();
 		// Scale with damages
-		float DamageRatio = GetTotalMaxTorqueInAxis(Engines, DeltaVelocityAxis, true) / GetTotalMaxTorqueInAxis(Engines, DeltaVelocityAxis, false);
+		float DamageRatio = GetTotalMaxTorqueInAxis(DeltaVelocityAxis, true) / GetTotalMaxTorqueInAxis(DeltaVelocityAxis, false);
 		FVector DamagedSimpleAcceleration = SimpleAcceleration * DamageRatio;
 
 		FVector Acceleration = DamagedSimpleAcceleration;
@@ -1170,20 +1169,22 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 {
 	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_Physics);
 
-	TArray<UActorComponent*> Engines = Spacecraft->GetComponentsByClass(UFlareEngine::StaticClass());
+	const TArray<UFlareEngine*>& Engines = Spacecraft->GetEngines();
 
 	if(Spacecraft->GetParent()->GetDamageSystem()->IsUncontrollable())
 	{
 		// Shutdown engines
 		for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 		{
-			UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
+			UFlareEngine* Engine = Engines[EngineIndex];
 			Engine->SetAlpha(0);
 		}
 
 		return;
 	}
 
+	UpdateEngineEnvelope();
+
 	//FLOGV("LinearTargetVelocity %s", *LinearTargetVelocity.ToString());
 
 	// Linear physics
@@ -1212,7 +1213,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 	if (!DeltaV.IsNearlyZero())
 	{
 		// First, try without using the boost
-		FVector Acceleration = DeltaVAxis * GetTotalMaxThrustInAxis(Engines, -DeltaVAxis, false).Size() / Spacecraft->GetSpacecraftMass();
+		FVector Acceleration = DeltaVAxis * GetTotalMaxThrustInAxis(-DeltaVAxis, false).Size() / Spacecraft->GetSpacecraftMass();
 
 		float AccelerationDeltaV = Acceleration.Size() * DeltaSeconds;
 
@@ -1220,7 +1221,7 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 		// Second, if the not enought trust check with the boost
 		if (UseOrbitalBoost && AccelerationDeltaV < DeltaV.Size() )
 		{
-			FVector AccelerationWithBoost = DeltaVAxis * GetTotalMaxThrustInAxis(Engines, -DeltaVAxis, true).Size() / Spacecraft->GetSpacecraftMass();
+			FVector AccelerationWithBoost = DeltaVAxis * GetTotalMaxThrustInAxis(-DeltaVAxis, true).Size() / Spacecraft->GetSpacecraftMass();
 
 			if (AccelerationWithBoost.Size() > Acceleration.Size())
 			{
@@ -1250,10 +1251,10 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 		FVector SimpleAcceleration = DeltaAngularVAxis * AngularAccelerationRate;
 
 		// Scale with damages
-		float TotalMaxTorqueInAxis = GetTotalMaxTorqueInAxis(Engines, DeltaAngularVAxis, false);
+		float TotalMaxTorqueInAxis = GetTotalMaxTorqueInAxis(DeltaAngularVAxis, false);
 		if (!FMath::IsNearlyZero(TotalMaxTorqueInAxis))
 		{
-			float DamageRatio = GetTotalMaxTorqueInAxis(Engines, DeltaAngularVAxis, true) / TotalMaxTorqueInAxis;
+			float DamageRatio = GetTotalMaxTorqueInAxis(DeltaAngularVAxis, true) / TotalMaxTorqueInAxis;
 			FVector DamagedSimpleAcceleration = SimpleAcceleration * DamageRatio;
 			FVector ClampedSimplifiedAcceleration = DamagedSimpleAcceleration.GetClampedToMaxSize(DeltaAngularV.Size() / DeltaSeconds);
 
@@ -1262,10 +1263,14 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 	}
 
 	// Update engine alpha
+	const FTransform& AirframeTransform = Spacecraft->Airframe->GetComponentToWorld();
+	FVector LocalDeltaVAxis = AirframeTransform.InverseTransformVectorNoScale(DeltaVAxis);
+	FVector LocalDeltaAngularVAxis = AirframeTransform.InverseTransformVectorNoScale(DeltaAngularVAxis);
+	bool HasDeltaAngularV = !DeltaAngularV.IsNearlyZero();
+	bool HasDeltaV = !DeltaV.IsNearlyZero() || HasDeltaAngularV;
+
 	for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[EngineIndex]);
-		FVector ThrustAxis = Engine->GetThrustAxis();
 		float LinearAlpha = 0;
 		float AngularAlpha = 0;
 
@@ -1273,114 +1278,136 @@ void UFlareSpacecraftNavigationSystem::PhysicSubTick(float DeltaSeconds)
 		{
 			LinearAlpha = true;
 		}
-		else if (!DeltaV.IsNearlyZero() || !DeltaAngularV.IsNearlyZero())
+		else if (HasDeltaV)
 		{
-			if(Engine->IsA(UFlareOrbitalEngine::StaticClass()))
+			float LinearRatio = -FVector::DotProduct(EngineThrustAxes[EngineIndex], LocalDeltaVAxis);
+
+			if (EngineIsOrbital[EngineIndex])
 			{
-				if(HasUsedOrbitalBoost)
+				if (HasUsedOrbitalBoost)
 				{
-					LinearAlpha = (-FVector::DotProduct(ThrustAxis, DeltaVAxis) + 0.2) * LinearMasterBoostAlpha;
+					LinearAlpha = (LinearRatio + 0.2) * LinearMasterBoostAlpha;
 				}
-				AngularAlpha = 0;
 			}
 			else
 			{
-				LinearAlpha = -FVector::DotProduct(ThrustAxis, DeltaVAxis) * LinearMasterAlpha;
-				FVector EngineOffset = (Engine->GetComponentLocation() - COM) / 100;
-				FVector TorqueDirection = FVector::CrossProduct(EngineOffset, ThrustAxis);
-				TorqueDirection.Normalize();
+				LinearAlpha = LinearRatio * LinearMasterAlpha;
 
-				if (!DeltaAngularV.IsNearlyZero() && !Engine->IsA(UFlareOrbitalEngine::StaticClass()))
+				if (HasDeltaAngularV)
 				{
-					AngularAlpha = -FVector::DotProduct(TorqueDirection, DeltaAngularVAxis);
+					AngularAlpha = -FVector::DotProduct(EngineTorqueDirections[EngineIndex], LocalDeltaAngularVAxis);
 				}
 			}
 		}
 
-		Engine->SetAlpha(FMath::Clamp(LinearAlpha + AngularAlpha, 0.0f, 1.0f));
+		Engines[EngineIndex]->SetAlpha(FMath::Clamp(LinearAlpha + AngularAlpha, 0.0f, 1.0f));
 	}
 }
 
 void UFlareSpacecraftNavigationSystem::UpdateCOM()
 {
 	COM = Spacecraft->Airframe->GetBodyInstance()->GetCOMPosition();
+
+	// Engine torques depend on the center of mass
+	FVector NewLocalCOM = Spacecraft->Airframe->GetComponentToWorld().InverseTransformPositionNoScale(COM);
+	if (!NewLocalCOM.Equals(LocalCOM, 1.0f))
+	{
+		LocalCOM = NewLocalCOM;
+		EngineEnvelopeStateIndex = -1;
+	}
 }
 
+void UFlareSpacecraftNavigationSystem::UpdateEngineEnvelope()
+{
+	UFlareSimulatedSpacecraftDamageSystem* DamageSystem = Spacecraft->GetParent()->GetDamageSystem();
+	const TArray<UFlareEngine*>& Engines = Spacecraft->GetEngines();
+	int64 StateIndex = DamageSystem->GetComponentStateIndex();
+	bool PowerOutage = DamageSystem->HasPowerOutage();
 
-/*----------------------------------------------------
-		Getters (Attitude)
-----------------------------------------------------*/
+	if (StateIndex == EngineEnvelopeStateIndex && PowerOutage == EngineEnvelopePowerOutage && EngineThrustAxes.Num() == Engines.Num())
+	{
+		return;
+	}
 
-FVector UFlareSpacecraftNavigationSystem::GetTotalMaxThrustInAxis(TArray<UActorComponent*>& Engines, FVector Axis, bool WithOrbitalEngines) const
-{
-	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetTotalMaxThrustInAxis);
+	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_UpdateEngineEnvelope);
 
-	Axis.Normalize();
-	FVector TotalMaxThrust = FVector::ZeroVector;
-	for (int32 i = 0; i < Engines.Num(); i++)
+	EngineThrustAxes.SetNum(Engines.Num());
+	EngineTorqueDirections.SetNum(Engines.Num());
+	EngineTorqueArms.SetNum(Engines.Num());
+	EngineMaxThrusts.SetNum(Engines.Num());
+	EngineInitialMaxThrusts.SetNum(Engines.Num());
+	EngineIsOrbital.SetNum(Engines.Num());
+
+	const FTransform& AirframeTransform = Spacecraft->Airframe->GetComponentToWorld();
+	for (int32 EngineIndex = 0; EngineIndex < Engines.Num(); EngineIndex++)
 	{
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[i]);
+		UFlareEngine* Engine = Engines[EngineIndex];
 
-		FVector WorldThrustAxis = Engine->GetThrustAxis();
-		float Ratio = FVector::DotProduct(WorldThrustAxis, Axis);
+		FVector ThrustAxis = AirframeTransform.InverseTransformVectorNoScale(Engine->GetThrustAxis());
+		ThrustAxis.Normalize();
+		FVector EngineOffset = (AirframeTransform.InverseTransformPositionNoScale(Engine->GetComponentLocation()) - LocalCOM) / 100;
+		FVector Torque = FVector::CrossProduct(EngineOffset, ThrustAxis);
+		bool IsOrbital = Engine->IsA(UFlareOrbitalEngine::StaticClass());
 
-		if (Engine->IsA(UFlareOrbitalEngine::StaticClass()))
-		{
-			if(WithOrbitalEngines && Ratio + 0.2 > 0)
-			{
-				TotalMaxThrust += WorldThrustAxis * Engine->GetMaxThrust() * (Ratio + 0.2);
-			}
-		}
-		else
-		{
-			if (Ratio > 0)
-			{
-				TotalMaxThrust += WorldThrustAxis * Engine->GetMaxThrust() * Ratio;
-			}
-		}
+		EngineThrustAxes[EngineIndex] = ThrustAxis;
+		EngineTorqueDirections[EngineIndex] = Torque.GetSafeNormal();
+		EngineTorqueArms[EngineIndex] = (IsOrbital ? 0 : Torque.Size()); // Ignore orbital engines for torque computation
+		EngineMaxThrusts[EngineIndex] = Engine->GetMaxThrustWithoutHeat();
+		EngineInitialMaxThrusts[EngineIndex] = Engine->GetInitialMaxThrust();
+		EngineIsOrbital[EngineIndex] = IsOrbital;
 	}
 
-	return TotalMaxThrust;
+	EngineEnvelopeStateIndex = StateIndex;
+	EngineEnvelopePowerOutage = PowerOutage;
 }
 
-float UFlareSpacecraftNavigationSystem::GetTotalMaxTorqueInAxis(TArray<UActorComponent*>& Engines, FVector TorqueAxis, bool WithDamages) const
-{
-	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetTotalMaxTorqueInAxis);
 
-	TorqueAxis.Normalize();
-	float TotalMaxTorque = 0;
+/*----------------------------------------------------
+		Getters (Attitude)
+----------------------------------------------------*/
 
-	for (int32 i = 0; i < Engines.Num(); i++) {
-		UFlareEngine* Engine = Cast<UFlareEngine>(Engines[i]);
+FVector UFlareSpacecraftNavigationSystem::GetTotalMaxThrustInAxis(FVector Axis, bool WithOrbitalEngines) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetTotalMaxThrustInAxis);
 
-		// Ignore orbital engines for torque computation
-		if (Engine->IsA(UFlareOrbitalEngine::StaticClass()))
-		{
-		  continue;
-		}
+	UFlareSpacecraftNavigationSystem* UnprotectedThis = const_cast<UFlareSpacecraftNavigationSystem *>(this);
+	UnprotectedThis->UpdateEngineEnvelope();
 
-		float MaxThrust = (WithDamages ? Engine->GetMaxThrust() : Engine->GetInitialMaxThrust());
+	const FTransform& AirframeTransform = Spacecraft->Airframe->GetComponentToWorld();
+	FVector LocalAxis = AirframeTransform.InverseTransformVectorNoScale(Axis.GetSafeNormal());
+	float OrbitalRatio = (WithOrbitalEngines ? 0.2 : -2); // Orbital engines get a bonus, or are never used
 
-		if (MaxThrust == 0)
-		{
-			// Not controlable engine
-			continue;
-		}
+	FVector TotalMaxThrust = FVector::ZeroVector;
+	for (int32 EngineIndex = 0; EngineIndex < EngineThrustAxes.Num(); EngineIndex++)
+	{
+		float Ratio = FVector::DotProduct(EngineThrustAxes[EngineIndex], LocalAxis) + (EngineIsOrbital[EngineIndex] ? OrbitalRatio : 0);
+		TotalMaxThrust += EngineThrustAxes[EngineIndex] * EngineMaxThrusts[EngineIndex] * FMath::Max(Ratio, 0.f);
+	}
 
-		FVector EngineOffset = (Engine->GetComponentLocation() - COM) / 100;
+	float HeatRatio = 1.0f - Spacecraft->GetDamageSystem()->GetOverheatRatio(0.05);
+	return AirframeTransform.TransformVectorNoScale(TotalMaxThrust) * HeatRatio;
+}
 
-		FVector WorldThrustAxis = Engine->GetThrustAxis();
-		WorldThrustAxis.Normalize();
-		FVector TorqueDirection = FVector::CrossProduct(EngineOffset, WorldThrustAxis);
-		TorqueDirection.Normalize();
+float UFlareSpacecraftNavigationSystem::GetTotalMaxTorqueInAxis(FVector TorqueAxis, bool WithDamages) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_NavigationSystem_GetTotalMaxTorqueInAxis);
 
-		float Ratio = FVector::DotProduct(TorqueAxis, TorqueDirection);
+	UFlareSpacecraftNavigationSystem* UnprotectedThis = const_cast<UFlareSpacecraftNavigationSystem *>(this);
+	UnprotectedThis->UpdateEngineEnvelope();
 
-		if (Ratio > 0)
-		{
-			TotalMaxTorque += FVector::CrossProduct(EngineOffset, WorldThrustAxis).Size() * MaxThrust * Ratio;
-		}
+	FVector LocalAxis = Spacecraft->Airframe->GetComponentToWorld().InverseTransformVectorNoScale(TorqueAxis.GetSafeNormal());
+	const TArray<float>& MaxThrusts = (WithDamages ? EngineMaxThrusts : EngineInitialMaxThrusts);
+
+	float TotalMaxTorque = 0;
+	for (int32 EngineIndex = 0; EngineIndex < EngineTorqueDirections.Num(); EngineIndex++)
+	{
+		float Ratio = FVector::DotProduct(EngineTorqueDirections[EngineIndex], LocalAxis);
+		TotalMaxTorque += EngineTorqueArms[EngineIndex] * MaxThrusts[EngineIndex] * FMath::Max(Ratio, 0.f);
+	}
 
+	if (WithDamages)
+	{
+		TotalMaxTorque *= 1.0f - Spacecraft->GetDamageSystem()->GetOverheatRatio(0.05);
 	}
 
 	return TotalMaxTorque;
@@ -246,6 +246,9 @@ public:
 	/** Update the ship's center of mass */
 	void UpdateCOM();
 
+	/** Rebuild the engine envelope if a component was damaged, repaired or lost power */
+	void UpdateEngineEnvelope();
+
 protected:
 
 
@@ -285,6 +288,17 @@ protected:
 	FVector                                  AngularTargetVelocity;
 	bool                                     UseOrbitalBoost;
 	FVector                                  COM;
+	FVector                                  LocalCOM;
+
+	// Engine envelope, in ship space, in the order of the spacecraft engines
+	TArray<FVector>                          EngineThrustAxes;
+	TArray<FVector>                          EngineTorqueDirections;
+	TArray<float>                            EngineTorqueArms;
+	TArray<float>                            EngineMaxThrusts; // Without overheating
+	TArray<float>                            EngineInitialMaxThrusts;
+	TArray<bool>                             EngineIsOrbital;
+	int64                                    EngineEnvelopeStateIndex;
+	bool                                     EngineEnvelopePowerOutage;
 
 
 public:
@@ -295,19 +309,17 @@ public:
 
 	/**
 	 * Return the maximum current (with damages) trust the ship can provide in a specific axis.
-	 * Engines : List of engine to use to compute the max thrust
 	 * Axis : Axis of the thurst
 	 * WithObitalEngines : if false, ignore orbitals engines
 	 */
-	FVector GetTotalMaxThrustInAxis(TArray<UActorComponent*>& Engines, FVector Axis, bool WithOrbitalEngines) const;
+	FVector GetTotalMaxThrustInAxis(FVector Axis, bool WithOrbitalEngines) const;
 
 	/**
 	 * Return the maximum torque the ship can provide in a specific axis.
-	 * Engines : List of engine to use to compute the max thrust
 	 * TorqueDirection : Axis of the torque
 	 * WithDamages : if true, use current thrust value and not theorical thrust value
 	 */
-	float GetTotalMaxTorqueInAxis(TArray<UActorComponent*>& Engines, FVector TorqueDirection, bool WithDamages) const;
+	float GetTotalMaxTorqueInAxis(FVector TorqueDirection, bool WithDamages) const;
 
 
 	/*----------------------------------------------------
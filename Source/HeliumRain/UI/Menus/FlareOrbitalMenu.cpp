@@ -9,6 +9,12 @@
 #include "../Components/FlareSectorButton.h"
 
 
+// Longest automatic fast forward, in days
+#define FAST_FORWARD_MAX_DAYS 365
+
+// Delay before an automatic fast forward can start again, against double clicks
+#define FAST_FORWARD_RESTART_DELAY 0.5f
+
 #define LOCTEXT_NAMESPACE "FlareOrbitalMenu"
 
 
@@ -24,7 +30,7 @@ void SFlareOrbitalMenu::Construct(const FArguments& InArgs)
 	Game = MenuManager->GetPC()->GetGame();
 
 	// FF setup
-	FastForwardPeriod = 0.5f;
+	FastForwardBudget = 0.05f;
 	FastForwardStopRequested = false;
 
 	// Build structure
@@ -315,6 +321,7 @@ void SFlareOrbitalMenu::StopFastForward()
 	{
 		FLOG("Stop fast forward");
 		FastForwardActive = false;
+		Game->GetGameWorld()->StopFastForward();
 		Game->SaveGame(MenuManager->GetPC(), true);
 		Game->ActivateCurrentSector();
 	}
@@ -323,6 +330,9 @@ void SFlareOrbitalMenu::StopFastForward()
 void SFlareOrbitalMenu::RequestStopFastForward()
 {
 	FastForwardStopRequested = true;
+
+	// Let the current day end, then stop
+	Game->GetGameWorld()->StopFastForward();
 }
 
 void SFlareOrbitalMenu::Tick(const FGeometry& AllottedGeometry, const double InCurrentTime, const float InDeltaTime)
@@ -336,13 +346,16 @@ void SFlareOrbitalMenu::Tick(const FGeometry& AllottedGeometry, const double InC
 			MenuManager->GetPC()->CheckSectorStateChanges(Sector);
 		}
 
-		// Fast forward every FastForwardPeriod
+		// Fast forward as many days as the frame budget allows
 		TimeSinceFastForward += InDeltaTime;
 		if (FastForwardActive)
 		{
-			if (!FastForwardStopRequested && (TimeSinceFastForward > FastForwardPeriod || UFlareGameTools::FastFastForward))
+			if (!FastForwardStopRequested)
 			{
-				MenuManager->GetGame()->GetGameWorld()->FastForward();
+				if (!MenuManager->GetGame()->GetGameWorld()->TickFastForward(FastForwardBudget))
+				{
+					FastForwardStopRequested = true;
+				}
 				TimeSinceFastForward = 0;
 			}
 
@@ -538,7 +551,13 @@ FText SFlareOrbitalMenu::GetFastForwardText() const
 	}
 	else
 	{
-		return LOCTEXT("FastForwardingText", "Fast forwarding...");
+		int64 SimulatedDays;
+		int64 TotalDays;
+		MenuManager->GetGame()->GetGameWorld()->GetFastForwardProgress(SimulatedDays, TotalDays);
+
+		return FText::Format(LOCTEXT("FastForwardingFormat", "Fast forwarding... ({0} / {1} days)"),
+			FText::AsNumber(SimulatedDays),
+			FText::AsNumber(TotalDays));
 	}
 }
 
@@ -743,7 +762,7 @@ void SFlareOrbitalMenu::OnFastForwardAutomaticClicked()
 	if (FastForwardAuto->IsActive())
 	{
 		// Avoid too fast double fast forward
-		if (!FastForwardActive && TimeSinceFastForward < FastForwardPeriod)
+		if (!FastForwardActive && TimeSinceFastForward < FAST_FORWARD_RESTART_DELAY)
 		{
 			FastForwardAuto->SetActive(false);
 			return;
@@ -775,6 +794,7 @@ void SFlareOrbitalMenu::OnFastForwardConfirmed(bool Automatic)
 		// Prepare for FF
 		Game->SaveGame(MenuManager->GetPC(), true);
 		Game->DeactivateSector();
+		Game->GetGameWorld()->StartFastForward(FAST_FORWARD_MAX_DAYS, MenuManager->GetPC()->GetCompany());
 	}
 	else
 	{
@@ -132,7 +132,7 @@ protected:
 	// Fast forward
 	bool                                        FastForwardActive;
 	bool                                        FastForwardStopRequested;
-	float                                       FastForwardPeriod;
+	float                                       FastForwardBudget;
 	float                                       TimeSinceFastForward;
 
 	// Components